@@ -10,7 +10,7 @@ public class MiceMen : ModuleRules
 
 		PublicDependencyModuleNames.AddRange(new[] { "Core", "CoreUObject", "Engine", "InputCore", "CinematicCamera" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { });
+		PrivateDependencyModuleNames.AddRange(new string[] { "MiceMenRules" });
 
 		PublicIncludePaths.AddRange(new[] { "MiceMen" });
 
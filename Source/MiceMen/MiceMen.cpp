@@ -6,3 +6,29 @@
 IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, MiceMen, "MiceMen");
 
 DEFINE_LOG_CATEGORY(MiceMenEventLog);
+
+UE_TRACE_CHANNEL_DEFINE(MiceMenChannel)
+
+TRACE_DECLARE_INT_COUNTER(MiceMen_MiceProcessed, TEXT("MiceMen/MiceProcessed"));
+TRACE_DECLARE_INT_COUNTER(MiceMen_CascadePasses, TEXT("MiceMen/CascadePasses"));
+TRACE_DECLARE_INT_COUNTER(MiceMen_PathsComputed, TEXT("MiceMen/PathsComputed"));
+
+LLM_DEFINE_TAG(MiceMen_Grid);
+LLM_DEFINE_TAG(MiceMen_Mice);
+LLM_DEFINE_TAG(MiceMen_Columns);
+LLM_DEFINE_TAG(MiceMen_BlockVisuals);
+LLM_DEFINE_TAG(MiceMen_AI);
+LLM_DEFINE_TAG(MiceMen_Paths);
+LLM_DEFINE_TAG(MiceMen_EventLog);
+LLM_DEFINE_TAG(MiceMen_Telemetry);
+
+DEFINE_STAT(STAT_MiceMen_GridObjectMemory);
+DEFINE_STAT(STAT_MiceMen_EventLogMemory);
+DEFINE_STAT(STAT_MiceMen_MouseActors);
+DEFINE_STAT(STAT_MiceMen_ColumnControls);
+DEFINE_STAT(STAT_MiceMen_ActorsSpawned);
+DEFINE_STAT(STAT_MiceMen_ActorsDestroyed);
+DEFINE_STAT(STAT_MiceMen_PathArrays);
+DEFINE_STAT(STAT_MiceMen_AIColumnTests);
+DEFINE_STAT(STAT_MiceMen_PathCacheHits);
+DEFINE_STAT(STAT_MiceMen_PathCacheMisses);
@@ -3,5 +3,61 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Stats/Stats.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(MiceMenEventLog, Log, All);
+
+/**
+* Trace channel for the turn pipeline, enable with -trace=cpu,MiceMen to capture in Unreal Insights
+*/
+UE_TRACE_CHANNEL_EXTERN(MiceMenChannel, MICEMEN_API)
+
+/** Named CPU scope on the Mice Men trace channel */
+#define MM_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, MiceMenChannel)
+
+/** Mice processed in the current turn, across all cascade passes */
+TRACE_DECLARE_INT_COUNTER_EXTERN(MiceMen_MiceProcessed);
+
+/** Cascade passes run in the current turn */
+TRACE_DECLARE_INT_COUNTER_EXTERN(MiceMen_CascadePasses);
+
+/** Mouse movement paths computed in the current turn, including AI evaluation */
+TRACE_DECLARE_INT_COUNTER_EXTERN(MiceMen_PathsComputed);
+
+/**
+* Low level memory tags, run with -llm to see allocations attributed to each system
+*/
+LLM_DECLARE_TAG_API(MiceMen_Grid, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_Mice, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_Columns, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_BlockVisuals, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_AI, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_Paths, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_EventLog, MICEMEN_API);
+LLM_DECLARE_TAG_API(MiceMen_Telemetry, MICEMEN_API);
+
+/**
+* Stats shown with "stat MiceMen"
+*/
+DECLARE_STATS_GROUP(TEXT("MiceMen"), STATGROUP_MiceMen, STATCAT_Advanced);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Grid Object"), STAT_MiceMen_GridObjectMemory, STATGROUP_MiceMen, MICEMEN_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Event Log"), STAT_MiceMen_EventLogMemory, STATGROUP_MiceMen, MICEMEN_API);
+
+/** Live actors, compare with the spawned and destroyed totals to see churn from rebuilding the grid */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Mouse Actors"), STAT_MiceMen_MouseActors, STATGROUP_MiceMen, MICEMEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Column Controls"), STAT_MiceMen_ColumnControls, STATGROUP_MiceMen, MICEMEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Grid Actors Spawned"), STAT_MiceMen_ActorsSpawned, STATGROUP_MiceMen, MICEMEN_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Grid Actors Destroyed"), STAT_MiceMen_ActorsDestroyed, STATGROUP_MiceMen, MICEMEN_API);
+
+/** Per frame counts of temporary allocations */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Arrays"), STAT_MiceMen_PathArrays, STATGROUP_MiceMen, MICEMEN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("AI Column Tests"), STAT_MiceMen_AIColumnTests, STATGROUP_MiceMen, MICEMEN_API);
+
+/** Per frame walk results reused from or added to the path cache */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Hits"), STAT_MiceMen_PathCacheHits, STATGROUP_MiceMen, MICEMEN_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Path Cache Misses"), STAT_MiceMen_PathCacheMisses, STATGROUP_MiceMen, MICEMEN_API);
@@ -0,0 +1,146 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Base/MM_EventLog.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+#include "MiceMen.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpEventLogCommand(
+	TEXT("MiceMen.EventLog.Dump"),
+	TEXT("Prints the most recent grid events, oldest first. Optional count, defaults to 100"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const uint32 MaxEvents = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+		FMM_EventLog::Get().Dump(Ar, MaxEvents);
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice SaveEventLogCommand(
+	TEXT("MiceMen.EventLog.Save"),
+	TEXT("Writes all stored grid events to Saved/Logs"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const FString FilePath = FPaths::ProjectLogDir() / FString::Printf(TEXT("MM_EventLog_%s.log"), *FDateTime::Now().ToString());
+		if (FMM_EventLog::Get().SaveToFile(FilePath))
+		{
+			Ar.Logf(TEXT("Saved %u grid events to %s"), FMM_EventLog::Get().Num(), *FilePath);
+		}
+	}));
+
+static FAutoConsoleCommand ResetEventLogCommand(
+	TEXT("MiceMen.EventLog.Reset"),
+	TEXT("Removes all stored grid events"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FMM_EventLog::Get().Reset();
+	}));
+
+FMM_EventLog& FMM_EventLog::Get()
+{
+	static FMM_EventLog EventLog;
+	return EventLog;
+}
+
+FMM_EventLog::FMM_EventLog()
+{
+	// Allocated once up front, recording never allocates
+	static_assert(FMath::IsPowerOfTwo(Capacity), "Event log capacity must be a power of two");
+	LLM_SCOPE_BYTAG(MiceMen_EventLog);
+	Records.SetNum(Capacity);
+	SET_MEMORY_STAT(STAT_MiceMen_EventLogMemory, Records.GetAllocatedSize());
+}
+
+void FMM_EventLog::Dump(FOutputDevice& Ar, uint32 MaxEvents) const
+{
+	const uint32 DumpCount = FMath::Min(MaxEvents, Num());
+	if (DumpCount <= 0)
+	{
+		Ar.Logf(TEXT("No grid events recorded"));
+		return;
+	}
+
+	const uint64 FirstIndex = WriteIndex - DumpCount;
+	const uint64 StartCycles = Records[FirstIndex & (Capacity - 1)].Cycles;
+
+	Ar.Logf(TEXT("Last %u of %llu grid events:"), DumpCount, WriteIndex);
+	for (uint64 i = FirstIndex; i < WriteIndex; i++)
+	{
+		Ar.Logf(TEXT("%s"), *FormatRecord(Records[i & (Capacity - 1)], StartCycles));
+	}
+}
+
+bool FMM_EventLog::SaveToFile(const FString& FilePath) const
+{
+	const uint32 EventCount = Num();
+	const uint64 FirstIndex = WriteIndex - EventCount;
+	const uint64 StartCycles = EventCount > 0 ? Records[FirstIndex & (Capacity - 1)].Cycles : 0;
+
+	TArray<FString> Lines;
+	Lines.Reserve(EventCount);
+	for (uint64 i = FirstIndex; i < WriteIndex; i++)
+	{
+		Lines.Add(FormatRecord(Records[i & (Capacity - 1)], StartCycles));
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("FMM_EventLog::SaveToFile | Failed to write %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+FString FMM_EventLog::FormatRecord(const FMM_EventRecord& Record, uint64 StartCycles)
+{
+	const double TimeMs = FPlatformTime::ToMilliseconds64(Record.Cycles - StartCycles);
+
+	// Ids can be reused once an object is destroyed, so the name is only a hint of what it was
+	FString ObjectDisplay = TEXT("none");
+	if (Record.ObjectId != 0)
+	{
+		const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(Record.ObjectId);
+		const UObjectBase* Object = ObjectItem ? ObjectItem->Object : nullptr;
+		ObjectDisplay = Object ? FString::Printf(TEXT("#%u %s"), Record.ObjectId, *Object->GetFName().ToString()) : FString::Printf(TEXT("#%u"), Record.ObjectId);
+	}
+
+	return FString::Printf(TEXT("%12.3f ms | %-26s | (%i, %i) | param %i | %s"),
+	                       TimeMs, GetEventName(Record.Event), Record.X, Record.Y, Record.Param, *ObjectDisplay);
+}
+
+const TCHAR* FMM_EventLog::GetEventName(EGridEvent Event)
+{
+	switch (Event)
+	{
+	case EGridEvent::E_SLOT_TAKEN:
+		return TEXT("SlotTaken");
+	case EGridEvent::E_SLOT_FREED:
+		return TEXT("SlotFreed");
+	case EGridEvent::E_ELEMENT_MOVED:
+		return TEXT("ElementMoved");
+	case EGridEvent::E_ELEMENT_POSITION_UPDATED:
+		return TEXT("ElementPositionUpdated");
+	case EGridEvent::E_ELEMENT_COLUMN_CHANGED:
+		return TEXT("ElementColumnChanged");
+	case EGridEvent::E_COLUMN_ADDED:
+		return TEXT("ColumnAdded");
+	case EGridEvent::E_COLUMN_MOVED:
+		return TEXT("ColumnMoved");
+	case EGridEvent::E_COLUMN_WRAPPED:
+		return TEXT("ColumnWrapped");
+	case EGridEvent::E_BLOCK_REMOVED:
+		return TEXT("BlockRemoved");
+	case EGridEvent::E_MOUSE_SPAWNED:
+		return TEXT("MouseSpawned");
+	case EGridEvent::E_MOUSE_MOVED:
+		return TEXT("MouseMoved");
+	case EGridEvent::E_MOUSE_GOAL:
+		return TEXT("MouseGoal");
+	case EGridEvent::E_TEAM_PROCESSING:
+		return TEXT("TeamProcessing");
+	default:
+		return TEXT("None");
+	}
+}
@@ -4,6 +4,8 @@
 
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
 
 #include "Player/MM_PlayerController.h"
 #include "Grid/MM_GridManager.h"
@@ -30,12 +32,30 @@ void AMM_GameMode::BeginPlay()
 
 	// Create second local player
 	SecondLocalPlayerController = UGameplayStatics::CreatePlayer(GetWorld());
+
+	StartTurnTelemetry();
+
+	// The book is optional, without one the AI searches every move
+	const FString OpeningBookPath = FPaths::ProjectContentDir() / OpeningBookFile;
+	if (BoardSeedCount > 0 && FPaths::FileExists(OpeningBookPath))
+	{
+		OpeningBook.Open(OpeningBookPath);
+	}
+	// Seeded boards are only worth their smaller variety with a book written for them
+	else if (BoardSeedCount > 0)
+	{
+		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GameMode::BeginPlay | No opening book at %s for %i seeded boards, run the MM_OpeningBook commandlet to write it"),
+		       *OpeningBookPath, BoardSeedCount);
+	}
 }
 
 void AMM_GameMode::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// Always stop the writer so queued records are written, even when quitting
+	TelemetryWriter.Reset();
+
 	// Not concerned with cleanup if the application/process is ending as that is handled internally
 	if (EndPlayReason == EEndPlayReason::EndPlayInEditor || EndPlayReason == EEndPlayReason::Quit)
 	{
@@ -77,6 +97,7 @@ void AMM_GameMode::CleanupGame()
 
 	// Restore variables
 	StalemateCount = -1;
+	CurrentTurnIndex = 0;
 	TeamPoints.Empty();
 }
 
@@ -119,6 +140,9 @@ void AMM_GameMode::BeginGame(EGameType InGameType, EAIDifficulty InAIDifficulty)
 	SetupGridManager();
 	CheckForStalemate();
 
+	// Results from the last game don't apply to the new board
+	AITranspositionTable.Resize(InAIDifficulty == EAIDifficulty::E_EXPERT ? AITranspositionTableMegabytes : 0);
+
 	// Setup game type
 	CurrentGameType = InGameType;
 	CurrentAIDifficulty = InAIDifficulty;
@@ -193,7 +217,18 @@ bool AMM_GameMode::SetupGridManager()
 	GridManager = GetWorld()->SpawnActorDeferred<AMM_GridManager>(GridManagerClass, SpawnTransform);
 	GridManager->SetupGridVariables(GridSize, this);
 	UGameplayStatics::FinishSpawningActor(GridManager, SpawnTransform);
+
+	// Seeded boards are the boards searched for the opening book, the rest of the game stays unseeded
+	CurrentBoardSeed = BoardSeedCount > 0 ? FMath::RandRange(0, BoardSeedCount - 1) : -1;
+	if (CurrentBoardSeed >= 0)
+	{
+		FMath::RandInit(CurrentBoardSeed);
+	}
 	GridManager->RebuildGrid(InitialMiceCount);
+	if (CurrentBoardSeed >= 0)
+	{
+		FMath::RandInit(FPlatformTime::Cycles());
+	}
 
 	if (!GridManager)
 	{
@@ -309,6 +344,9 @@ void AMM_GameMode::ProcessTurnComplete(AMM_PlayerController* Player)
 	       *CurrentPlayerController->GetName(), CurrentPlayerController->GetCurrentTeam());
 	CurrentPlayerController->TurnEnded();
 
+	RecordTurnTelemetry(CurrentPlayerController);
+	CurrentTurnIndex++;
+
 	// If stalemate is active, increase counter for turn taken
 	if (StalemateCount >= 0)
 	{
@@ -345,6 +383,34 @@ void AMM_GameMode::ProcessTurnComplete(AMM_PlayerController* Player)
 	SwitchTurnToPlayer(AllPlayers[NextPlayer]);
 }
 
+void AMM_GameMode::StartTurnTelemetry()
+{
+	// Check telemetry is enabled
+	if (!bRecordTurnTelemetry && !FParse::Param(FCommandLine::Get(), TEXT("TurnTelemetry")))
+	{
+		return;
+	}
+
+	const FString TelemetryDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Telemetry"));
+	TelemetryWriter = MakeUnique<FMM_TurnTelemetryWriter>(TelemetryDirectory, TelemetryFormat, TelemetryRecordsPerFile);
+}
+
+void AMM_GameMode::RecordTurnTelemetry(const AMM_PlayerController* Player)
+{
+	if (!TelemetryWriter || !GridManager || !Player)
+	{
+		return;
+	}
+
+	// Grid manager holds the column and mice stats, add the turn and player details
+	FMM_TurnRecord Record = GridManager->GetLastTurnRecord();
+	Record.TurnIndex = CurrentTurnIndex;
+	Record.Team = Player->GetCurrentTeam();
+	Record.AIThinkTime = Player->GetLastAIThinkTime();
+
+	TelemetryWriter->AddRecord(Record);
+}
+
 void AMM_GameMode::CheckForStalemate()
 {
 	// If more than 0, we are already in stalemate mode
@@ -374,6 +440,9 @@ ETeam AMM_GameMode::GetWinningStalemateTeam(int& DistanceWonBy) const
 
 void AMM_GameMode::ForceEndNoMoves()
 {
+	// The last turn ends the game here rather than through ProcessTurnComplete, its stats are already completed by the grid manager
+	RecordTurnTelemetry(CurrentPlayerController);
+
 	ETeam WinningTeam = ETeam::E_NONE;
 	FString WinningReason = "No more moves remaining";
 	if (TeamPoints[ETeam::E_TEAM_A] != TeamPoints[ETeam::E_TEAM_B])
@@ -392,6 +461,28 @@ void AMM_GameMode::ForceEndNoMoves()
 	TeamWon(WinningTeam, WinningReason);
 }
 
+void AMM_GameMode::SetSimulationSpeed(float NewSimulationSpeed)
+{
+	SimulationSpeed = FMath::Clamp(NewSimulationSpeed, 1.0f, MaxSimulationSpeed);
+
+	// Update existing columns and mice to the new speed
+	if (GridManager)
+	{
+		GridManager->ApplySimulationSpeed(SimulationSpeed);
+	}
+}
+
+void AMM_GameMode::SetInstantVisuals(bool bEnabled)
+{
+	bInstantVisuals = bEnabled;
+}
+
+bool AMM_GameMode::IsInstantVisuals() const
+{
+	// Test mode always resolves instantly
+	return bInstantVisuals || CurrentGameType == EGameType::E_TEST;
+}
+
 void AMM_GameMode::AddScore(ETeam Team)
 {
 	// Increment score by 1, will set score if the team's score doesn't exists
@@ -400,6 +491,13 @@ void AMM_GameMode::AddScore(ETeam Team)
 	// If a team has the winning number of points
 	if (HasTeamWon(Team))
 	{
+		// The winning turn ends here rather than through ProcessTurnComplete, so complete and record its stats first
+		if (GridManager)
+		{
+			GridManager->FinishTurnRecord();
+		}
+		RecordTurnTelemetry(CurrentPlayerController);
+
 		TeamWon(Team, "Completed all mice");
 	}
 }
@@ -0,0 +1,157 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Base/MM_TurnTelemetry.h"
+
+#include "HAL/RunnableThread.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+
+#include "MiceMen.h"
+
+// ################################ Turn Record ################################
+
+FString FMM_TurnRecord::GetCSVHeader()
+{
+	return TEXT("TurnIndex,Team,Column,Direction,CascadePasses,MiceMoved,GoalsScored,AIThinkMs,ResolutionMs,VisualPlayoutMs");
+}
+
+FString FMM_TurnRecord::ToCSVRow() const
+{
+	return FString::Printf(TEXT("%i,%i,%i,%i,%i,%i,%i,%.3f,%.3f,%.3f"),
+	                       TurnIndex, static_cast<int>(Team), Column, static_cast<int>(Direction),
+	                       CascadePasses, MiceMoved, GoalsScored,
+	                       AIThinkTime * 1000.0, ResolutionTime * 1000.0, VisualPlayoutTime * 1000.0);
+}
+
+FString FMM_TurnRecord::ToJsonLine() const
+{
+	return FString::Printf(TEXT("{\"TurnIndex\":%i,\"Team\":%i,\"Column\":%i,\"Direction\":%i,\"CascadePasses\":%i,\"MiceMoved\":%i,\"GoalsScored\":%i,")
+	                       TEXT("\"AIThinkMs\":%.3f,\"ResolutionMs\":%.3f,\"VisualPlayoutMs\":%.3f}"),
+	                       TurnIndex, static_cast<int>(Team), Column, static_cast<int>(Direction),
+	                       CascadePasses, MiceMoved, GoalsScored,
+	                       AIThinkTime * 1000.0, ResolutionTime * 1000.0, VisualPlayoutTime * 1000.0);
+}
+
+// ################################ Writer ################################
+
+FMM_TurnTelemetryWriter::FMM_TurnTelemetryWriter(const FString& InDirectory, ETelemetryFormat InFormat, int InMaxRecordsPerFile)
+	: Directory(InDirectory)
+	  , Format(InFormat)
+	  , MaxRecordsPerFile(FMath::Max(InMaxRecordsPerFile, 1))
+{
+	SessionName = FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S"));
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+	Thread = FRunnableThread::Create(this, TEXT("MM_TurnTelemetryWriter"), 0, TPri_BelowNormal);
+
+	UE_LOG(MiceMenEventLog, Display, TEXT("FMM_TurnTelemetryWriter | Writing turn telemetry to %s"), *Directory);
+}
+
+FMM_TurnTelemetryWriter::~FMM_TurnTelemetryWriter()
+{
+	if (Thread)
+	{
+		// Stops the thread, which writes any remaining records before exiting
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	// No thread could be created, write remaining records here
+	else
+	{
+		WritePendingRecords();
+	}
+
+	CurrentFile.Reset();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FMM_TurnTelemetryWriter::AddRecord(const FMM_TurnRecord& Record)
+{
+	LLM_SCOPE_BYTAG(MiceMen_Telemetry);
+	PendingRecords.Enqueue(Record);
+	WakeEvent->Trigger();
+}
+
+uint32 FMM_TurnTelemetryWriter::Run()
+{
+	LLM_SCOPE_BYTAG(MiceMen_Telemetry);
+
+	while (!bStopping)
+	{
+		// Timeout is a fallback, queued records trigger the event
+		WakeEvent->Wait(1000);
+		WritePendingRecords();
+	}
+
+	// Flush anything queued while stopping
+	WritePendingRecords();
+	return 0;
+}
+
+void FMM_TurnTelemetryWriter::Stop()
+{
+	bStopping = true;
+	WakeEvent->Trigger();
+}
+
+void FMM_TurnTelemetryWriter::WritePendingRecords()
+{
+	bool bWroteRecords = false;
+
+	FMM_TurnRecord Record;
+	while (PendingRecords.Dequeue(Record))
+	{
+		// Start a new file when there is none or the current one is full
+		if (!CurrentFile || RecordsInCurrentFile >= MaxRecordsPerFile)
+		{
+			OpenNextFile();
+			if (!CurrentFile)
+			{
+				// Failed to open, drop the remaining records rather than growing the queue
+				continue;
+			}
+		}
+
+		WriteLine(Format == ETelemetryFormat::E_JSON ? Record.ToJsonLine() : Record.ToCSVRow());
+		RecordsInCurrentFile++;
+		bWroteRecords = true;
+	}
+
+	// Flush once per batch so records are on disk if the session ends unexpectedly
+	if (bWroteRecords && CurrentFile)
+	{
+		CurrentFile->Flush();
+	}
+}
+
+void FMM_TurnTelemetryWriter::OpenNextFile()
+{
+	CurrentFile.Reset();
+	RecordsInCurrentFile = 0;
+
+	const TCHAR* Extension = Format == ETelemetryFormat::E_JSON ? TEXT("jsonl") : TEXT("csv");
+	const FString FileName = FString::Printf(TEXT("Turns_%s_%03i.%s"), *SessionName, FileIndex++, Extension);
+	const FString FilePath = FPaths::Combine(Directory, FileName);
+
+	CurrentFile.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!CurrentFile)
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("FMM_TurnTelemetryWriter::OpenNextFile | Failed to create telemetry file %s"), *FilePath);
+		return;
+	}
+
+	// Each CSV file is readable on its own
+	if (Format == ETelemetryFormat::E_CSV)
+	{
+		WriteLine(FMM_TurnRecord::GetCSVHeader());
+	}
+}
+
+void FMM_TurnTelemetryWriter::WriteLine(const FString& Line) const
+{
+	const FTCHARToUTF8 ConvertedLine(*(Line + LINE_TERMINATOR));
+	CurrentFile->Serialize(const_cast<ANSICHAR*>(ConvertedLine.Get()), ConvertedLine.Length());
+}
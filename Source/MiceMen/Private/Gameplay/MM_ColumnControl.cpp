@@ -4,6 +4,7 @@
 
 #include "Kismet/KismetSystemLibrary.h"
 #include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
 
 #include "Grid/MM_GridManager.h"
 #include "MiceMen.h"
@@ -19,7 +20,9 @@ AMM_ColumnControl::AMM_ColumnControl()
 
 	GrabbableBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Grabbable Box"));
 	GrabbableBox->SetupAttachment(RootComponent);
-	GrabbableBox->SetCollisionProfileName(FName("GridColumn"));
+	// Columns are picked from the grid transform by the grid manager, the box only represents the column bounds
+	// Without collision it is kept out of the physics scene
+	GrabbableBox->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
 }
 
 void AMM_ColumnControl::SetupColumn(int InColumnID, AMM_GridManager* InGridManager)
@@ -36,6 +39,9 @@ void AMM_ColumnControl::SetupColumn(int InColumnID, AMM_GridManager* InGridManag
 	// Apply sizes
 	GrabbableBox->SetBoxExtent(BoxSize);
 	GrabbableBox->SetRelativeLocation(FVector(0, 0, ColumnHeight / 2));
+
+	// Ensure no collision from Blueprint overrides, before the box is registered with the physics scene
+	GrabbableBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
 void AMM_ColumnControl::BeginPlay()
@@ -50,8 +56,10 @@ void AMM_ColumnControl::Tick(float DeltaTime)
 	// Grabbed or lerping
 	if (bGrabbed || bLerp)
 	{
-		// Lerp position towards preview location
-		const float LerpAlpha = FMath::Clamp(LerpSpeed * DeltaTime, 0.0f, 1.0f);
+		// Lerp position towards preview location, using exponential decay so the column
+		// covers the same distance over the same time regardless of frame rate.
+		// DeltaTime is already scaled by the simulation speed through CustomTimeDilation
+		const float LerpAlpha = 1.0f - FMath::Exp(-LerpSpeed * DeltaTime);
 		const FVector NewLocation = FMath::Lerp(GetActorLocation(), PreviewLocation, LerpAlpha);
 		SetActorLocation(NewLocation);
 	}
@@ -77,6 +85,9 @@ bool AMM_ColumnControl::BeginGrab()
 	OriginalLocation = GetActorLocation();
 	PreviewLocation = OriginalLocation;
 
+	// AI moves are placed when grabbed, so settle time counts from the grab until a release replaces it
+	ReleaseTime = FPlatformTime::Seconds();
+
 	BI_BeginGrab();
 
 	return true;
@@ -121,6 +132,13 @@ void AMM_ColumnControl::UpdatePreviewLocation(const FVector& NewLocation)
 			TEXT("Down"):
 			TEXT("Up"));
 		CurrentDirectionChange = NewDirectionChange;
+
+		// Simulate the move's cascade while it is held, so it can be shown and played on release without resolving it again
+		if (GridManager)
+		{
+			GridManager->UpdateCascadePreview(ControllingIndex, CurrentDirectionChange);
+		}
+
 		BN_DirectionChanged(CurrentDirectionChange);
 	}
 }
@@ -129,6 +147,7 @@ void AMM_ColumnControl::EndGrab()
 {
 	bGrabbed = false;
 	bLerp = true;
+	ReleaseTime = FPlatformTime::Seconds();
 
 	// Set snap to point based on current direction
 	if (CurrentDirectionChange != EDirection::E_NONE)
@@ -153,6 +172,7 @@ void AMM_ColumnControl::LockInColumn()
 	// Lock location and stop lerping movement
 	SetActorLocation(PreviewLocation);
 	bLerp = false;
+	LastSettleTime = FPlatformTime::Seconds() - ReleaseTime;
 
 	// Column movement complete, turn has ended if the direction was changed ie not none
 	AdjustCompleteDelegate.Broadcast(CurrentDirectionChange != EDirection::E_NONE);
@@ -164,9 +184,17 @@ void AMM_ColumnControl::LockInColumn()
 		ResetToDefaultPosition();
 		if (GridManager)
 		{
-			GridManager->AdjustColumn(ControllingIndex, CurrentDirectionChange);
-			// Start processing mice based on column change
-			GridManager->BeginProcessMice();
+			// The preview was simulated for the column moving, so is discarded if the column failed to move
+			if (!GridManager->AdjustColumn(ControllingIndex, CurrentDirectionChange))
+			{
+				GridManager->ClearCascadePreview();
+				GridManager->BeginProcessMice();
+			}
+			// Play the cascade previewed while dragging, otherwise start processing mice based on column change
+			else if (!GridManager->BeginPreviewedMice(ControllingIndex, CurrentDirectionChange))
+			{
+				GridManager->BeginProcessMice();
+			}
 		}
 		else
 		{
@@ -5,7 +5,9 @@
 #include "Kismet/GameplayStatics.h"
 
 #include "Grid/MM_GridManager.h"
+#include "Grid/MM_GridObject.h"
 #include "Base/MM_GameMode.h"
+#include "Base/MM_EventLog.h"
 #include "MiceMen.h"
 
 // Sets default values
@@ -31,8 +33,8 @@ void AMM_Mouse::SetupMouse(const ETeam InTeam, FIntVector2D& FinalGridCoordinate
 {
 	CurrentTeam = InTeam;
 
-	TArray<FIntVector2D> ValidPath = GetMovementPath();
-	FinalGridCoordinates = ValidPath.Last();
+	int StepCount;
+	FinalGridCoordinates = WalkMovementPath(nullptr, StepCount);
 	Coordinates = FinalGridCoordinates;
 }
 
@@ -43,54 +45,61 @@ void AMM_Mouse::BN_StartMovement_Implementation(const TArray<FVector>& Path)
 	SetActorLocation(Path.Last());
 }
 
-bool AMM_Mouse::AttemptPerformMovement()
+bool AMM_Mouse::PerformMovementAlongPath(const TArray<FIntVector2D>& Path)
 {
-	// Move Mouse to next position
-	FIntVector2D FinalPosition;
-	const bool bSuccessfulMovement = BeginMove(FinalPosition);
+	VisualMovementStartTime = 0.0;
 
-	if (bSuccessfulMovement)
+	// Path needs to start from the mouse and move it somewhere
+	if (Path.Num() <= 1 || Path[0] != Coordinates || Path.Last() == Coordinates)
 	{
-		ProcessUpdatedPosition(FinalPosition);
-	}
-	else
-	{
-		// Mouse didn't move, movement complete
-		MovementEndDelegate.Broadcast(this);
+		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_Mouse::PerformMovementAlongPath | Path of %i steps does not move the mouse from %s"), Path.Num(), *Coordinates.ToString());
+		return false;
 	}
 
-	return bSuccessfulMovement;
+	// Kept before the visuals, as the path's owner can move on to the next movement as soon as these complete
+	const FIntVector2D FinalPosition = Path.Last();
+	StartMovementVisuals(Path);
+	ProcessUpdatedPosition(FinalPosition);
+	return true;
 }
 
-bool AMM_Mouse::BeginMove(FIntVector2D& _FinalPosition)
+void AMM_Mouse::StartMovementVisuals(const TArray<FIntVector2D>& Path)
 {
-	// Calculate Path
-	TArray<FIntVector2D> ValidPath = GetMovementPath();
-	_FinalPosition = ValidPath.Last();
-
-	// If there is no new position/Path, no movement needed
-	if (Coordinates == _FinalPosition)
-	{
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_Mouse::BeginMove | Mouse staying at %s"), *_FinalPosition.ToString());
-		return false;
-	}
-
 #if !UE_BUILD_SHIPPING
-	DisplayDebugPath(ValidPath);
+	DisplayDebugPath(Path);
 #endif
 
-	// If test mode, instantly move mouse
-	if (MMGameMode->GetCurrentGameType() == EGameType::E_TEST)
+	// If visuals are skipped, instantly move mouse
+	const FIntVector2D FinalPosition = Path.Last();
+	bMovedInstantly = ShouldSkipMovementVisuals(FinalPosition);
+	if (bMovedInstantly)
 	{
-		SetActorLocation(GridManager->CoordToWorldTransform(_FinalPosition).GetLocation());
+		SetActorLocation(GridManager->CoordToWorldTransform(FinalPosition).GetLocation());
 	}
 	else
 	{
 		// Begin movement (should fire delegate on complete)
-		BN_StartMovement(GridManager->PathCoordToWorld(ValidPath));
+		VisualMovementStartTime = FPlatformTime::Seconds();
+		GridManager->ConvertPathToWorld(Path, WorldPathScratch);
+		BN_StartMovement(WorldPathScratch);
 	}
+}
 
-	return true;
+bool AMM_Mouse::ShouldSkipMovementVisuals(const FIntVector2D& FinalPosition) const
+{
+	// Without a game mode there is nothing to play the visuals for
+	if (!MMGameMode)
+	{
+		return true;
+	}
+
+	// Path only moves horizontally in one direction, so out of view if no column between start and end is visualized
+	if (GridManager && !GridManager->IsColumnRangeVisible(Coordinates.X, FinalPosition.X))
+	{
+		return true;
+	}
+
+	return MMGameMode->IsInstantVisuals();
 }
 
 void AMM_Mouse::ProcessUpdatedPosition(const FIntVector2D& NewPosition)
@@ -118,62 +127,53 @@ void AMM_Mouse::ProcessUpdatedPosition(const FIntVector2D& NewPosition)
 	else
 	{
 		GridManager->SetMousePosition(this, NewPosition);
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_Mouse::ProcessUpdatedPosition | Mouse New position for team %i at %s"), CurrentTeam, *NewPosition.ToString());
+		MM_EVENT(EGridEvent::E_MOUSE_MOVED, NewPosition, this, static_cast<int32>(CurrentTeam));
 	}
 }
 
 TArray<FIntVector2D> AMM_Mouse::GetMovementPath() const
 {
-	// Setup initial variables
-	TArray<FIntVector2D> Path = {Coordinates};
-	FIntVector2D LastPosition = Coordinates;
-
-	const EDirection Direction = GridManager->GetDirectionFromTeam(CurrentTeam);
+	INC_DWORD_STAT(STAT_MiceMen_PathArrays);
+	LLM_SCOPE_BYTAG(MiceMen_Paths);
 
-	// Loop while valid move
-	bool bHasMove = true;
-	while (bHasMove)
-	{
-		// Set initial valid move to false
-		bHasMove = false;
-		// Start at last position
-		FIntVector2D NewPosition = LastPosition;
-
-		// If valid move down, bHasMove can be set to true
-		if (GridManager->FindFreeSlotBelow(NewPosition))
-		{
-			// Store new position before ahead check
-			Path.Add(NewPosition);
-			bHasMove = true;
-		}
-		// If valid move ahead, bHasMove can be set to true
-		if (GridManager->FindFreeSlotAhead(NewPosition, Direction))
-		{
-			bHasMove = true;
-		}
-
-		// If a valid move was found, set last position and store in path
-		// Otherwise will exit the while loop, having reached the final position
-		if (bHasMove)
-		{
-			LastPosition = NewPosition;
-			// Adds position to end if it was not added (slot was found from ahead check)
-			if (Path.Last() != NewPosition)
-			{
-				Path.Add(NewPosition);
-			}
-		}
-	}
+	TArray<FIntVector2D> Path;
+	FindMovementPath(Path);
 	return Path;
 }
 
+void AMM_Mouse::FindMovementPath(TArray<FIntVector2D>& OutPath) const
+{
+	// Keeps the allocation for reuse
+	OutPath.Reset();
+	OutPath.Add(Coordinates);
+
+	int StepCount;
+	WalkMovementPath(&OutPath, StepCount);
+}
+
+int AMM_Mouse::GetMovementStepCount() const
+{
+	int StepCount;
+	WalkMovementPath(nullptr, StepCount);
+	return StepCount;
+}
+
+FIntVector2D AMM_Mouse::WalkMovementPath(TArray<FIntVector2D>* OutPath, int& OutStepCount) const
+{
+	MM_TRACE_SCOPE("AMM_Mouse::WalkMovementPath");
+	TRACE_COUNTER_INCREMENT(MiceMen_PathsComputed);
+
+	// The grid walks with its slot types and landing rows directly, rather than checking each slot through the grid manager
+	return GridManager->GetGridObject()->WalkPath(Coordinates, GridManager->GetDirectionFromTeam(CurrentTeam), OutPath, OutStepCount);
+}
+
 void AMM_Mouse::GoalReached()
 {
 	bGoalReached = true;
 	BI_OnGoalReached();
 
 	GridManager->RemoveMouse(this);
-	UE_LOG(MiceMenEventLog, Display, TEXT("AMM_Mouse::GoalReached | Mouse reached goal for team %i at %s"), CurrentTeam, *Coordinates.ToString());
+	MM_EVENT(EGridEvent::E_MOUSE_GOAL, Coordinates, this, static_cast<int32>(CurrentTeam));
 
 	// Check stalemate
 	if (MMGameMode)
@@ -186,23 +186,18 @@ void AMM_Mouse::GoalReached()
 
 void AMM_Mouse::DisplayDebugPath(const TArray<FIntVector2D>& ValidPath) const
 {
-	if (!bDisplayDebugPath)
+	if (!bDisplayDebugPath || !GridManager)
 	{
 		return;
 	}
 
-	const FLinearColor Colour = FLinearColor::MakeRandomColor();
-	for (int i = 0; i < ValidPath.Num(); i++)
+	// A mouse with no move has no path to draw
+	if (ValidPath.Num() == 0)
 	{
-		FVector BoxLocation = GridManager->CoordToWorldTransform(ValidPath[i]).GetLocation();
-		// Add half height to be in center of griid
-		BoxLocation.Z += GridManager->GridElementHeight / 2.0;
-		constexpr float StartingSize = 5.0f;
-		// Arbitrary visual size increase up to 10 movements
-		const float AmountThroughPath = static_cast<float>(i) / static_cast<float>(10);
-		const FVector BoxBounds = FVector(StartingSize + AmountThroughPath * 40.0f);
-
-		UKismetSystemLibrary::DrawDebugBox(GetWorld(), BoxLocation, BoxBounds, Colour, FRotator::ZeroRotator, 5, 3);
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_Mouse::DisplayDebugPath | Current path %i: %s"), i, *ValidPath[i].ToString());
+		return;
 	}
-}
\ No newline at end of file
+
+	// Drawn as one batch by the grid manager's debug component
+	GridManager->DrawDebugPath(ValidPath);
+	UE_LOG(MiceMenEventLog, Verbose, TEXT("AMM_Mouse::DisplayDebugPath | Displaying path of %i steps to %s"), ValidPath.Num(), *ValidPath.Last().ToString());
+}
@@ -0,0 +1,199 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Grid/MM_FreeSlotIndex.h"
+
+// ################################ Fenwick Tree ################################
+
+void FMM_FenwickTree::Init(int InNum, int InitialValue)
+{
+	Tree.Reset();
+	Tree.SetNumZeroed(InNum + 1);
+	HighestStep = InNum > 0 ? 1 << FMath::FloorLog2(InNum) : 0;
+
+	// Each node adds itself to its parent once complete, building in one pass
+	for (int i = 1; i <= InNum; i++)
+	{
+		Tree[i] += InitialValue;
+		const int Parent = i + (i & -i);
+		if (Parent <= InNum)
+		{
+			Tree[Parent] += Tree[i];
+		}
+	}
+}
+
+void FMM_FenwickTree::Empty()
+{
+	Tree.Empty();
+	HighestStep = 0;
+}
+
+void FMM_FenwickTree::Add(int Index, int Delta)
+{
+	for (int i = Index + 1; i < Tree.Num(); i += i & -i)
+	{
+		Tree[i] += Delta;
+	}
+}
+
+int FMM_FenwickTree::PrefixSum(int Index) const
+{
+	int Sum = 0;
+	for (int i = FMath::Min(Index + 1, Num()); i > 0; i -= i & -i)
+	{
+		Sum += Tree[i];
+	}
+	return Sum;
+}
+
+int FMM_FenwickTree::FindByPrefix(int Unit) const
+{
+	if (Unit < 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Descend from the largest step, keeping the position where the prefix sum is still at or below the unit
+	int Position = 0;
+	int Remaining = Unit;
+	for (int Step = HighestStep; Step > 0; Step >>= 1)
+	{
+		const int Next = Position + Step;
+		if (Next <= Num() && Tree[Next] <= Remaining)
+		{
+			Position = Next;
+			Remaining -= Tree[Next];
+		}
+	}
+
+	// Position is the one based entry before the one holding the unit, which is its zero based index
+	return Position < Num() ? Position : INDEX_NONE;
+}
+
+// ################################ Setup ################################
+
+void FMM_FreeSlotIndex::Setup(const FIntVector2D& InGridSize)
+{
+	GridSize = InGridSize;
+	FreeBits.Init(true, GridSize.X * GridSize.Y);
+	ColumnCounts.Init(GridSize.X, GridSize.Y);
+
+	ColumnRows.SetNum(GridSize.X);
+	for (FMM_FenwickTree& Rows : ColumnRows)
+	{
+		Rows.Init(GridSize.Y, 1);
+	}
+}
+
+void FMM_FreeSlotIndex::Empty()
+{
+	GridSize = FIntVector2D(0, 0);
+	FreeBits.Empty();
+	ColumnCounts.Empty();
+	ColumnRows.Empty();
+}
+
+SIZE_T FMM_FreeSlotIndex::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = FreeBits.GetAllocatedSize() + ColumnCounts.GetAllocatedSize() + ColumnRows.GetAllocatedSize();
+	for (const FMM_FenwickTree& Rows : ColumnRows)
+	{
+		AllocatedSize += Rows.GetAllocatedSize();
+	}
+	return AllocatedSize;
+}
+
+// ################################ Slots ################################
+
+void FMM_FreeSlotIndex::SetFree(const FIntVector2D& Coord, bool bFree)
+{
+	FBitReference FreeBit = FreeBits[Coord.X * GridSize.Y + Coord.Y];
+
+	// Slots are often set to the state they already have, such as columns moving
+	if (FreeBit == bFree)
+	{
+		return;
+	}
+
+	FreeBit = bFree;
+	const int Delta = bFree ? 1 : -1;
+	ColumnCounts.Add(Coord.X, Delta);
+	ColumnRows[Coord.X].Add(Coord.Y, Delta);
+}
+
+void FMM_FreeSlotIndex::GetFreeSlots(TArray<FIntVector2D>& OutFreeSlots) const
+{
+	OutFreeSlots.Reset(Num());
+	for (TConstSetBitIterator<> It(FreeBits); It; ++It)
+	{
+		OutFreeSlots.Emplace(It.GetIndex() / GridSize.Y, It.GetIndex() % GridSize.Y);
+	}
+}
+
+// ################################ Range Queries ################################
+
+int FMM_FreeSlotIndex::CountInRange(int MinX, int MaxX, int MinY, int MaxY) const
+{
+	const int ClampedMinX = FMath::Max(MinX, 0);
+	const int ClampedMaxX = FMath::Min(MaxX, GridSize.X - 1);
+	if (ClampedMinX > ClampedMaxX || MinY > MaxY)
+	{
+		return 0;
+	}
+
+	// Whole columns are a single range of the column counts
+	if (IsFullColumnRange(MinY, MaxY))
+	{
+		return ColumnCounts.RangeSum(ClampedMinX, ClampedMaxX);
+	}
+
+	int Count = 0;
+	for (int x = ClampedMinX; x <= ClampedMaxX; x++)
+	{
+		Count += ColumnRows[x].RangeSum(MinY, MaxY);
+	}
+	return Count;
+}
+
+bool FMM_FreeSlotIndex::FindInRange(int SlotNumber, int MinX, int MaxX, int MinY, int MaxY, FIntVector2D& OutCoord) const
+{
+	const int ClampedMinX = FMath::Max(MinX, 0);
+	const int ClampedMaxX = FMath::Min(MaxX, GridSize.X - 1);
+	if (SlotNumber < 0 || ClampedMinX > ClampedMaxX || MinY > MaxY)
+	{
+		return false;
+	}
+
+	// Whole columns, find the column holding the slot then the row within it
+	if (IsFullColumnRange(MinY, MaxY))
+	{
+		const int Unit = ColumnCounts.PrefixSum(ClampedMinX - 1) + SlotNumber;
+		const int Column = ColumnCounts.FindByPrefix(Unit);
+
+		// Past the end of the range
+		if (Column == INDEX_NONE || Column > ClampedMaxX)
+		{
+			return false;
+		}
+
+		const int Row = ColumnRows[Column].FindByPrefix(Unit - ColumnCounts.PrefixSum(Column - 1));
+		OutCoord = FIntVector2D(Column, Row);
+		return Row != INDEX_NONE;
+	}
+
+	// Partial rows, count each column's rows in range until reaching the column holding the slot
+	int Remaining = SlotNumber;
+	for (int x = ClampedMinX; x <= ClampedMaxX; x++)
+	{
+		const int InColumn = ColumnRows[x].RangeSum(MinY, MaxY);
+		if (Remaining < InColumn)
+		{
+			const int Row = ColumnRows[x].FindByPrefix(ColumnRows[x].PrefixSum(MinY - 1) + Remaining);
+			OutCoord = FIntVector2D(x, Row);
+			return Row != INDEX_NONE;
+		}
+		Remaining -= InColumn;
+	}
+
+	return false;
+}
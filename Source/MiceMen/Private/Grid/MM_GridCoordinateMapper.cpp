@@ -0,0 +1,82 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Grid/MM_GridCoordinateMapper.h"
+
+#include "Grid/MM_GridObject.h"
+
+void FMM_GridCoordinateMapper::Update(const FTransform& InGridTransform, const FIntVector2D& InGridSize, float ElementWidth, float ElementHeight)
+{
+	GridTransform = InGridTransform;
+	GridSize = InGridSize;
+
+	// Since X is forward, horizontal axis is Y, and vertical axis is Z
+	// Starting Bottom Left
+	const FVector RelativeOrigin = FVector(0, -(GridSize.X / 2) * ElementWidth, 0);
+	Origin = GridTransform.TransformPosition(RelativeOrigin);
+	ColumnStep = GridTransform.TransformVector(FVector(0, ElementWidth, 0));
+	RowStep = GridTransform.TransformVector(FVector(0, 0, ElementHeight));
+	PlaneNormal = GridTransform.GetRotation().GetForwardVector();
+
+	// Steps are perpendicular, so projecting onto each gives the coordinate back
+	const double ColumnStepSizeSquared = ColumnStep.SizeSquared();
+	const double RowStepSizeSquared = RowStep.SizeSquared();
+	bValid = ColumnStepSizeSquared > SMALL_NUMBER && RowStepSizeSquared > SMALL_NUMBER;
+	if (bValid)
+	{
+		InverseColumnStep = ColumnStep / ColumnStepSizeSquared;
+		InverseRowStep = RowStep / RowStepSizeSquared;
+	}
+}
+
+FTransform FMM_GridCoordinateMapper::CoordToWorldTransform(const FIntVector2D& Coord) const
+{
+	FTransform GridElementTransform = GridTransform;
+	GridElementTransform.SetLocation(CoordToWorld(Coord));
+	return GridElementTransform;
+}
+
+void FMM_GridCoordinateMapper::CoordsToWorld(TArrayView<const FIntVector2D> Coords, TArray<FVector>& OutLocations) const
+{
+	OutLocations.SetNumUninitialized(Coords.Num(), false);
+
+	// Straight multiply add over contiguous arrays, with no branches so the compiler can vectorize it
+	const FIntVector2D* RESTRICT CoordData = Coords.GetData();
+	FVector* RESTRICT LocationData = OutLocations.GetData();
+	for (int i = 0; i < Coords.Num(); i++)
+	{
+		LocationData[i] = Origin + ColumnStep * CoordData[i].X + RowStep * CoordData[i].Y;
+	}
+}
+
+bool FMM_GridCoordinateMapper::WorldToCoord(const FVector& WorldLocation, FIntVector2D& OutCoord) const
+{
+	const FVector Offset = WorldLocation - Origin;
+
+	// Column origins are at the center of the column, rows are at the bottom of the slot
+	OutCoord.X = FMath::FloorToInt(FVector::DotProduct(Offset, InverseColumnStep) + 0.5);
+	OutCoord.Y = FMath::FloorToInt(FVector::DotProduct(Offset, InverseRowStep));
+
+	return bValid && UMM_GridObject::IsCoordInRange(OutCoord, 0, GridSize.X - 1, 0, GridSize.Y - 1);
+}
+
+bool FMM_GridCoordinateMapper::IntersectGridPlane(const FVector& RayOrigin, const FVector& RayDirection, FVector& OutHitLocation) const
+{
+	const double Denominator = FVector::DotProduct(RayDirection, PlaneNormal);
+
+	// Ray runs along the plane, no single intersection
+	if (FMath::IsNearlyZero(Denominator))
+	{
+		return false;
+	}
+
+	const double RayDistance = FVector::DotProduct(Origin - RayOrigin, PlaneNormal) / Denominator;
+
+	// Plane is behind the ray
+	if (RayDistance < 0.0)
+	{
+		return false;
+	}
+
+	OutHitLocation = RayOrigin + RayDirection * RayDistance;
+	return true;
+}
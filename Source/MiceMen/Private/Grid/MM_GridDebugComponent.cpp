@@ -0,0 +1,239 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Grid/MM_GridDebugComponent.h"
+
+#include "Grid/MM_GridManager.h"
+#include "Grid/MM_GridObject.h"
+
+UMM_GridDebugComponent::UMM_GridDebugComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UMM_GridDebugComponent::OnUnregister()
+{
+	HideGrid();
+
+	Super::OnUnregister();
+}
+
+void UMM_GridDebugComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	bool bLinesChanged = false;
+
+	// Update only the slots that changed since the last tick
+	if (DirtySlots.Num() > 0)
+	{
+		for (const FIntVector2D& Coord : DirtySlots)
+		{
+			UpdateSlotLines(Coord);
+		}
+		DirtySlots.Reset();
+		bLinesChanged = true;
+	}
+
+	// Count down paths, removing any that have expired
+	const int PreviousPathCount = ActivePaths.Num();
+	for (int i = ActivePaths.Num() - 1; i >= 0; i--)
+	{
+		ActivePaths[i].RemainingLifeTime -= DeltaTime;
+		if (ActivePaths[i].RemainingLifeTime <= 0.0f)
+		{
+			ActivePaths.RemoveAt(i);
+		}
+	}
+	if (ActivePaths.Num() != PreviousPathCount)
+	{
+		RebuildPathLines();
+		bLinesChanged = true;
+	}
+
+	// Send the batch to the renderer once for all changes this tick
+	if (bLinesChanged && LineBatcher)
+	{
+		LineBatcher->MarkRenderStateDirty();
+	}
+}
+
+// ################################ Grid Display ################################
+
+void UMM_GridDebugComponent::ShowGrid(AMM_GridManager* InGridManager, UMM_GridObject* InGridObject)
+{
+	// Clear any previous grid, such as when the grid is rebuilt
+	HideGrid();
+
+	if (!InGridManager || !InGridObject)
+	{
+		return;
+	}
+
+	GridManager = InGridManager;
+	DisplayedGridObject = InGridObject;
+	DisplayedGridSize = GridManager->GetGridSize();
+
+#if !UE_BUILD_SHIPPING
+	// Build every slot once, column by column to match the grid array layout
+	TArray<FBatchedLine> SlotLines;
+	SlotLines.Reserve(DisplayedGridSize.X * DisplayedGridSize.Y * LinesPerSlot);
+	for (int x = 0; x < DisplayedGridSize.X; x++)
+	{
+		for (int y = 0; y < DisplayedGridSize.Y; y++)
+		{
+			AddSlotLines(SlotLines, {x, y});
+		}
+	}
+
+	// Grid lines are kept at the start of the batch so the lines for a slot can be found by index
+	ULineBatchComponent* Batcher = GetLineBatcher();
+	Batcher->BatchedLines.Insert(SlotLines, 0);
+	GridLineCount = SlotLines.Num();
+	Batcher->MarkRenderStateDirty();
+#endif
+
+	// Listen for slot changes to update only those slots
+	SlotChangedHandle = DisplayedGridObject->OnSlotChanged.AddUObject(this, &UMM_GridDebugComponent::HandleSlotChanged);
+}
+
+void UMM_GridDebugComponent::HideGrid()
+{
+	if (DisplayedGridObject)
+	{
+		DisplayedGridObject->OnSlotChanged.Remove(SlotChangedHandle);
+	}
+	SlotChangedHandle.Reset();
+	DisplayedGridObject = nullptr;
+	DirtySlots.Reset();
+
+	// Remove the slot lines, leaving any paths
+	if (LineBatcher && GridLineCount > 0)
+	{
+		LineBatcher->BatchedLines.RemoveAt(0, FMath::Min(GridLineCount, LineBatcher->BatchedLines.Num()));
+		LineBatcher->MarkRenderStateDirty();
+	}
+	GridLineCount = 0;
+}
+
+void UMM_GridDebugComponent::HandleSlotChanged(const FIntVector2D& Coord)
+{
+	DirtySlots.Add(Coord);
+}
+
+void UMM_GridDebugComponent::AddSlotLines(TArray<FBatchedLine>& Lines, const FIntVector2D& Coord) const
+{
+	const FVector Center = GetSlotLocation(Coord);
+	const FLinearColor Colour = GetSlotColour(Coord);
+
+	// Diamond facing the camera, along the horizontal and vertical axis of the grid
+	const FVector Right = GridManager->GetActorRightVector() * SlotMarkerSize;
+	const FVector Up = GridManager->GetActorUpVector() * SlotMarkerSize;
+	const FVector Points[LinesPerSlot] = {Center + Up, Center + Right, Center - Up, Center - Right};
+
+	for (int i = 0; i < LinesPerSlot; i++)
+	{
+		// Life time of zero keeps the line until it is removed
+		Lines.Add(FBatchedLine(Points[i], Points[(i + 1) % LinesPerSlot], Colour, 0.0f, LineThickness, SDPG_World));
+	}
+}
+
+void UMM_GridDebugComponent::UpdateSlotLines(const FIntVector2D& Coord)
+{
+	if (!LineBatcher || !DisplayedGridObject)
+	{
+		return;
+	}
+
+	// Matches the column by row order used when building the slots
+	const int StartIndex = (Coord.X * DisplayedGridSize.Y + Coord.Y) * LinesPerSlot;
+	if (StartIndex < 0 || StartIndex + LinesPerSlot > GridLineCount)
+	{
+		return;
+	}
+
+	const FLinearColor Colour = GetSlotColour(Coord);
+	for (int i = StartIndex; i < StartIndex + LinesPerSlot; i++)
+	{
+		LineBatcher->BatchedLines[i].Color = Colour;
+	}
+}
+
+FLinearColor UMM_GridDebugComponent::GetSlotColour(const FIntVector2D& Coord) const
+{
+	switch (DisplayedGridObject->GetSlotType(Coord))
+	{
+	// Display green for mice
+	case EGridSlotType::E_MOUSE:
+		return FLinearColor::Green;
+	// Display yellow for block
+	case EGridSlotType::E_BLOCK:
+		return FLinearColor::Yellow;
+	// Display white for empty
+	default:
+		return FLinearColor::White;
+	}
+}
+
+// ################################ Path Display ################################
+
+void UMM_GridDebugComponent::DrawPath(const TArray<FIntVector2D>& Path)
+{
+#if !UE_BUILD_SHIPPING
+	if (!GridManager || Path.Num() < 2)
+	{
+		return;
+	}
+
+	FMM_DebugPath& NewPath = ActivePaths.AddDefaulted_GetRef();
+	NewPath.RemainingLifeTime = PathLifeTime;
+	NewPath.Lines.Reserve(Path.Num() - 1);
+
+	// Connect each step of the path through the center of the slots
+	const FLinearColor Colour = FLinearColor::MakeRandomColor();
+	const FVector HalfHeight = GridManager->GetActorUpVector() * (GridManager->GridElementHeight / 2.0f);
+	FVector PreviousLocation = GridManager->CoordToWorldTransform(Path[0]).GetLocation() + HalfHeight;
+	for (int i = 1; i < Path.Num(); i++)
+	{
+		const FVector Location = GridManager->CoordToWorldTransform(Path[i]).GetLocation() + HalfHeight;
+		NewPath.Lines.Add(FBatchedLine(PreviousLocation, Location, Colour, 0.0f, LineThickness, SDPG_Foreground));
+		PreviousLocation = Location;
+	}
+
+	GetLineBatcher()->BatchedLines.Append(NewPath.Lines);
+	LineBatcher->MarkRenderStateDirty();
+#endif
+}
+
+void UMM_GridDebugComponent::RebuildPathLines()
+{
+	if (!LineBatcher)
+	{
+		return;
+	}
+
+	// Keep grid lines, and replace everything after with the remaining paths
+	LineBatcher->BatchedLines.SetNum(FMath::Min(GridLineCount, LineBatcher->BatchedLines.Num()), false);
+	for (const FMM_DebugPath& ActivePath : ActivePaths)
+	{
+		LineBatcher->BatchedLines.Append(ActivePath.Lines);
+	}
+}
+
+// ################################ Helpers ################################
+
+ULineBatchComponent* UMM_GridDebugComponent::GetLineBatcher()
+{
+	if (!LineBatcher)
+	{
+		// Lines are stored in world space, so the batcher does not need to be attached
+		LineBatcher = NewObject<ULineBatchComponent>(GetOwner(), TEXT("GridDebugLineBatcher"));
+		LineBatcher->RegisterComponent();
+	}
+	return LineBatcher;
+}
+
+FVector UMM_GridDebugComponent::GetSlotLocation(const FIntVector2D& Coord) const
+{
+	// Offset in front of the grid elements so the markers are visible
+	return GridManager->CoordToWorldTransform(Coord).GetLocation() + FVector(-100, 0, 50);
+}
@@ -5,6 +5,7 @@
 #include "Grid/MM_GridManager.h"
 #include "Gameplay/MM_ColumnControl.h"
 #include "Base/MM_GameMode.h"
+#include "Base/MM_EventLog.h"
 #include "MiceMen.h"
 
 AMM_GridElement::AMM_GridElement()
@@ -20,7 +21,7 @@ void AMM_GridElement::SetupGridVariables(AMM_GridManager* InGridManager, AMM_Gam
 
 void AMM_GridElement::UpdateGridPosition(const FIntVector2D& NewGridCoordinates)
 {
-	UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridElement::UpdateGridPosition | Updating grid element %s to %s"), *GetName(), *NewGridCoordinates.ToString());
+	MM_EVENT(EGridEvent::E_ELEMENT_POSITION_UPDATED, NewGridCoordinates, this);
 
 	// Set new position
 	Coordinates = NewGridCoordinates;
@@ -32,11 +33,7 @@ void AMM_GridElement::UpdateGridPosition(const FIntVector2D& NewGridCoordinates)
 	}
 
 	// Find new column from new location
-	AMM_ColumnControl* NewColumn = nullptr;
-	if (GridManager->GetColumnControls().Contains(Coordinates.X))
-	{
-		NewColumn = GridManager->GetColumnControls()[Coordinates.X];
-	}
+	AMM_ColumnControl* NewColumn = GridManager->GetColumnControl(Coordinates.X);
 
 	// Check new column is different from current
 	if (NewColumn != CurrentColumn)
@@ -50,7 +47,7 @@ void AMM_GridElement::UpdateGridPosition(const FIntVector2D& NewGridCoordinates)
 		}
 		CurrentColumn = NewColumn;
 
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridElement::UpdateGridPosition | Switching to collumn %i"), Coordinates.X);
+		MM_EVENT(EGridEvent::E_ELEMENT_COLUMN_CHANGED, Coordinates, this);
 	}
 }
 
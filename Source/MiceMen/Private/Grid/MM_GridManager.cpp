@@ -9,10 +9,15 @@
 #include "Gameplay/MM_Mouse.h"
 #include "Gameplay/MM_ColumnControl.h"
 #include "Grid/MM_GridObject.h"
+#include "Grid/MM_GridDebugComponent.h"
+#include "Grid/MM_GridVisualsComponent.h"
+#include "Base/MM_EventLog.h"
 #include "MiceMen.h"
 #include "Base/MM_GameMode.h"
 #include "Player/MM_PlayerController.h"
 #include "Player/MM_GameViewPawn.h"
+#include "Rules/MM_FixedBoard.h"
+#include "Rules/MM_PuzzleSolver.h"
 
 // Sets default values
 AMM_GridManager::AMM_GridManager()
@@ -23,6 +28,9 @@ AMM_GridManager::AMM_GridManager()
 	GridBlockClass = AMM_GridBlock::StaticClass();
 	MouseClass = AMM_Mouse::StaticClass();
 	ColumnControlClass = AMM_ColumnControl::StaticClass();
+
+	DebugGridComponent = CreateDefaultSubobject<UMM_GridDebugComponent>(TEXT("Debug Grid"));
+	GridVisualsComponent = CreateDefaultSubobject<UMM_GridVisualsComponent>(TEXT("Grid Visuals"));
 }
 
 void AMM_GridManager::BeginPlay()
@@ -30,6 +38,18 @@ void AMM_GridManager::BeginPlay()
 	Super::BeginPlay();
 }
 
+void AMM_GridManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Keep mapping in sync with the grid actor being moved
+	if (RootComponent)
+	{
+		RootComponent->TransformUpdated.AddUObject(this, &AMM_GridManager::HandleGridTransformUpdated);
+	}
+	RefreshCoordinateMapper();
+}
+
 void AMM_GridManager::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
@@ -40,19 +60,13 @@ void AMM_GridManager::EndPlay(EEndPlayReason::Type EndPlayReason)
 void AMM_GridManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
-
-#if !UE_BUILD_SHIPPING
-	if (bDisplayDebugGrid)
-	{
-		DisplayDebugGrid();
-	}
-#endif
 }
 
 void AMM_GridManager::SetupGridVariables(const FIntVector2D& InGridSize, AMM_GameMode* InMMGameMode)
 {
 	GridSize = InGridSize;
 	MMGameMode = InMMGameMode;
+	RefreshCoordinateMapper();
 	UE_LOG(LogTemp, Display, TEXT("AMM_GridManager::SetupGridVariables | Setup grid with size %s and gamemode %s"),
 	       *GridSize.ToString(), MMGameMode ? *MMGameMode->GetName() : TEXT("none"));
 }
@@ -75,6 +89,12 @@ void AMM_GridManager::RebuildGrid(const int InitialMiceCount)
 	// Populate grid elements
 	PopulateGrid();
 	PopulateTeams(InitialMiceCount);
+
+	// Visualize the populated board
+	if (GridVisualsComponent)
+	{
+		GridVisualsComponent->ShowGrid(this, GridObject);
+	}
 }
 
 void AMM_GridManager::CreateGrid()
@@ -82,21 +102,36 @@ void AMM_GridManager::CreateGrid()
 	// Create new grid object and setup
 	GridObject = NewObject<UMM_GridObject>(this, UMM_GridObject::StaticClass());
 	GridObject->SetupGrid(GridSize);
+	RefreshCoordinateMapper();
+
+	// Display the new grid if the debug grid is enabled
+	if (bDisplayDebugGrid && DebugGridComponent)
+	{
+		DebugGridComponent->ShowGrid(this, GridObject);
+	}
 
-	// Remainder of division by 2, either 0 or 1
-	GapSize = GridSize.X % 2;
-	// Team size is the grid width without the gap, halved
-	TeamSize = (GridSize.X - GapSize) / 2;
+	// Either 0 or 1, team size is the grid width without the gap, halved
+	GapSize = FMM_BoardLayout::GetGapSize(GridSize.X);
+	TeamSize = FMM_BoardLayout::GetTeamSize(GridSize.X);
 }
 
 void AMM_GridManager::GridCleanUp()
 {
+	// Return block visuals before their columns are destroyed, then destroy them as the next grid may need fewer
+	if (GridVisualsComponent)
+	{
+		GridVisualsComponent->HideGrid();
+		GridVisualsComponent->EmptyBlockPool();
+	}
+
 	// Remove all columns
 	for (const TPair<int, AMM_ColumnControl*>& Column : ColumnControls)
 	{
 		if (Column.Value)
 		{
 			Column.Value->Destroy();
+			DEC_DWORD_STAT(STAT_MiceMen_ColumnControls);
+			INC_DWORD_STAT(STAT_MiceMen_ActorsDestroyed);
 		}
 	}
 	ColumnControls.Empty();
@@ -107,6 +142,8 @@ void AMM_GridManager::GridCleanUp()
 		if (Mouse)
 		{
 			Mouse->Destroy();
+			DEC_DWORD_STAT(STAT_MiceMen_MouseActors);
+			INC_DWORD_STAT(STAT_MiceMen_ActorsDestroyed);
 		}
 	}
 	Mice.Empty();
@@ -115,6 +152,8 @@ void AMM_GridManager::GridCleanUp()
 		if (Mouse)
 		{
 			Mouse->Destroy();
+			DEC_DWORD_STAT(STAT_MiceMen_MouseActors);
+			INC_DWORD_STAT(STAT_MiceMen_ActorsDestroyed);
 		}
 	}
 	CompletedMice.Empty();
@@ -124,9 +163,17 @@ void AMM_GridManager::GridCleanUp()
 	MiceColumns.Empty();
 	OccupiedTeamsPerColumn.Empty();
 	LastMovedColumn = -1;
-	MiceToProcessMovement.Empty();
+	CascadePreview = FMM_CascadePreview();
+	NextPreviewMove = INDEX_NONE;
+	CurrentTurnRecord = FMM_TurnRecord();
+	ColumnLockInTime = 0.0;
+	MousePlayoutTime = 0.0;
 
 	// Remaining grid cleanup
+	if (DebugGridComponent)
+	{
+		DebugGridComponent->HideGrid();
+	}
 	if (GridObject)
 	{
 		GridObject->CleanUp();
@@ -137,6 +184,8 @@ void AMM_GridManager::GridCleanUp()
 
 void AMM_GridManager::PopulateGrid()
 {
+	MM_TRACE_SCOPE("AMM_GridManager::PopulateGrid");
+
 	UE_LOG(LogTemp, Display, TEXT("AMM_GridManager::PopulateGrid | Populating grid of size %s"), *GridSize.ToString());
 
 	// For each column
@@ -149,24 +198,28 @@ void AMM_GridManager::PopulateGrid()
 		}
 
 		// Setup new column
+		LLM_SCOPE_BYTAG(MiceMen_Columns);
 		FTransform ColumnTransform = CoordToWorldTransform(FIntVector2D(x, 0));
 		AMM_ColumnControl* NewColumnControl = GetWorld()->SpawnActorDeferred<AMM_ColumnControl>(
 			ColumnControlClass, ColumnTransform);
 		NewColumnControl->SetupColumn(x, this);
+		NewColumnControl->CustomTimeDilation = GetSimulationSpeed();
 		UGameplayStatics::FinishSpawningActor(NewColumnControl, ColumnTransform);
 		ColumnControls.Add(x, NewColumnControl);
+		INC_DWORD_STAT(STAT_MiceMen_ColumnControls);
+		INC_DWORD_STAT(STAT_MiceMen_ActorsSpawned);
 
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::PopulateGrid | Adding collumn at %i"), x);
+		MM_EVENT(EGridEvent::E_COLUMN_ADDED, FIntVector2D(x, 0), NewColumnControl);
 
-		// Store new column for game play use
-		MiceColumns.Add(x, TArray<AMM_Mouse*>());
-		OccupiedTeamsPerColumn.Add(x, TArray<ETeam>());
+		// Store new column for game play use, sized for a full column so mice moving between columns doesn't allocate
+		MiceColumns.Add(x, TArray<AMM_Mouse*>()).Reserve(GridSize.Y);
+		OccupiedTeamsPerColumn.Add(x, TArray<ETeam>()).Reserve(2);
 
 		// For each row, add to column array
 		for (int y = 0; y < GridSize.Y; y++)
 		{
 			// Place random block (or center blocks) or an empty slot
-			PlaceGridElement({x, y}, NewColumnControl);
+			PlaceGridElement({x, y});
 		}
 
 		// Remove blocks based on sparseness
@@ -182,15 +235,12 @@ void AMM_GridManager::PopulateGrid()
 			{
 				continue;
 			}
-			// Check grid element exists
-			AMM_GridElement* CurrentGridElement = GridObject->GetGridElement(RandomCoord);
-			if (CurrentGridElement)
+			// Check block exists
+			if (GridObject->GetSlotType(RandomCoord) == EGridSlotType::E_BLOCK)
 			{
-				// Remove grid element
-				UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::PopulateGrid | Removing block in column %i at %i"), x, RandomY);
-				GridObject->SetGridElement(RandomCoord, nullptr);
-				CurrentGridElement->CleanUp();
-				CurrentGridElement->Destroy();
+				// Remove block
+				MM_EVENT(EGridEvent::E_BLOCK_REMOVED, RandomCoord);
+				GridObject->SetGridBlock(RandomCoord, false);
 			}
 		}
 	}
@@ -200,62 +250,27 @@ bool AMM_GridManager::IsCoordInCenterGroup(const FIntVector2D& NewCoord) const
 {
 	// If gap size is 1, alternating blocks will be either side
 	// If gap size is 0, will have one side place a block every third y pos, and the other side the opposite
-	
-	const int Start = TeamSize - 1;
-	const int End = TeamSize + GapSize;
-	return NewCoord.X >= Start && NewCoord.X <= End;
+	return FMM_BoardLayout::IsColumnInCenterGroup(GridSize.X, NewCoord.X);
 }
 
-void AMM_GridManager::PlaceGridElement(const FIntVector2D& NewCoord, AMM_ColumnControl* ColumnControl)
+void AMM_GridManager::PlaceGridElement(const FIntVector2D& NewCoord)
 {
-	// Initial variables
-	const FTransform GridElementTransform = CoordToWorldTransform(NewCoord);
-
 	// Prepare center pieces, creates blocking center where mice can't cross at the start
 	const bool bIsPresetCenterBlock = IsCoordInCenterGroup(NewCoord);
 
-	// Default to not have preset block
-	bool bIsPresetBlockFilled = false;
-	if (bIsPresetCenterBlock)
-	{
-		// If coord is in the center column
-		if (NewCoord.X == TeamSize)
-		{
-			// If vertical position not dividable by 3, then its not every third block
-			bIsPresetBlockFilled = NewCoord.Y % 3 != 0;
-		}
-		else
-		{
-			// If vertical position dividable by 3, then its every third block 
-			bIsPresetBlockFilled = NewCoord.Y % 3 == 0;
-		}
-	}
+	// The center column is blocked except every third block, the columns either side every third block
+	const bool bIsPresetBlockFilled = FMM_BoardLayout::IsCenterBlockFilled(GridSize.X, NewCoord.X, NewCoord.Y);
 
 	// Initial testing random bool for placement unless overridden by center blocks
 	if ((FMath::RandBool() && !bIsPresetCenterBlock) || bIsPresetBlockFilled)
 	{
-		// Create new Grid block object
-		AMM_GridBlock* NewGridBlock = GetWorld()->SpawnActor<AMM_GridBlock>(GridBlockClass, GridElementTransform);
-		if (!NewGridBlock)
-		{
-			UE_LOG(MiceMenEventLog, Error, TEXT("AMM_GridManager::PlaceGridElement | Failed to create Grid Block!"));
-			return;
-		}
-		NewGridBlock->SetupGridVariables(this, MMGameMode, NewCoord);
-
-		// Store element and attach
-		if (ColumnControl)
-		{
-			NewGridBlock->AttachToActor(ColumnControl, FAttachmentTransformRules::KeepWorldTransform);
-		}
-		GridObject->SetGridElement(NewCoord, NewGridBlock);
-
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::PlaceGridElement | Adding grid block at %s"), *NewCoord.ToString());
+		// Blocks are only stored in the logical board, visuals are added by the visuals component for columns in view
+		GridObject->SetGridBlock(NewCoord, true);
 	}
 	else
 	{
-		// Set element as empty
-		GridObject->SetGridElement(NewCoord, nullptr);
+		// Set slot as empty
+		GridObject->SetGridBlock(NewCoord, false);
 	}
 }
 
@@ -265,10 +280,12 @@ void AMM_GridManager::PopulateTeams(int MicePerTeam)
 	TMap<ETeam, FIntVector2D> TeamRanges;
 
 	// Left side range in grid, to the team size
-	TeamRanges.Add(ETeam::E_TEAM_A, FIntVector2D(0, TeamSize - 1));
+	TeamRanges.Add(ETeam::E_TEAM_A, FIntVector2D(FMM_BoardLayout::GetTeamFirstColumn(GridSize.X, ERulesTeam::E_TEAM_A),
+	                                              FMM_BoardLayout::GetTeamLastColumn(GridSize.X, ERulesTeam::E_TEAM_A)));
 
 	// Right side range in grid, starting to the right of the center blocks to the end of the grid
-	TeamRanges.Add(ETeam::E_TEAM_B, FIntVector2D(TeamSize + GapSize, GridSize.X - 1));
+	TeamRanges.Add(ETeam::E_TEAM_B, FIntVector2D(FMM_BoardLayout::GetTeamFirstColumn(GridSize.X, ERulesTeam::E_TEAM_B),
+	                                              FMM_BoardLayout::GetTeamLastColumn(GridSize.X, ERulesTeam::E_TEAM_B)));
 
 	UE_LOG(LogTemp, Display, TEXT("AMM_GridManager::PopulateTeams | Populating mice with team ranges %s and %s"), *TeamRanges[ETeam::E_TEAM_A].ToString(), *TeamRanges[ETeam::E_TEAM_B].ToString());
 
@@ -290,8 +307,10 @@ void AMM_GridManager::PopulateTeams(int MicePerTeam)
 			FIntVector2D NewRandomMousePosition = GridObject->GetRandomGridCoordInColumnRange(TeamRanges[CurrentTeam].X, TeamRanges[CurrentTeam].Y);
 
 			// Setup new Mouse
+			LLM_SCOPE_BYTAG(MiceMen_Mice);
 			AMM_Mouse* NewMouse = GetWorld()->SpawnActorDeferred<AMM_Mouse>(MouseClass, FTransform::Identity);
 			NewMouse->SetupGridVariables(this, MMGameMode, NewRandomMousePosition);
+			NewMouse->CustomTimeDilation = GetSimulationSpeed();
 
 			// Setup mouse updates position based on movement path
 			NewMouse->SetupMouse(CurrentTeam, NewRandomMousePosition);
@@ -308,44 +327,97 @@ void AMM_GridManager::PopulateTeams(int MicePerTeam)
 			GridObject->SetGridElement(NewRandomMousePosition, NewMouse);
 			Mice.Add(NewMouse);
 			MiceTeams[CurrentTeam].Add(NewMouse);
+			INC_DWORD_STAT(STAT_MiceMen_MouseActors);
+			INC_DWORD_STAT(STAT_MiceMen_ActorsSpawned);
 
-			UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::PopulateTeams | Adding mice for team %i at %s"), CurrentTeam, *NewRandomMousePosition.ToString());
+			MM_EVENT(EGridEvent::E_MOUSE_SPAWNED, NewRandomMousePosition, NewMouse, static_cast<int32>(CurrentTeam));
 		}
 	}
+
+	// Size processing containers for every mouse, so turns don't allocate
+	ResolveMiceScratch.Reserve(Mice.Num());
+	CompletedMice.Reserve(Mice.Num());
 }
 
-TArray<FVector> AMM_GridManager::PathCoordToWorld(const TArray<FIntVector2D>& CoordPath) const
+void AMM_GridManager::ApplySimulationSpeed(float SimulationSpeed)
 {
-	TArray<FVector> NewWorldPath;
-	for (const FIntVector2D& Coord : CoordPath)
+	// Time dilation scales the tick, timelines and latent actions of each actor, speeding up Blueprint animations
+	for (const TPair<int, AMM_ColumnControl*>& Column : ColumnControls)
 	{
-		const FVector WorldLocation = CoordToWorldTransform(Coord).GetLocation();
-		NewWorldPath.Add(WorldLocation);
+		if (Column.Value)
+		{
+			Column.Value->CustomTimeDilation = SimulationSpeed;
+		}
 	}
+	for (AMM_Mouse* Mouse : Mice)
+	{
+		if (Mouse)
+		{
+			Mouse->CustomTimeDilation = SimulationSpeed;
+		}
+	}
+}
+
+float AMM_GridManager::GetSimulationSpeed() const
+{
+	if (MMGameMode)
+	{
+		return MMGameMode->GetSimulationSpeed();
+	}
+	return 1.0f;
+}
+
+void AMM_GridManager::RefreshCoordinateMapper()
+{
+	CoordinateMapper.Update(GetActorTransform(), GridSize, GridElementWidth, GridElementHeight);
+}
+
+void AMM_GridManager::HandleGridTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	RefreshCoordinateMapper();
+}
+
+TArray<FVector> AMM_GridManager::PathCoordToWorld(const TArray<FIntVector2D>& CoordPath) const
+{
+	LLM_SCOPE_BYTAG(MiceMen_Paths);
+	INC_DWORD_STAT(STAT_MiceMen_PathArrays);
+
+	TArray<FVector> NewWorldPath;
+	CoordinateMapper.CoordsToWorld(CoordPath, NewWorldPath);
 	return NewWorldPath;
 }
 
-FTransform AMM_GridManager::CoordToWorldTransform(const FIntVector2D& Coords) const
+void AMM_GridManager::ConvertPathToWorld(TArrayView<const FIntVector2D> CoordPath, TArray<FVector>& OutWorldPath) const
 {
-	FTransform GridElementTransform = GetActorTransform();
-	FVector NewRelativeLocation = FVector::Zero();
+	LLM_SCOPE_BYTAG(MiceMen_Paths);
+	CoordinateMapper.CoordsToWorld(CoordPath, OutWorldPath);
+}
 
-	// Since X is forward, horizontal axis is Y, and vertical axis is Z
+FTransform AMM_GridManager::CoordToWorldTransform(const FIntVector2D& Coords) const
+{
+	return CoordinateMapper.CoordToWorldTransform(Coords);
+}
 
-	// Starting Bottom Left
-	NewRelativeLocation.Y -= (GridSize.X / 2) * GridElementWidth;
+bool AMM_GridManager::WorldToCoord(const FVector& WorldLocation, FIntVector2D& OutCoord) const
+{
+	return CoordinateMapper.WorldToCoord(WorldLocation, OutCoord);
+}
 
-	// Add coordinate offset based on grid element size
-	NewRelativeLocation.Y += Coords.X * GridElementWidth;
-	NewRelativeLocation.Z += Coords.Y * GridElementHeight;
+bool AMM_GridManager::WorldRayToCoord(const FVector& RayOrigin, const FVector& RayDirection, FIntVector2D& OutCoord, FVector& OutHitLocation) const
+{
+	OutCoord = FIntVector2D(INDEX_NONE, INDEX_NONE);
 
-	// Transform from relative to world
-	const FVector NewWorldLocation = GetActorTransform().TransformPosition(NewRelativeLocation);
+	if (!IntersectGridPlane(RayOrigin, RayDirection, OutHitLocation))
+	{
+		return false;
+	}
 
-	// Apply location to new transform
-	GridElementTransform.SetLocation(NewWorldLocation);
+	return WorldToCoord(OutHitLocation, OutCoord);
+}
 
-	return GridElementTransform;
+bool AMM_GridManager::IntersectGridPlane(const FVector& RayOrigin, const FVector& RayDirection, FVector& OutHitLocation) const
+{
+	return CoordinateMapper.IntersectGridPlane(RayOrigin, RayDirection, OutHitLocation);
 }
 
 EDirection AMM_GridManager::GetDirectionFromTeam(ETeam Team)
@@ -360,16 +432,21 @@ EDirection AMM_GridManager::GetDirectionFromTeam(ETeam Team)
 
 void AMM_GridManager::BeginProcessMice()
 {
+	MM_TRACE_SCOPE("AMM_GridManager::BeginProcessMice");
+
 	// Keeps a reference to the player to keep a link to who's turn is being processed as a safety
 	// If the turn is somehow switched while this is processing, it will then be ignored by
 	// the game mode once complete
-	CurrentPlayerProcessing = MMGameMode->GetCurrentPlayer();
+	CurrentPlayerProcessing = MMGameMode ? MMGameMode->GetCurrentPlayer() : nullptr;
+	const ETeam FirstTeam = CurrentPlayerProcessing ? CurrentPlayerProcessing->GetCurrentTeam() : ETeam::E_NONE;
 
-	// Save all mice in the correct order based on the current team as the starting mice
-	StoreOrderedMiceToProcess();
+	// Resolve the cascade on the rules board, then play each movement as a previewed cascade is played
+	SimulateCascade(FirstTeam, CascadePreview);
+	CurrentTurnRecord.CascadePasses = CascadePreview.CascadePasses;
+	TRACE_COUNTER_SET(MiceMen_CascadePasses, CurrentTurnRecord.CascadePasses);
 
 	// Check test mode
-	if (MMGameMode->GetCurrentGameType() == EGameType::E_TEST)
+	if (MMGameMode && MMGameMode->GetCurrentGameType() == EGameType::E_TEST)
 	{
 		// If running a test, stop processing if not all mice were processed
 		if (!DebugCheckAllMiceProcessed())
@@ -378,139 +455,68 @@ void AMM_GridManager::BeginProcessMice()
 		}
 	}
 
-	// Start processing, nullptr will ignore cleanup
-	CurrentProcessedMovedMiceCount = 0;
-	HandleCompletedMouseMovement(nullptr);
+	MM_EVENT(EGridEvent::E_TEAM_PROCESSING, FIntVector2D(INDEX_NONE, INDEX_NONE), nullptr, static_cast<int32>(FirstTeam));
+
+	NextPreviewMove = 0;
+	PlayNextPreviewMove();
 }
 
-void AMM_GridManager::StoreOrderedMiceToProcess()
+int AMM_GridManager::ResolveMiceImmediately(ETeam FirstTeam)
 {
-	TArray<ETeam> OrderedTeamsToProcess;
+	MM_TRACE_SCOPE("AMM_GridManager::ResolveMiceImmediately");
 
-	if (MMGameMode && CurrentPlayerProcessing)
+	BuildRulesBoard(ResolveBoardScratch);
+	CollectRulesBoardMice(ResolveBoardScratch, ResolveMiceScratch);
+	const FMM_RulesTurnResult Result = ResolveBoardScratch.ResolveCascade(static_cast<ERulesTeam>(FirstTeam), &ResolveLogScratch);
+
+	for (int i = 0; i < ResolveLogScratch.Moves.Num(); i++)
 	{
-		// Order the process of mice, starting with the current player's team
-		const ETeam CurrentPlayerTeam = CurrentPlayerProcessing->GetCurrentTeam();
-		OrderedTeamsToProcess.Add(CurrentPlayerTeam);
+		const FMM_RulesCascadeLog::FMove& LogMove = ResolveLogScratch.Moves[i];
+		AMM_Mouse* Mouse = ResolveMiceScratch[LogMove.MouseIndex];
 
-		// Add other team
-		ETeam SecondTeam = ETeam::E_TEAM_B;
-		if (CurrentPlayerTeam == ETeam::E_TEAM_B)
+		ResolvePathScratch.Reset();
+		for (const FIntPoint& PathCoord : ResolveLogScratch.GetPath(i))
 		{
-			SecondTeam = ETeam::E_TEAM_A;
+			ResolvePathScratch.Add(FIntVector2D(PathCoord.X, PathCoord.Y));
 		}
-		OrderedTeamsToProcess.Add(SecondTeam);
-	}
 
-	for (const ETeam CurrentTeam : OrderedTeamsToProcess)
-	{
-		// Mice for this team not added, cannot process
-		if (!MiceTeams.Contains(CurrentTeam))
+		// The board was built from the grid, so a mouse failing to move is a mismatch between them
+		if (!Mouse || !Mouse->PerformMovementAlongPath(ResolvePathScratch))
 		{
-			UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GridManager::StoreOrderedMiceToProcess | Unable to process mice for team %i, missing from Team Mice map"), CurrentTeam);
+			UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GridManager::ResolveMiceImmediately | Unable to apply movement %i from the rules board"), i);
 			continue;
 		}
 
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::StoreOrderedMiceToProcess | Processing mice for team %i"), CurrentTeam);
-
-		// The order is players who are lower, and front most, going first
-		// ie FIRST lower row players go, so that higher players fall and can move after
-		// and THEN for each in that row, forward players (closer towards their end) so they don't block other mice
-
-		TArray<AMM_Mouse*> CurrentTeamMiceToProcess;
-
-		// NOTE: Storing the Mice and checking/inserting in order, is more efficient than iterating through the whole grid
-		for (AMM_Mouse* TeamMouse : MiceTeams[CurrentTeam])
+		// Mouse is removed from the active mice on reaching its goal
+		if (Mouse->HasReachedEnd())
 		{
-			// Add first one without iteration
-			if (CurrentTeamMiceToProcess.Num() <= 0)
+			CompletedMice.Add(Mouse);
+			if (MMGameMode)
 			{
-				CurrentTeamMiceToProcess.Add(TeamMouse);
-				continue;
+				MMGameMode->AddScore(Mouse->GetTeam());
 			}
-
-			// Add mouse based on position
-			InsertMouseByOrder(TeamMouse, CurrentTeamMiceToProcess);
 		}
-
-		MiceToProcessMovement.Append(CurrentTeamMiceToProcess);
 	}
-}
 
-void AMM_GridManager::InsertMouseByOrder(AMM_Mouse* TeamMouse, TArray<AMM_Mouse*>& CurrentTeamMiceToProcess)
-{
-	const ETeam CurrentTeam = TeamMouse->GetTeam();
-
-	// Check through existing ordered mice
-	const FIntVector2D Coordinates = TeamMouse->GetCoordinates();
-	for (int i = 0; i < CurrentTeamMiceToProcess.Num(); i++)
-	{
-		const AMM_Mouse* OrderedMouse = CurrentTeamMiceToProcess[i];
-
-		// If new mouse is lower than or on the same line current being checked against
-		if (Coordinates.Y <= OrderedMouse->GetCoordinates().Y)
-		{
-			// If its on the same row, will check the new mouse is more forward
-			if (Coordinates.Y == OrderedMouse->GetCoordinates().Y)
-			{
-				// Check if the mouse is more forward, direction based on the team
-				bool bIsMoreForward = Coordinates.X > OrderedMouse->GetCoordinates().X;
-
-				// Team is going left
-				if (CurrentTeam == ETeam::E_TEAM_B)
-				{
-					bIsMoreForward = Coordinates.X < OrderedMouse->GetCoordinates().X;
-				}
-
-				// Mouse is not more forward, go to next
-				if (!bIsMoreForward)
-				{
-					continue;
-				}
-			}
-
-			// Insert at current
-			CurrentTeamMiceToProcess.Insert(TeamMouse, i);
-			break;
-		}
-	}
-
-	// Add to end (if not already) to ensure they are added to process
-	CurrentTeamMiceToProcess.AddUnique(TeamMouse);
+	return Result.CascadePasses;
 }
 
-void AMM_GridManager::ProcessMouse(AMM_Mouse* Mouse)
+void AMM_GridManager::HandleCompletedMouseMovement(AMM_Mouse* Mouse)
 {
-	// Check the mouse is valid to process
-	if (!CheckMouse(Mouse))
-	{
-		return;
-	}
-
-	// Set up delegate for when movement is complete
-	Mouse->MovementEndDelegate.AddDynamic(this, &AMM_GridManager::HandleCompletedMouseMovement);
+	// Cleanup processed mouse
+	CleanupProcessedMouse(Mouse);
 
-	// Attempt to move the mouse
-	const bool bMovementSuccesful = Mouse->AttemptPerformMovement();
-	if (!bMovementSuccesful)
+	// Add the time waited on the movement visuals
+	if (Mouse && Mouse->GetVisualMovementStartTime() > 0.0)
 	{
-		return;
+		MousePlayoutTime += FPlatformTime::Seconds() - Mouse->GetVisualMovementStartTime();
 	}
 
-	// A mice successfully moved
-	CurrentProcessedMovedMiceCount++;
-
-	// If test mode go straight to movement complete, as move delegate is not fired on mouse 
-	if (MMGameMode->GetCurrentGameType() == EGameType::E_TEST)
+	// Update the mouse visuals for its final column, once its movement has played
+	if (Mouse && !Mouse->HasReachedEnd() && GridVisualsComponent)
 	{
-		HandleCompletedMouseMovement(Mouse);
+		GridVisualsComponent->RefreshElementVisibility(Mouse);
 	}
-}
-
-void AMM_GridManager::HandleCompletedMouseMovement(AMM_Mouse* Mouse)
-{
-	// Cleanup processed mouse
-	CleanupProcessedMouse(Mouse);
 
 	// Check mouse has reached the end
 	if (Mouse && Mouse->HasReachedEnd())
@@ -523,47 +529,39 @@ void AMM_GridManager::HandleCompletedMouseMovement(AMM_Mouse* Mouse)
 
 		const ETeam MouseTeam = Mouse->GetTeam();
 
+		CurrentTurnRecord.GoalsScored++;
 		MMGameMode->AddScore(MouseTeam);
 		CompletedMice.Add(Mouse);
 
 		if (MMGameMode->HasTeamWon(MouseTeam))
 		{
 			// Mouse was winning mouse, stop processing mice
+			NextPreviewMove = INDEX_NONE;
+			ClearCascadePreview();
 			return;
 		}
 	}
 
-	const bool bAnyRemainingMiceToProcess = MiceToProcessMovement.IsValidIndex(0);
-
-	// There are still mice to process
-	if (bAnyRemainingMiceToProcess)
-	{
-		// Process Next mouse
-		ProcessMouse(MiceToProcessMovement[0]);
-	}
-	else
+	// Movements play in order, without walking the mice again
+	if (NextPreviewMove != INDEX_NONE)
 	{
-		HandleMiceComplete();
+		PlayNextPreviewMove();
 	}
 }
 
 void AMM_GridManager::HandleMiceComplete()
 {
-	// Check if mice moved in the last process 
-	if (CurrentProcessedMovedMiceCount > 0)
-	{
-		// Since mice moved, run through mice to process again to make sure any mice that can move, will move
-		BeginProcessMice();
-		return;
-	}
-
 	// Reached end, all mice processed
 	if (MMGameMode)
 	{
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::HandleMiceComplete | Turn ended for current player %i as %s, all mice processed"),
-			MMGameMode->GetCurrentPlayer()->GetCurrentTeam(), *MMGameMode->GetCurrentPlayer()->GetName());
+		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::HandleMiceComplete | Turn ended for current player %i as %s, all mice processed in %i passes"),
+			MMGameMode->GetCurrentPlayer()->GetCurrentTeam(), *MMGameMode->GetCurrentPlayer()->GetName(), CurrentTurnRecord.CascadePasses);
+
+		// Store stats before the next turn can begin
+		FinishTurnRecord();
 
-		if (CheckNoValidMoves())
+		// A stalemate plays out its turns and is decided on distance, even once neither mouse can reach its goal
+		if (MMGameMode->GetStalemateCount() < 0 && CheckNoValidMoves())
 		{
 			// No more moves can be made, end game and work out winner or tie game
 			MMGameMode->ForceEndNoMoves();
@@ -584,31 +582,29 @@ void AMM_GridManager::CleanupProcessedMouse(AMM_Mouse* Mouse)
 {
 	if (Mouse)
 	{
-		MiceToProcessMovement.Remove(Mouse);
 		Mouse->MovementEndDelegate.RemoveDynamic(this, &AMM_GridManager::HandleCompletedMouseMovement);
 	}
 }
 
-bool AMM_GridManager::CheckMouse(AMM_Mouse* Mouse)
+void AMM_GridManager::FinishTurnRecord()
 {
-	// Check if mouse valid
-	if (Mouse)
+	// Resolution excludes waiting on the visuals, leaving the time spent resolving the mice
+	if (ColumnLockInTime > 0.0)
 	{
-		return true;
+		const double TurnDuration = FPlatformTime::Seconds() - ColumnLockInTime;
+		CurrentTurnRecord.ResolutionTime = FMath::Max(TurnDuration - MousePlayoutTime, 0.0);
 	}
+	CurrentTurnRecord.VisualPlayoutTime += MousePlayoutTime;
 
-	UE_LOG(MiceMenEventLog, Error, TEXT("AMM_GridManager::CheckMouse | Mouse not valid for processing!"));
+	LastTurnRecord = CurrentTurnRecord;
 
-	// Remove null ptr from array
-	if (MiceToProcessMovement.IsValidIndex(0) && MiceToProcessMovement[0] == Mouse)
-	{
-		MiceToProcessMovement.RemoveAt(0);
-	}
-
-	// Mouse not valid, go on to next mouse
-	HandleCompletedMouseMovement(Mouse);
-
-	return false;
+	// Reset for the next turn
+	CurrentTurnRecord = FMM_TurnRecord();
+	ColumnLockInTime = 0.0;
+	MousePlayoutTime = 0.0;
+	TRACE_COUNTER_SET(MiceMen_CascadePasses, 0);
+	TRACE_COUNTER_SET(MiceMen_MiceProcessed, 0);
+	TRACE_COUNTER_SET(MiceMen_PathsComputed, 0);
 }
 
 void AMM_GridManager::RemoveMouse(AMM_Mouse* Mouse)
@@ -700,22 +696,134 @@ bool AMM_GridManager::AdjustColumnInGridObject(int Column, EDirection Direction,
 	return true;
 }
 
-void AMM_GridManager::AdjustColumn(int Column, EDirection Direction)
+bool AMM_GridManager::FindBestColumnMove(ETeam Team, TArrayView<const int> CandidateColumns, int& OutColumn, EDirection& OutDirection) const
+{
+	MM_TRACE_SCOPE("AMM_GridManager::FindBestColumnMove");
+	LLM_SCOPE_BYTAG(MiceMen_AI);
+
+	const TArray<AMM_Mouse*>* TeamMice = MiceTeams.Find(Team);
+	if (!TeamMice)
+	{
+		return false;
+	}
+
+	// The default board size and the larger common size are scored on boards specialized for their size
+	if (GridSize == FIntVector2D(19, 13))
+	{
+		return FindBestColumnMoveOnFixedBoard<19, 13>(Team, CandidateColumns, OutColumn, OutDirection);
+	}
+	if (GridSize == FIntVector2D(64, 32))
+	{
+		return FindBestColumnMoveOnFixedBoard<64, 32>(Team, CandidateColumns, OutColumn, OutDirection);
+	}
+
+	int HighestScore = 0;
+	OutColumn = -1;
+
+	// Having up first means the default state when no optimal moves exist will be to move the column upwards
+	OutDirection = EDirection::E_UP;
+
+	for (const int ColumnIndex : CandidateColumns)
+	{
+		static constexpr EDirection Directions[] = {EDirection::E_UP, EDirection::E_DOWN};
+		for (const EDirection Direction : Directions)
+		{
+			int CurrentScore = 0;
+
+			// Find direction to move back column
+			EDirection OppositeDirection = EDirection::E_UP;
+			if (Direction == EDirection::E_UP)
+			{
+				OppositeDirection = EDirection::E_DOWN;
+			}
+
+			// Move column to test for score
+			INC_DWORD_STAT(STAT_MiceMen_AIColumnTests);
+			AMM_GridElement* LastGridElement;
+			if (!AdjustColumnInGridObject(ColumnIndex, Direction, LastGridElement))
+			{
+				continue;
+			}
+
+			// Find out score ie amount of movement for all mice, only the amount of movement is needed so paths aren't stored
+			ComputeTeamPaths(Team, AIPathBatchScratch);
+			CurrentScore = AIPathBatchScratch.GetTotalStepCount();
+
+			// Return the column back
+			AdjustColumnInGridObject(ColumnIndex, OppositeDirection, LastGridElement);
+
+			// Compare score
+			if (CurrentScore > HighestScore)
+			{
+				HighestScore = CurrentScore;
+				OutColumn = ColumnIndex;
+				OutDirection = Direction;
+			}
+		}
+	}
+
+	return OutColumn >= 0;
+}
+
+template <int32 Width, int32 Height>
+bool AMM_GridManager::FindBestColumnMoveOnFixedBoard(ETeam Team, TArrayView<const int> CandidateColumns, int& OutColumn, EDirection& OutDirection) const
+{
+	// Board is small enough to live on the stack, so scoring allocates nothing
+	TMM_FixedBoard<Width, Height> Board;
+	BuildFixedBoard(Board);
+
+	INC_DWORD_STAT_BY(STAT_MiceMen_AIColumnTests, CandidateColumns.Num() * 2);
+
+	bool bUp;
+	const bool bFoundMove = Board.FindBestColumnMove(static_cast<ERulesTeam>(Team), CandidateColumns, OutColumn, bUp);
+	OutDirection = bUp ? EDirection::E_UP : EDirection::E_DOWN;
+	return bFoundMove;
+}
+
+void AMM_GridManager::ComputeTeamPaths(ETeam Team, FMM_PathBatch& OutBatch, bool bStorePaths /*= false*/) const
+{
+	OutBatch.Reset();
+
+	const TArray<AMM_Mouse*>* TeamMice = MiceTeams.Find(Team);
+	if (!TeamMice || !GridObject)
+	{
+		return;
+	}
+
+	OutBatch.Reserve(TeamMice->Num());
+	for (const AMM_Mouse* Mouse : *TeamMice)
+	{
+		OutBatch.AddWalker(Mouse->GetCoordinates());
+	}
+
+	GridObject->WalkPathBatch(OutBatch, GetDirectionFromTeam(Team), bStorePaths);
+}
+
+bool AMM_GridManager::AdjustColumn(int Column, EDirection Direction)
 {
 	AMM_GridElement* LastElement;
 	const bool bSuccessfulColumnMovement = AdjustColumnInGridObject(Column, Direction, LastElement);
 	if (!bSuccessfulColumnMovement)
 	{
-		return;
+		return false;
 	}
 
 	LastMovedColumn = Column;
 
+	// Turn stats begin from the column locking in, with the time it took to settle
+	CurrentTurnRecord.Column = Column;
+	CurrentTurnRecord.Direction = Direction;
+	ColumnLockInTime = FPlatformTime::Seconds();
+	if (const AMM_ColumnControl* ColumnControl = GetColumnControl(Column))
+	{
+		CurrentTurnRecord.VisualPlayoutTime += ColumnControl->GetLastSettleTime();
+	}
+
 	// Move Last element to correct position in world position
 	if (LastElement)
 	{
 		const FIntVector2D CurrentSlot = LastElement->GetCoordinates();
-		FVector NewLocation = CoordToWorldTransform(CurrentSlot).GetLocation();
+		FVector NewLocation = CoordinateMapper.CoordToWorld(CurrentSlot);
 		// Check column control exists
 		if (ColumnControls.Contains(Column))
 		{
@@ -725,8 +833,36 @@ void AMM_GridManager::AdjustColumn(int Column, EDirection Direction)
 
 		LastElement->SetActorLocation(NewLocation);
 
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::AdjustColumn | Moving last element %s to %s"), *LastElement->GetName(), *CurrentSlot.ToString());
+		MM_EVENT(EGridEvent::E_COLUMN_WRAPPED, CurrentSlot, LastElement);
+	}
+
+	// Lay out the block visuals for the moved column, as blocks have no element to move
+	if (GridVisualsComponent)
+	{
+		GridVisualsComponent->RefreshColumn(Column);
+	}
+
+	return true;
+}
+
+bool AMM_GridManager::IsColumnVisible(int Column) const
+{
+	// Not virtualized, everything is visualized
+	if (!GridVisualsComponent || !GridVisualsComponent->IsVirtualized())
+	{
+		return true;
+	}
+	return GridVisualsComponent->IsColumnVisible(Column);
+}
+
+bool AMM_GridManager::IsColumnRangeVisible(int FirstColumn, int LastColumn) const
+{
+	// Not virtualized, everything is visualized
+	if (!GridVisualsComponent || !GridVisualsComponent->IsVirtualized())
+	{
+		return true;
 	}
+	return GridVisualsComponent->IsColumnRangeVisible(FirstColumn, LastColumn);
 }
 
 bool AMM_GridManager::FindFreeSlotInDirection(FIntVector2D& CurrentPosition, const FIntVector2D& Direction) const
@@ -757,6 +893,13 @@ bool AMM_GridManager::IsTeamInColumn(int Column, ETeam Team) const
 TArray<int> AMM_GridManager::GetTeamColumns(ETeam Team) const
 {
 	TArray<int> AvailableColumns;
+	CollectTeamColumns(Team, AvailableColumns);
+	return AvailableColumns;
+}
+
+void AMM_GridManager::CollectTeamColumns(ETeam Team, TArray<int>& AvailableColumns) const
+{
+	AvailableColumns.Reset();
 
 	int FailsafeColumn = -1;
 
@@ -785,144 +928,352 @@ TArray<int> AMM_GridManager::GetTeamColumns(ETeam Team) const
 		// Use failsafe column
 		AvailableColumns.Add(FailsafeColumn);
 	}
-
-	return AvailableColumns;
 }
 
 bool AMM_GridManager::IsStalemate() const
 {
-	// Check each team for their mice count
-	for (const auto& TeamMice : MiceTeams)
-	{
-		// If any team doesn't have one mice, its not a "stalemate"
-		if (TeamMice.Value.Num() != 1)
-		{
-			return false;
-		}
-	}
-
-	return true;
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+	return Board.IsStalemate();
 }
 
 ETeam AMM_GridManager::GetWinningStalemateTeam(int& DistanceWonBy) const
 {
-	TMap<ETeam, int> TeamDistances;
-	TArray<ETeam> MiceTeamsArray;
-	MiceTeams.GenerateKeyArray(MiceTeamsArray);
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+	return static_cast<ETeam>(Board.GetWinningStalemateTeam(DistanceWonBy));
+}
 
-	// Initalise distances for each team
-	for (ETeam iTeam = ETeam::E_TEAM_A; iTeam < ETeam::E_MAX; ++iTeam)
+bool AMM_GridManager::CheckNoValidMoves()
+{
+	if (!GridObject)
 	{
-		TeamDistances.Add(iTeam, 0);
+		return false;
 	}
 
-	// Store distance for each team
-	for (const auto& TeamMice : MiceTeams)
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+	return Board.HasNoValidMoves();
+}
+
+// ################################ Rules Board ################################
+
+void AMM_GridManager::BuildRulesBoard(FMM_RulesBoard& OutBoard, int MicePerTeam /*= 0*/) const
+{
+	// Completed mice are only kept as a score without a game mode
+	int CompletedCounts[2] = {0, 0};
+	for (const AMM_Mouse* CompletedMouse : CompletedMice)
 	{
-		const ETeam CurrentTeam = TeamMice.Key;
-		const TArray<AMM_Mouse*> CurrentMice = TeamMice.Value;
-		if (CurrentMice.IsValidIndex(0))
+		if (CompletedMouse && (CompletedMouse->GetTeam() == ETeam::E_TEAM_A || CompletedMouse->GetTeam() == ETeam::E_TEAM_B))
 		{
-			const AMM_Mouse* RemainingMouse = CurrentMice[0];
+			CompletedCounts[CompletedMouse->GetTeam() == ETeam::E_TEAM_A ? 0 : 1]++;
+		}
+	}
 
-			const int GridMultiply = CurrentTeam == ETeam::E_TEAM_A ? 0 : 1;
-			// Get the distance from the team starting point
-			const int Distance = FMath::Abs(((GridSize.X - 1) * GridMultiply) - RemainingMouse->GetCoordinates().X);
+	const int TeamAScore = MMGameMode ? MMGameMode->GetTeamScore(ETeam::E_TEAM_A) : CompletedCounts[0];
+	const int TeamBScore = MMGameMode ? MMGameMode->GetTeamScore(ETeam::E_TEAM_B) : CompletedCounts[1];
 
-			TeamDistances[CurrentTeam] = Distance;
-		}
+	// Without a game mode or given count, a team wins on completing all the mice it has had
+	int WinningMiceCount = MicePerTeam;
+	if (MMGameMode)
+	{
+		WinningMiceCount = MMGameMode->InitialMiceCount;
+	}
+	else if (WinningMiceCount <= 0)
+	{
+		const TArray<AMM_Mouse*>* TeamAMice = MiceTeams.Find(ETeam::E_TEAM_A);
+		const TArray<AMM_Mouse*>* TeamBMice = MiceTeams.Find(ETeam::E_TEAM_B);
+		WinningMiceCount = FMath::Max((TeamAMice ? TeamAMice->Num() : 0) + TeamAScore, (TeamBMice ? TeamBMice->Num() : 0) + TeamBScore);
 	}
 
-	// Check both team distances were stored
-	if (TeamDistances.Num() >= 2)
+	OutBoard.Setup(GridSize.X, GridSize.Y, WinningMiceCount, MMGameMode ? MMGameMode->StalemateTurns : 8);
+	OutBoard.SetGameState(TeamAScore, TeamBScore, LastMovedColumn, MMGameMode ? MMGameMode->GetStalemateCount() : -1);
+
+	if (!GridObject)
+	{
+		return;
+	}
+
+	// Blocks from the logical board, mice are added from the teams so they keep their order
+	for (int x = 0; x < GridSize.X; x++)
 	{
-		// Check if same distance, tie situation
-		if (TeamDistances[ETeam::E_TEAM_A] == TeamDistances[ETeam::E_TEAM_B])
+		for (int y = 0; y < GridSize.Y; y++)
 		{
-			DistanceWonBy = 0;
-			// E_NONE meaning tie, ie no winner
-			return ETeam::E_NONE;
+			if (GridObject->GetSlotType({x, y}) == EGridSlotType::E_BLOCK)
+			{
+				OutBoard.AddBlock(FIntPoint(x, y));
+			}
 		}
+	}
 
-		// Check winning team based on further distance
-		ETeam WinningTeam = ETeam::E_NONE;
-		if (TeamDistances[ETeam::E_TEAM_A] > TeamDistances[ETeam::E_TEAM_B])
+	for (ETeam Team = ETeam::E_TEAM_A; Team < ETeam::E_MAX; ++Team)
+	{
+		const TArray<AMM_Mouse*>* TeamMice = MiceTeams.Find(Team);
+		if (!TeamMice)
 		{
-			DistanceWonBy = TeamDistances[ETeam::E_TEAM_A] - TeamDistances[ETeam::E_TEAM_B];
-			WinningTeam = ETeam::E_TEAM_A;
+			continue;
 		}
-		else
+
+		for (const AMM_Mouse* Mouse : *TeamMice)
 		{
-			DistanceWonBy = TeamDistances[ETeam::E_TEAM_B] - TeamDistances[ETeam::E_TEAM_A];
-			WinningTeam = ETeam::E_TEAM_B;
+			const FIntVector2D MouseCoord = Mouse->GetCoordinates();
+			OutBoard.AddMouse(FIntPoint(MouseCoord.X, MouseCoord.Y), static_cast<ERulesTeam>(Team));
 		}
-		return WinningTeam;
 	}
+}
+
+void AMM_GridManager::CollectRulesBoardMice(const FMM_RulesBoard& Board, TArray<AMM_Mouse*>& OutBoardMice) const
+{
+	OutBoardMice.Reset(Board.GetMice().Num());
+	for (const FMM_RulesMouse& RulesMouse : Board.GetMice())
+	{
+		OutBoardMice.Add(GridObject ? Cast<AMM_Mouse>(GridObject->GetGridElement(FIntVector2D(RulesMouse.Coord.X, RulesMouse.Coord.Y))) : nullptr);
+	}
+}
+
+EPuzzleResult AMM_GridManager::SolvePuzzle(ETeam Team, int MaxMoves, TArray<FMM_SearchMove>& OutMoves) const
+{
+	MM_TRACE_SCOPE("AMM_GridManager::SolvePuzzle");
+	OutMoves.Reset();
 
-	UE_LOG(MiceMenEventLog, Error, TEXT("AMM_GridManager::GetWinningStalemateTeam | Failed to get winning stalemate team, returned E_MAX!"));
+	// Every move of a board is played in a lane of its own, so only boards specialized for their size are solved
+	if (GridSize != FIntVector2D(19, 13))
+	{
+		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GridManager::SolvePuzzle | No puzzle solver for grid size %s"), *GridSize.ToString());
+		return EPuzzleResult::E_NONE;
+	}
 
-	return ETeam::E_MAX;
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+
+	FMM_PuzzleSettings Settings;
+	Settings.MaxMoves = MaxMoves;
+
+	FMM_StandardPuzzleSolver Solver;
+	const EPuzzleResult Result = Solver.Solve(Board, static_cast<ERulesTeam>(Team), Settings, OutMoves);
+	UE_LOG(MiceMenEventLog, Log, TEXT("AMM_GridManager::SolvePuzzle | Result %i with %i moves after %lld boards"), static_cast<int>(Result), OutMoves.Num(), Solver.GetBoardCount());
+	return Result;
 }
 
-bool AMM_GridManager::CheckNoValidMoves()
+template <int32 Width, int32 Height>
+void AMM_GridManager::BuildFixedBoard(TMM_FixedBoard<Width, Height>& OutBoard) const
 {
-	ETeam CurrentTeam = ETeam::E_NONE;
-	// NOTE: Assumes columns were added in correct order from left to right
-	for (const TPair<int, AMM_ColumnControl*>& Column : ColumnControls)
+	OutBoard.Reset();
+
+	// Check the grid matches the board size
+	if (!GridObject || GridSize != FIntVector2D(Width, Height))
 	{
-		// Check all elements in column
-		bool bCurrentColumnFull = true;
-		const int x = Column.Key;
-		for (int y = 0; y < GridSize.Y; y++)
+		UE_LOG(MiceMenEventLog, Error, TEXT("AMM_GridManager::BuildFixedBoard | Grid size %s does not match the board size %ix%i"), *GridSize.ToString(), Width, Height);
+		return;
+	}
+
+	for (int x = 0; x < Width; x++)
+	{
+		for (int y = 0; y < Height; y++)
 		{
-			const AMM_GridElement* CurrentGridElement = GridObject->GetGridElement({x, y});
-			if (!CurrentGridElement)
+			if (GridObject->GetSlotType({x, y}) == EGridSlotType::E_BLOCK)
 			{
-				// Found empty slot, reset
-				bCurrentColumnFull = false;
-				CurrentTeam = ETeam::E_NONE;
-				break;
+				OutBoard.SetBlock(x, y);
 			}
 		}
-		// Column was not full, go to next
-		if (!bCurrentColumnFull)
+	}
+
+	for (ETeam Team = ETeam::E_TEAM_A; Team < ETeam::E_MAX; ++Team)
+	{
+		const TArray<AMM_Mouse*>* TeamMice = MiceTeams.Find(Team);
+		if (!TeamMice)
 		{
 			continue;
 		}
 
-		// Check for next team
-		ETeam NextTeam = CurrentTeam;
-		++NextTeam;
-		bool bSuccessColumn = true;
-		for (const AMM_Mouse* CurrentMouse : MiceColumns[x])
+		for (const AMM_Mouse* Mouse : *TeamMice)
 		{
-			if (!CurrentMouse)
-			{
-				continue;
-			}
-			// Check all mice are the team being looked for
-			if (CurrentMouse->GetTeam() != NextTeam)
-			{
-				// One mouse was not the next team
-				bSuccessColumn = false;
-				break;
-			}
+			const FIntVector2D MouseCoord = Mouse->GetCoordinates();
+			OutBoard.SetMouse(MouseCoord.X, MouseCoord.Y, static_cast<ERulesTeam>(Team));
+		}
+	}
+}
+
+// Sizes with boards specialized at compile time, any other size uses the grid object
+template void AMM_GridManager::BuildFixedBoard<19, 13>(TMM_FixedBoard<19, 13>& OutBoard) const;
+template void AMM_GridManager::BuildFixedBoard<64, 32>(TMM_FixedBoard<64, 32>& OutBoard) const;
+
+// ################################ Cascade Preview ################################
+
+bool AMM_GridManager::SimulateColumnMove(int Column, EDirection Direction, ETeam Team, FMM_CascadePreview& OutPreview) const
+{
+	MM_TRACE_SCOPE("AMM_GridManager::SimulateColumnMove");
+	OutPreview = FMM_CascadePreview();
+
+	// Only columns in the grid move, and only up or down
+	if (!GridObject || Column < 0 || Column >= GridSize.X || (Direction != EDirection::E_UP && Direction != EDirection::E_DOWN))
+	{
+		return false;
+	}
+
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+
+	TArray<AMM_Mouse*> BoardMice;
+	CollectRulesBoardMice(Board, BoardMice);
+
+	FMM_RulesCascadeLog CascadeLog;
+	const FMM_RulesTurnResult Result = Board.PlayTurn(static_cast<ERulesTeam>(Team), Column, Direction == EDirection::E_UP, &CascadeLog);
+
+	OutPreview.Column = Column;
+	OutPreview.Direction = Direction;
+	OutPreview.Team = Team;
+	FillCascadePreview(Board, BoardMice, CascadeLog, Result, OutPreview);
+	return true;
+}
+
+void AMM_GridManager::SimulateCascade(ETeam FirstTeam, FMM_CascadePreview& OutPreview) const
+{
+	MM_TRACE_SCOPE("AMM_GridManager::SimulateCascade");
+	OutPreview = FMM_CascadePreview();
+
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+
+	TArray<AMM_Mouse*> BoardMice;
+	CollectRulesBoardMice(Board, BoardMice);
+
+	FMM_RulesCascadeLog CascadeLog;
+	const FMM_RulesTurnResult Result = Board.ResolveCascade(static_cast<ERulesTeam>(FirstTeam), &CascadeLog);
+
+	OutPreview.Team = FirstTeam;
+	FillCascadePreview(Board, BoardMice, CascadeLog, Result, OutPreview);
+}
+
+void AMM_GridManager::FillCascadePreview(const FMM_RulesBoard& Board, TArrayView<AMM_Mouse* const> BoardMice, const FMM_RulesCascadeLog& CascadeLog,
+                                         const FMM_RulesTurnResult& Result, FMM_CascadePreview& OutPreview)
+{
+	OutPreview.CascadePasses = Result.CascadePasses;
+	OutPreview.bEndsGame = Result.Outcome != ERulesOutcome::E_IN_PROGRESS;
+	OutPreview.Winner = static_cast<ETeam>(Result.Winner);
+	OutPreview.Moves.Reserve(CascadeLog.Moves.Num());
+	for (int i = 0; i < CascadeLog.Moves.Num(); i++)
+	{
+		const FMM_RulesCascadeLog::FMove& LogMove = CascadeLog.Moves[i];
+		FMM_PreviewMouseMove& Move = OutPreview.Moves.AddDefaulted_GetRef();
+		Move.Mouse = BoardMice[LogMove.MouseIndex];
+		Move.bScores = LogMove.bScored;
+		Move.Path.Reserve(LogMove.PathNum);
+		for (const FIntPoint& PathCoord : CascadeLog.GetPath(i))
+		{
+			Move.Path.Add(FIntVector2D(PathCoord.X, PathCoord.Y));
 		}
 
-		// All mice were the next team, advance
-		if (bSuccessColumn)
+		// Count the goals for each team
+		if (LogMove.bScored)
 		{
-			// Store next team as current as it was successful
-			CurrentTeam = NextTeam;
+			(Board.GetMice()[LogMove.MouseIndex].Team == ERulesTeam::E_TEAM_A ? OutPreview.TeamAGoals : OutPreview.TeamBGoals)++;
+		}
+	}
+}
 
-			// Found full column of Team B after full team A
-			if (CurrentTeam == ETeam::E_TEAM_B)
-			{
-				return true;
-			}
+void AMM_GridManager::UpdateCascadePreview(int Column, EDirection Direction)
+{
+	// No direction is no move, nothing to preview
+	const AMM_PlayerController* CurrentPlayer = MMGameMode ? MMGameMode->GetCurrentPlayer() : nullptr;
+	if (Direction == EDirection::E_NONE || !CurrentPlayer)
+	{
+		ClearCascadePreview();
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	SimulateColumnMove(Column, Direction, CurrentPlayer->GetCurrentTeam(), CascadePreview);
+	UE_LOG(MiceMenEventLog, Verbose, TEXT("AMM_GridManager::UpdateCascadePreview | Previewed %i mouse moves for column %i in %.3f ms"),
+	       CascadePreview.Moves.Num(), Column, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	BI_OnCascadePreviewUpdated(CascadePreview);
+}
+
+void AMM_GridManager::ClearCascadePreview()
+{
+	// Only tell the visuals when there was a preview to remove, a cascade simulated from the grid is not shown
+	const bool bWasShown = CascadePreview.IsValid();
+	CascadePreview = FMM_CascadePreview();
+	if (bWasShown)
+	{
+		BI_OnCascadePreviewUpdated(CascadePreview);
+	}
+}
+
+bool AMM_GridManager::BeginPreviewedMice(int Column, EDirection Direction)
+{
+	CurrentPlayerProcessing = MMGameMode ? MMGameMode->GetCurrentPlayer() : nullptr;
+
+	// Check the preview is for this move, test games check every mouse is on the board so always simulate from the grid
+	if (!CurrentPlayerProcessing || !CascadePreview.IsForMove(Column, Direction, CurrentPlayerProcessing->GetCurrentTeam())
+		|| MMGameMode->GetCurrentGameType() == EGameType::E_TEST)
+	{
+		ClearCascadePreview();
+		return false;
+	}
+
+	MM_TRACE_SCOPE("AMM_GridManager::BeginPreviewedMice");
+
+	// The preview already includes every pass, up to the final pass without movement
+	CurrentTurnRecord.CascadePasses = CascadePreview.CascadePasses;
+	TRACE_COUNTER_SET(MiceMen_CascadePasses, CurrentTurnRecord.CascadePasses);
+	MM_EVENT(EGridEvent::E_TEAM_PROCESSING, FIntVector2D(INDEX_NONE, INDEX_NONE), nullptr, static_cast<int32>(CurrentPlayerProcessing->GetCurrentTeam()));
+
+	NextPreviewMove = 0;
+	PlayNextPreviewMove();
+	return true;
+}
+
+void AMM_GridManager::PlayNextPreviewMove()
+{
+	// All movements played, the turn is complete
+	if (!CascadePreview.Moves.IsValidIndex(NextPreviewMove))
+	{
+		NextPreviewMove = INDEX_NONE;
+		ClearCascadePreview();
+		HandleMiceComplete();
+		return;
+	}
+
+	AMM_Mouse* Mouse = CascadePreview.Moves[NextPreviewMove].Mouse;
+	const TArray<FIntVector2D>& Path = CascadePreview.Moves[NextPreviewMove].Path;
+	NextPreviewMove++;
+
+	// Set up delegate for when movement is complete, before the movement as visuals can complete straight away
+	const bool bMouseValid = Mouse && !Mouse->HasReachedEnd();
+	if (bMouseValid)
+	{
+		Mouse->MovementEndDelegate.AddDynamic(this, &AMM_GridManager::HandleCompletedMouseMovement);
+	}
+
+	if (!bMouseValid || !Mouse->PerformMovementAlongPath(Path))
+	{
+		CleanupProcessedMouse(Mouse);
+
+		// A cascade simulated from the grid as it is can't be simulated again, so skip the movement
+		if (!CascadePreview.IsValid())
+		{
+			UE_LOG(MiceMenEventLog, Error, TEXT("AMM_GridManager::PlayNextPreviewMove | Unable to apply movement %i from the rules board"), NextPreviewMove - 1);
+			PlayNextPreviewMove();
+			return;
 		}
+
+		// The grid changed since the preview, so resolve the rest of the cascade from the grid as it is
+		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GridManager::PlayNextPreviewMove | Preview no longer matches the grid at move %i, processing the mice instead"), NextPreviewMove - 1);
+		NextPreviewMove = INDEX_NONE;
+		ClearCascadePreview();
+		BeginProcessMice();
+		return;
+	}
+	TRACE_COUNTER_INCREMENT(MiceMen_MiceProcessed);
+	CurrentTurnRecord.MiceMoved++;
+
+	// If the mouse skipped its visuals go straight to movement complete, as move delegate is not fired on mouse
+	if (Mouse->HasMovedInstantly())
+	{
+		HandleCompletedMouseMovement(Mouse);
 	}
-	return false;
 }
 
 // ################################ Grid Debugging ################################
@@ -930,6 +1281,21 @@ bool AMM_GridManager::CheckNoValidMoves()
 void AMM_GridManager::SetDebugVisualGrid(bool bEnabled)
 {
 	bDisplayDebugGrid = bEnabled;
+
+	if (!DebugGridComponent)
+	{
+		return;
+	}
+
+	// Grid is built once when shown, and updated by the component as slots change
+	if (bDisplayDebugGrid)
+	{
+		DebugGridComponent->ShowGrid(this, GridObject);
+	}
+	else
+	{
+		DebugGridComponent->HideGrid();
+	}
 }
 
 void AMM_GridManager::ToggleDebugVisualGrid()
@@ -939,12 +1305,18 @@ void AMM_GridManager::ToggleDebugVisualGrid()
 
 bool AMM_GridManager::DebugCheckAllMiceProcessed() const
 {
+	FMM_RulesBoard Board;
+	BuildRulesBoard(Board);
+
+	TArray<AMM_Mouse*> BoardMice;
+	CollectRulesBoardMice(Board, BoardMice);
+
 	for (ETeam CurrentTeam = ETeam::E_TEAM_A; CurrentTeam < ETeam::E_MAX; ++CurrentTeam)
 	{
-		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::DebugCheckAllMiceProcessed | Checking ordered mice team %i"), CurrentTeam);
+		UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GridManager::DebugCheckAllMiceProcessed | Checking board mice team %i"), CurrentTeam);
 		for (const AMM_Mouse* Mouse : MiceTeams[CurrentTeam])
 		{
-			if (Mouse && !MiceToProcessMovement.Contains(Mouse))
+			if (Mouse && !BoardMice.Contains(Mouse))
 			{
 				UE_LOG(MiceMenEventLog, Error, TEXT("AMM_GridManager::DebugCheckAllMiceProcessed | MISSING Mouse at position %s"), *Mouse->GetCoordinates().ToString());
 				return false;
@@ -954,36 +1326,10 @@ bool AMM_GridManager::DebugCheckAllMiceProcessed() const
 	return true;
 }
 
-void AMM_GridManager::DisplayDebugGrid() const
+void AMM_GridManager::DrawDebugPath(const TArray<FIntVector2D>& Path) const
 {
-	// DEBUG FOR GRID VALUES
-	// For each column
-	for (int x = 0; x < GridSize.X; x++)
+	if (DebugGridComponent)
 	{
-		// For each row, add to column array
-		for (int y = 0; y < GridSize.Y; y++)
-		{
-			const AMM_GridElement* gridElement = GridObject->GetGridElement({x, y});
-			FLinearColor Color = FLinearColor::White;
-			if (gridElement)
-			{
-				// Display yellow for block
-				Color = FLinearColor::Yellow;
-
-				// Display green for mice
-				if (gridElement->IsA(AMM_Mouse::StaticClass()))
-				{
-					Color = FLinearColor::Green;
-				}
-			}
-			UKismetSystemLibrary::DrawDebugSphere(
-				GetWorld(),
-				CoordToWorldTransform({x, y}).GetLocation() + FVector(-100, 0, 50),
-				25.0f,
-				6,
-				Color,
-				0.5,
-				3);
-		}
+		DebugGridComponent->DrawPath(Path);
 	}
 }
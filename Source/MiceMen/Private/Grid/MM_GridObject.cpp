@@ -3,12 +3,27 @@
 #include "Grid/MM_GridObject.h"
 
 #include "Grid/MM_GridElement.h"
+#include "Base/MM_EventLog.h"
 #include "MiceMen.h"
 
 void UMM_GridObject::SetupGrid(const FIntVector2D& _GridSize)
 {
+	LLM_SCOPE_BYTAG(MiceMen_Grid);
+
 	GridSize = _GridSize;
 	Grid.SetNumZeroed(GridSize.X * GridSize.Y);
+	SlotTypes.Init(EGridSlotType::E_EMPTY, GridSize.X * GridSize.Y);
+
+	// All slots start free
+	FreeSlots.Setup(GridSize);
+
+	// Empty columns fall all the way to the bottom
+	LandingRows.Init(0, GridSize.X * GridSize.Y);
+
+	PathCache.Setup(GridSize);
+
+	// Free slots are indexed for the whole grid, so the size only changes when the grid is set up
+	SET_MEMORY_STAT(STAT_MiceMen_GridObjectMemory, GetAllocatedSize());
 }
 
 void UMM_GridObject::CleanUp()
@@ -22,8 +37,18 @@ void UMM_GridObject::CleanUp()
 		}
 	}
 	Grid.Empty();
+	SlotTypes.Empty();
 
 	FreeSlots.Empty();
+	LandingRows.Empty();
+	PathCache.Empty();
+
+	SET_MEMORY_STAT(STAT_MiceMen_GridObjectMemory, GetAllocatedSize());
+}
+
+SIZE_T UMM_GridObject::GetAllocatedSize() const
+{
+	return Grid.GetAllocatedSize() + SlotTypes.GetAllocatedSize() + FreeSlots.GetAllocatedSize() + LandingRows.GetAllocatedSize() + PathCache.GetAllocatedSize();
 }
 
 // ################################ Grid Management ################################
@@ -72,17 +97,6 @@ bool UMM_GridObject::SetGridElement(const FIntVector2D& Coord, AMM_GridElement*
 		return false;
 	}
 
-#if !UE_BUILD_SHIPPING
-	FString ElementDisplay = "none";
-	if (GridElement)
-	{
-		ElementDisplay = GridElement->GetName();
-	}
-	UE_LOG(MiceMenEventLog, Display, TEXT("UMM_GridObject::SetGridElement | %s to %s"), *Coord.ToString(), *ElementDisplay);
-#endif
-
-	Grid[CoordToIndex(Coord.X, Coord.Y)] = GridElement;
-
 	// Update grid element if valid/not empty
 	if (GridElement)
 	{
@@ -91,22 +105,68 @@ bool UMM_GridObject::SetGridElement(const FIntVector2D& Coord, AMM_GridElement*
 		{
 			GridElement->UpdateGridPosition(Coord);
 		}
+	}
+
+	SetSlot(Coord, GridElement, GridElement ? GridElement->GetSlotType() : EGridSlotType::E_EMPTY);
+
+	return true;
+}
+
+bool UMM_GridObject::SetGridBlock(const FIntVector2D& Coord, bool bBlocked)
+{
+	if (!IsValidCoord(Coord))
+	{
+		UE_LOG(MiceMenEventLog, Warning, TEXT("UMM_GridObject::SetGridBlock | %s not valid coordinate"), *Coord.ToString());
+		return false;
+	}
+
+	SetSlot(Coord, nullptr, bBlocked ? EGridSlotType::E_BLOCK : EGridSlotType::E_EMPTY);
+
+	return true;
+}
+
+void UMM_GridObject::SetSlot(const FIntVector2D& Coord, AMM_GridElement* GridElement, EGridSlotType SlotType)
+{
+	LLM_SCOPE_BYTAG(MiceMen_Grid);
+
+	const int Index = CoordToIndex(Coord.X, Coord.Y);
+	const bool bWasEmpty = SlotTypes[Index] == EGridSlotType::E_EMPTY;
+	Grid[Index] = GridElement;
+	SlotTypes[Index] = SlotType;
+
+	// Only a change between empty and taken affects falling and walks
+	if (bWasEmpty != (SlotType == EGridSlotType::E_EMPTY))
+	{
+		UpdateLandingRowsAbove(Coord);
+		PathCache.ToggleSlot(Coord);
+	}
 
-		// Update Free slots to no longer have this element
-		FreeSlots.Remove(Coord);
+	if (SlotType != EGridSlotType::E_EMPTY)
+	{
+		// Update Free slots to no longer have this slot
+		FreeSlots.SetFree(Coord, false);
 
-		UE_LOG(MiceMenEventLog, Display, TEXT("UMM_GridObject::SetGridElement | Free slot removed at %s"), *Coord.ToString());
+		MM_EVENT(EGridEvent::E_SLOT_TAKEN, Coord, GridElement, static_cast<int32>(SlotType));
 	}
 	else
 	{
-		// No element (nullptr), add these coordinates to free slots
-		// Note: Add unique is more expensive (but safe), could be improved
-		FreeSlots.AddUnique(Coord);
+		// Nothing in the slot, add these coordinates to free slots
+		FreeSlots.SetFree(Coord, true);
 
-		UE_LOG(MiceMenEventLog, Display, TEXT("UMM_GridObject::SetGridElement | Free slot added at %s"), *Coord.ToString());
+		MM_EVENT(EGridEvent::E_SLOT_FREED, Coord);
 	}
 
-	return true;
+	OnSlotChanged.Broadcast(Coord);
+}
+
+EGridSlotType UMM_GridObject::GetSlotType(const FIntVector2D& Coord) const
+{
+	if (!IsValidCoord(Coord))
+	{
+		return EGridSlotType::E_EMPTY;
+	}
+
+	return SlotTypes[CoordToIndex(Coord.X, Coord.Y)];
 }
 
 bool UMM_GridObject::MoveGridElement(const FIntVector2D& NewCoord, AMM_GridElement* GridElement)
@@ -131,19 +191,39 @@ bool UMM_GridObject::MoveGridElement(const FIntVector2D& NewCoord, AMM_GridEleme
 		return false;
 	}
 
-	UE_LOG(MiceMenEventLog, Display, TEXT("UMM_GridObject::MoveGridElement | Moving %s to %s"), *GridElement->GetName(), *NewCoord.ToString());
+	MM_EVENT(EGridEvent::E_ELEMENT_MOVED, NewCoord, GridElement);
+	LLM_SCOPE_BYTAG(MiceMen_Grid);
 
-	Grid[CoordToIndex(OriginalCoordinate.X, OriginalCoordinate.Y)] = nullptr;
-	Grid[CoordToIndex(NewCoord.X, NewCoord.Y)] = GridElement;
+	const int OriginalIndex = CoordToIndex(OriginalCoordinate.X, OriginalCoordinate.Y);
+	const int NewIndex = CoordToIndex(NewCoord.X, NewCoord.Y);
+
+	// Walks only change if the slots change between empty and taken
+	if (SlotTypes[OriginalIndex] != EGridSlotType::E_EMPTY)
+	{
+		PathCache.ToggleSlot(OriginalCoordinate);
+	}
+	if (SlotTypes[NewIndex] == EGridSlotType::E_EMPTY && GridElement->GetSlotType() != EGridSlotType::E_EMPTY)
+	{
+		PathCache.ToggleSlot(NewCoord);
+	}
+	Grid[OriginalIndex] = nullptr;
+	Grid[NewIndex] = GridElement;
+	SlotTypes[OriginalIndex] = EGridSlotType::E_EMPTY;
+	SlotTypes[NewIndex] = GridElement->GetSlotType();
 
 	GridElement->UpdateGridPosition(NewCoord);
 
+	UpdateLandingRowsAbove(OriginalCoordinate);
+	UpdateLandingRowsAbove(NewCoord);
+
 	// Update FreeSlots to have the old position as free
-	// Note: Add unique is more expensive (but safe), could be improved
-	FreeSlots.AddUnique(OriginalCoordinate);
+	FreeSlots.SetFree(OriginalCoordinate, true);
 
 	// Remove the new space as free as there is now an element there
-	FreeSlots.Remove(NewCoord);
+	FreeSlots.SetFree(NewCoord, false);
+
+	OnSlotChanged.Broadcast(OriginalCoordinate);
+	OnSlotChanged.Broadcast(NewCoord);
 
 	return true;
 }
@@ -152,9 +232,14 @@ bool UMM_GridObject::MoveGridElement(const FIntVector2D& NewCoord, AMM_GridEleme
 
 AMM_GridElement* UMM_GridObject::MoveColumnElements(int Column, EDirection Direction)
 {
+	MM_TRACE_SCOPE("UMM_GridObject::MoveColumnElements");
+	LLM_SCOPE_BYTAG(MiceMen_Grid);
+	MM_EVENT(EGridEvent::E_COLUMN_MOVED, FIntVector2D(Column, 0), nullptr, static_cast<int32>(Direction));
+
 	// Get initial values
 	const int StartingGridIndex = CoordToIndex(Column, 0);
 	AMM_GridElement* WrappingElement = nullptr;
+	EGridSlotType WrappingSlotType = EGridSlotType::E_EMPTY;
 
 	const int BottomBlockIndex = StartingGridIndex;
 	const int TopBlockIndex = StartingGridIndex + GridSize.Y - 1;
@@ -163,39 +248,78 @@ AMM_GridElement* UMM_GridObject::MoveColumnElements(int Column, EDirection Direc
 	if (Direction == EDirection::E_DOWN)
 	{
 		WrappingElement = Grid[BottomBlockIndex];
+		WrappingSlotType = SlotTypes[BottomBlockIndex];
 		// Remove bottom element
 		Grid.RemoveAt(BottomBlockIndex);
+		SlotTypes.RemoveAt(BottomBlockIndex);
 		// Insert element at the top
 		Grid.Insert(WrappingElement, TopBlockIndex);
+		SlotTypes.Insert(WrappingSlotType, TopBlockIndex);
 	}
 	// Upwards means the top element wrapping
 	else if (Direction == EDirection::E_UP)
 	{
 		WrappingElement = Grid[TopBlockIndex];
+		WrappingSlotType = SlotTypes[TopBlockIndex];
 		// Remove top element
 		Grid.RemoveAt(TopBlockIndex);
+		SlotTypes.RemoveAt(TopBlockIndex);
 		// Insert element at the top
 		Grid.Insert(WrappingElement, BottomBlockIndex);
+		SlotTypes.Insert(WrappingSlotType, BottomBlockIndex);
 	}
 
+	// Slot types are already rotated, so setting each slot below sees no change and the column is rebuilt at once
+	RebuildColumnLandingRows(Column);
+	PathCache.RehashColumn(Column, TArrayView<const EGridSlotType>(SlotTypes.GetData() + StartingGridIndex, GridSize.Y));
+
 	// Update each element with its new position and store new free slots
 	for (int y = 0; y < GridSize.Y; y++)
 	{
 		const FIntVector2D ElementCoord = {Column, y};
-		AMM_GridElement* CurrentElement = GetGridElement(ElementCoord);
+		const int ElementIndex = CoordToIndex(Column, y);
+		AMM_GridElement* CurrentElement = Grid[ElementIndex];
 
-		// Assign element to new coordinate
-		const bool bSetElementSuccess = SetGridElement(ElementCoord, CurrentElement);
-
-		if (!bSetElementSuccess)
+		// Only update if a change in coordinates occurred
+		if (CurrentElement && CurrentElement->GetCoordinates() != ElementCoord)
 		{
-			UE_LOG(MiceMenEventLog, Warning, TEXT("UMM_GridObject::MoveColumnElements | Failed to set element at coord %s"), *ElementCoord.ToString());
+			CurrentElement->UpdateGridPosition(ElementCoord);
 		}
+
+		// Assign slot to new coordinate, keeping blocks without elements
+		SetSlot(ElementCoord, CurrentElement, SlotTypes[ElementIndex]);
 	}
 
 	return WrappingElement;
 }
 
+void UMM_GridObject::UpdateLandingRowsAbove(const FIntVector2D& Coord)
+{
+	// Each row lands where the row below lands if that slot is empty, otherwise it stays,
+	// so only the run of empty slots directly above the change can be affected
+	const int ColumnStart = CoordToIndex(Coord.X, 0);
+	for (int y = Coord.Y + 1; y < GridSize.Y; y++)
+	{
+		LandingRows[ColumnStart + y] = SlotTypes[ColumnStart + y - 1] == EGridSlotType::E_EMPTY ? LandingRows[ColumnStart + y - 1] : y;
+
+		// Rows above a taken slot are unaffected by anything further down
+		if (SlotTypes[ColumnStart + y] != EGridSlotType::E_EMPTY)
+		{
+			break;
+		}
+	}
+}
+
+void UMM_GridObject::RebuildColumnLandingRows(int Column)
+{
+	const int ColumnStart = CoordToIndex(Column, 0);
+	LandingRows[ColumnStart] = 0;
+	for (int y = 1; y < GridSize.Y; y++)
+	{
+		LandingRows[ColumnStart + y] = SlotTypes[ColumnStart + y - 1] == EGridSlotType::E_EMPTY ? LandingRows[ColumnStart + y - 1] : y;
+	}
+}
+
 FIntVector2D UMM_GridObject::GetRandomGridCoord(bool bFreeSlot /*= true*/) const
 {
 	return GetRandomGridCoordInRange(0, GridSize.X, 0, GridSize.Y, bFreeSlot);
@@ -220,31 +344,21 @@ FIntVector2D UMM_GridObject::GetRandomGridCoordInRange(int MinX, int MaxX, int M
 	// If looking for a free slot
 	if (bFreeSlot)
 	{
-		// Try each free slot randomly
-		TArray<FIntVector2D> AvailableFreeSlots = FreeSlots;
-		while (AvailableFreeSlots.Num() > 0)
-		{
-			// Get random free slot
-			const int RandIndex = FMath::RandRange(0, AvailableFreeSlots.Num() - 1);
-			FIntVector2D NewRandCoord = AvailableFreeSlots[RandIndex];
+		// Free slots are counted per column, so the range count and the pick are both logarithmic
+		const int InRangeCount = FreeSlots.CountInRange(ClampedMinX, ClampedMaxX, ClampedMinY, ClampedMaxY);
 
-			// Check within range
-			if (IsCoordInRange(NewRandCoord, ClampedMinX, ClampedMaxX, ClampedMinY, ClampedMaxY))
-			{
-				// If valid, store and break out of while loop
-				RandX = NewRandCoord.X;
-				RandY = NewRandCoord.Y;
-				break;
-			}
-
-			// Remove from list and try again as random coordinates not in range
-			AvailableFreeSlots.RemoveAt(RandIndex);
+		// No valid position was found, indicates problem with grid generation, checked before drawing so a full range never consumes the random stream
+		if (InRangeCount <= 0)
+		{
+			UE_LOG(MiceMenEventLog, Error, TEXT("Failed to find free slot in grid"));
+			return FIntVector2D(RandX, RandY);
 		}
 
-		// No valid position was found, indicates problem with grid generation
-		if (AvailableFreeSlots.Num() <= 0)
+		FIntVector2D FreeSlot;
+		if (FreeSlots.FindInRange(FMath::RandRange(0, InRangeCount - 1), ClampedMinX, ClampedMaxX, ClampedMinY, ClampedMaxY, FreeSlot))
 		{
-			UE_LOG(MiceMenEventLog, Error, TEXT("Failed to find free slot in grid"));
+			RandX = FreeSlot.X;
+			RandY = FreeSlot.Y;
 		}
 	}
 	else
@@ -257,6 +371,13 @@ FIntVector2D UMM_GridObject::GetRandomGridCoordInRange(int MinX, int MaxX, int M
 	return FIntVector2D(RandX, RandY);
 }
 
+TArray<FIntVector2D> UMM_GridObject::GetFreeSlots() const
+{
+	TArray<FIntVector2D> FreeSlotList;
+	FreeSlots.GetFreeSlots(FreeSlotList);
+	return FreeSlotList;
+}
+
 bool UMM_GridObject::IsCoordInRange(const FIntVector2D& Coord, int MinX, int MaxX, int MinY, int MaxY)
 {
 	// Check within X range
@@ -273,8 +394,8 @@ bool UMM_GridObject::FindFreeSlotInDirection(FIntVector2D& CurrentPosition, cons
 	FIntVector2D TestCoords = CurrentPosition;
 	TestCoords += Direction;
 
-	// Checks if there is no free slot
-	if (!FreeSlots.Contains(TestCoords))
+	// Checks if there is no free slot, outside the grid is never free
+	if (!IsCoordInRange(TestCoords, 0, GridSize.X - 1, 0, GridSize.Y - 1) || SlotTypes[CoordToIndex(TestCoords.X, TestCoords.Y)] != EGridSlotType::E_EMPTY)
 	{
 		// CurrentPosition will be unset using the last valid position
 		return false;
@@ -288,28 +409,154 @@ bool UMM_GridObject::FindFreeSlotInDirection(FIntVector2D& CurrentPosition, cons
 
 bool UMM_GridObject::FindFreeSlotBelow(FIntVector2D& CurrentPosition) const
 {
-	bool bFoundFreeSlot = false;
+	// Outside the grid never falls
+	if (!IsCoordInRange(CurrentPosition, 0, GridSize.X - 1, 0, GridSize.Y - 1))
+	{
+		return false;
+	}
 
-	// If not currently on lowest slot
-	while (CurrentPosition.Y > 0)
+	// Check if there is a free slot below, the landing row is the current row if not
+	const int LandingRow = LandingRows[CoordToIndex(CurrentPosition.X, CurrentPosition.Y)];
+	if (LandingRow == CurrentPosition.Y)
 	{
-		// Check if free slot below, will update CurrentPosition 
-		if (FindFreeSlotInDirection(CurrentPosition, FIntVector2D(0, -1)))
+		return false;
+	}
+
+	CurrentPosition.Y = LandingRow;
+
+	return true;
+}
+
+bool UMM_GridObject::FindFreeSlotAhead(FIntVector2D& CurrentPosition, EDirection Direction) const
+{
+	const int HorizontalDirection = Direction == EDirection::E_RIGHT ? 1 : -1;
+	return FindFreeSlotInDirection(CurrentPosition, FIntVector2D(HorizontalDirection, 0));
+}
+
+// ################################ Paths ################################
+
+FORCEINLINE int UMM_GridObject::WalkFrom(int32& X, int32& Y, int HorizontalStep, TArray<FIntVector2D>* OutPath) const
+{
+	int StepCount = 0;
+	while (true)
+	{
+		// Fall to the landing row if there is a free slot below
+		const int LandingRow = LandingRows[X * GridSize.Y + Y];
+		if (LandingRow != Y)
 		{
-			bFoundFreeSlot = true;
+			Y = LandingRow;
+			StepCount++;
+			if (OutPath)
+			{
+				OutPath->Emplace(X, Y);
+			}
 		}
-		// No free slot below, exit loop
-		else
+
+		// Step ahead if free, otherwise the walk is complete as falling was already resolved
+		const int NextX = X + HorizontalStep;
+		if (NextX < 0 || NextX >= GridSize.X || SlotTypes[NextX * GridSize.Y + Y] != EGridSlotType::E_EMPTY)
 		{
 			break;
 		}
+
+		X = NextX;
+		StepCount++;
+		if (OutPath)
+		{
+			OutPath->Emplace(X, Y);
+		}
 	}
+	return StepCount;
+}
+
+FIntVector2D UMM_GridObject::WalkPath(const FIntVector2D& Start, EDirection Direction, TArray<FIntVector2D>* OutPath, int& OutStepCount) const
+{
+	OutStepCount = 0;
+
+	// Outside the grid never moves
+	if (!IsCoordInRange(Start, 0, GridSize.X - 1, 0, GridSize.Y - 1))
+	{
+		return Start;
+	}
+
+	// A stored result is enough when the path isn't needed, or when there is no movement to add to the path
+	FIntVector2D CachedFinal;
+	if (PathCache.Find(Start, Direction, CachedFinal, OutStepCount) && (!OutPath || OutStepCount == 0))
+	{
+		INC_DWORD_STAT(STAT_MiceMen_PathCacheHits);
+		return CachedFinal;
+	}
+	INC_DWORD_STAT(STAT_MiceMen_PathCacheMisses);
 
-	return bFoundFreeSlot;
+	int32 X = Start.X;
+	int32 Y = Start.Y;
+	OutStepCount = WalkFrom(X, Y, Direction == EDirection::E_RIGHT ? 1 : -1, OutPath);
+
+	const FIntVector2D Final(X, Y);
+	PathCache.Store(Start, Direction, Final, OutStepCount);
+	return Final;
 }
 
-bool UMM_GridObject::FindFreeSlotAhead(FIntVector2D& CurrentPosition, EDirection Direction) const
+void UMM_GridObject::WalkPathBatch(FMM_PathBatch& Batch, EDirection Direction, bool bStorePaths /*= false*/) const
 {
-	const int HorizontalDirection = Direction == EDirection::E_RIGHT ? 1 : -1;
-	return FindFreeSlotInDirection(CurrentPosition, FIntVector2D(HorizontalDirection, 0));
+	MM_TRACE_SCOPE("UMM_GridObject::WalkPathBatch");
+
+	const int WalkerCount = Batch.Num();
+	const int HorizontalStep = Direction == EDirection::E_RIGHT ? 1 : -1;
+
+	Batch.FinalX.SetNumUninitialized(WalkerCount, false);
+	Batch.FinalY.SetNumUninitialized(WalkerCount, false);
+	Batch.StepCounts.SetNumUninitialized(WalkerCount, false);
+	Batch.Paths.Reset();
+	Batch.PathOffsets.Reset();
+
+	TArray<FIntVector2D>* OutPaths = bStorePaths ? &Batch.Paths : nullptr;
+	int CacheHits = 0;
+	int CacheMisses = 0;
+	for (int i = 0; i < WalkerCount; i++)
+	{
+		int32 X = Batch.StartX[i];
+		int32 Y = Batch.StartY[i];
+		int StepCount = 0;
+
+		if (OutPaths)
+		{
+			Batch.PathOffsets.Add(OutPaths->Num());
+			OutPaths->Emplace(X, Y);
+		}
+
+		// Walkers outside the grid stay where they are
+		if (X >= 0 && X < GridSize.X && Y >= 0 && Y < GridSize.Y)
+		{
+			const FIntVector2D Start(X, Y);
+			FIntVector2D CachedFinal;
+
+			// Without paths a stored result is enough
+			if (!OutPaths && PathCache.Find(Start, Direction, CachedFinal, StepCount))
+			{
+				X = CachedFinal.X;
+				Y = CachedFinal.Y;
+				CacheHits++;
+			}
+			else
+			{
+				StepCount = WalkFrom(X, Y, HorizontalStep, OutPaths);
+				PathCache.Store(Start, Direction, FIntVector2D(X, Y), StepCount);
+				CacheMisses++;
+			}
+		}
+
+		Batch.FinalX[i] = X;
+		Batch.FinalY[i] = Y;
+		Batch.StepCounts[i] = StepCount;
+	}
+
+	// End of the last path
+	if (OutPaths)
+	{
+		Batch.PathOffsets.Add(OutPaths->Num());
+	}
+
+	INC_DWORD_STAT_BY(STAT_MiceMen_PathCacheHits, CacheHits);
+	INC_DWORD_STAT_BY(STAT_MiceMen_PathCacheMisses, CacheMisses);
 }
@@ -0,0 +1,326 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Grid/MM_GridVisualsComponent.h"
+
+#include "GameFramework/PlayerController.h"
+
+#include "Grid/MM_GridManager.h"
+#include "Grid/MM_GridObject.h"
+#include "Grid/MM_GridBlock.h"
+#include "Gameplay/MM_ColumnControl.h"
+#include "Base/MM_GameMode.h"
+#include "MiceMen.h"
+
+UMM_GridVisualsComponent::UMM_GridVisualsComponent()
+{
+	// Only ticks while virtualized, to follow the camera view
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UMM_GridVisualsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bVirtualized || !DisplayedGridObject)
+	{
+		return;
+	}
+
+	// Keep the current columns if the view can't be bounded this frame
+	int NewMinColumn;
+	int NewMaxColumn;
+	if (CalculateVisibleColumns(NewMinColumn, NewMaxColumn))
+	{
+		UpdateVisibleColumns(NewMinColumn, NewMaxColumn);
+	}
+}
+
+// ################################ Grid Display ################################
+
+void UMM_GridVisualsComponent::ShowGrid(AMM_GridManager* InGridManager, UMM_GridObject* InGridObject)
+{
+	// Clear any previous grid, such as when the grid is rebuilt
+	HideGrid();
+
+	if (!InGridManager || !InGridObject)
+	{
+		return;
+	}
+
+	GridManager = InGridManager;
+	DisplayedGridObject = InGridObject;
+
+	const FIntVector2D GridSize = GridManager->GetGridSize();
+	ColumnVisuals.SetNum(GridSize.X);
+
+	// Small grids are always fully visualized
+	bVirtualized = GridSize.X > VirtualizeAboveColumns;
+	if (bVirtualized)
+	{
+		// No columns until the camera view is known, updated on tick
+		if (!CalculateVisibleColumns(VisibleColumnMin, VisibleColumnMax))
+		{
+			VisibleColumnMin = 0;
+			VisibleColumnMax = -1;
+		}
+		SetComponentTickEnabled(true);
+	}
+	else
+	{
+		VisibleColumnMin = 0;
+		VisibleColumnMax = GridSize.X - 1;
+	}
+
+	UE_LOG(MiceMenEventLog, Display, TEXT("UMM_GridVisualsComponent::ShowGrid | Showing grid %s, columns %i to %i %s"),
+	       *GridSize.ToString(), VisibleColumnMin, VisibleColumnMax, bVirtualized ? TEXT("virtualized") : TEXT(""));
+
+	// Apply to every column once, so elements out of view start hidden
+	for (int x = 0; x < GridSize.X; x++)
+	{
+		SetColumnVisible(x, IsColumnVisible(x));
+	}
+}
+
+void UMM_GridVisualsComponent::HideGrid()
+{
+	for (FMM_ColumnVisuals& Visuals : ColumnVisuals)
+	{
+		for (AMM_GridBlock* Block : Visuals.Blocks)
+		{
+			ReleaseBlock(Block);
+		}
+	}
+	ColumnVisuals.Reset();
+
+	VisibleColumnMin = 0;
+	VisibleColumnMax = -1;
+	bVirtualized = false;
+	DisplayedGridObject = nullptr;
+	SetComponentTickEnabled(false);
+}
+
+void UMM_GridVisualsComponent::RefreshColumn(int Column)
+{
+	// Columns out of view will be laid out when they come into view
+	if (DisplayedGridObject && ColumnVisuals.IsValidIndex(Column) && IsColumnVisible(Column))
+	{
+		SetColumnVisible(Column, true);
+	}
+}
+
+void UMM_GridVisualsComponent::RefreshElementVisibility(AMM_GridElement* GridElement) const
+{
+	if (!GridElement || !DisplayedGridObject)
+	{
+		return;
+	}
+
+	SetActorVisualActive(GridElement, IsColumnVisible(GridElement->GetCoordinates().X));
+}
+
+bool UMM_GridVisualsComponent::IsColumnRangeVisible(int FirstColumn, int LastColumn) const
+{
+	// Range overlaps the visible columns
+	return FMath::Min(FirstColumn, LastColumn) <= VisibleColumnMax && FMath::Max(FirstColumn, LastColumn) >= VisibleColumnMin;
+}
+
+bool UMM_GridVisualsComponent::CalculateVisibleColumns(int& OutMinColumn, int& OutMaxColumn) const
+{
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PlayerController || !GridManager)
+	{
+		return false;
+	}
+
+	int32 ViewportWidth = 0;
+	int32 ViewportHeight = 0;
+	PlayerController->GetViewportSize(ViewportWidth, ViewportHeight);
+	if (ViewportWidth <= 0 || ViewportHeight <= 0)
+	{
+		return false;
+	}
+
+	// The view on the grid plane is bounded by where the viewport corners hit it
+	const FVector2D ViewportCorners[] = {
+		FVector2D(0, 0), FVector2D(ViewportWidth, 0),
+		FVector2D(0, ViewportHeight), FVector2D(ViewportWidth, ViewportHeight)
+	};
+
+	OutMinColumn = MAX_int32;
+	OutMaxColumn = MIN_int32;
+	for (const FVector2D& Corner : ViewportCorners)
+	{
+		FVector RayOrigin;
+		FVector RayDirection;
+		if (!PlayerController->DeprojectScreenPositionToWorld(Corner.X, Corner.Y, RayOrigin, RayDirection))
+		{
+			return false;
+		}
+
+		// A corner looking past the grid plane can't bound the view
+		FVector HitLocation;
+		if (!GridManager->IntersectGridPlane(RayOrigin, RayDirection, HitLocation))
+		{
+			return false;
+		}
+
+		// Coordinate is set even when outside the grid
+		FIntVector2D CornerCoord;
+		GridManager->WorldToCoord(HitLocation, CornerCoord);
+		OutMinColumn = FMath::Min(OutMinColumn, CornerCoord.X);
+		OutMaxColumn = FMath::Max(OutMaxColumn, CornerCoord.X);
+	}
+
+	// Add margin and clamp to the grid, leaving the min above the max if the grid is out of view
+	OutMinColumn = FMath::Max(OutMinColumn - VisibleColumnMargin, 0);
+	OutMaxColumn = FMath::Min(OutMaxColumn + VisibleColumnMargin, GridManager->GetGridSize().X - 1);
+
+	return true;
+}
+
+void UMM_GridVisualsComponent::UpdateVisibleColumns(int NewMinColumn, int NewMaxColumn)
+{
+	// No change in view
+	if (NewMinColumn == VisibleColumnMin && NewMaxColumn == VisibleColumnMax)
+	{
+		return;
+	}
+
+	const int OldMinColumn = VisibleColumnMin;
+	const int OldMaxColumn = VisibleColumnMax;
+	VisibleColumnMin = NewMinColumn;
+	VisibleColumnMax = NewMaxColumn;
+
+	// Hide columns that left the view first, so their blocks can be reused
+	for (int x = OldMinColumn; x <= OldMaxColumn; x++)
+	{
+		if (!IsColumnVisible(x))
+		{
+			SetColumnVisible(x, false);
+		}
+	}
+
+	// Show columns that came into view
+	for (int x = NewMinColumn; x <= NewMaxColumn; x++)
+	{
+		if (x < OldMinColumn || x > OldMaxColumn)
+		{
+			SetColumnVisible(x, true);
+		}
+	}
+}
+
+void UMM_GridVisualsComponent::SetColumnVisible(int Column, bool bVisible)
+{
+	if (!ColumnVisuals.IsValidIndex(Column))
+	{
+		return;
+	}
+
+	// Return the current blocks, visible columns are laid out again from the logical board
+	FMM_ColumnVisuals& Visuals = ColumnVisuals[Column];
+	for (AMM_GridBlock* Block : Visuals.Blocks)
+	{
+		ReleaseBlock(Block);
+	}
+	Visuals.Blocks.Reset();
+
+	const int ColumnHeight = GridManager->GetGridSize().Y;
+	for (int y = 0; y < ColumnHeight; y++)
+	{
+		const FIntVector2D Coord(Column, y);
+
+		// Blocks only exist in the logical board, so are represented by a pooled visual
+		if (DisplayedGridObject->GetSlotType(Coord) == EGridSlotType::E_BLOCK)
+		{
+			if (bVisible)
+			{
+				if (AMM_GridBlock* Block = AcquireBlock(Coord))
+				{
+					Visuals.Blocks.Add(Block);
+				}
+			}
+		}
+		// Other elements, such as mice, keep their actor and are hidden out of view
+		else if (AMM_GridElement* GridElement = DisplayedGridObject->GetGridElement(Coord))
+		{
+			SetActorVisualActive(GridElement, bVisible);
+		}
+	}
+}
+
+// ################################ Pooling ################################
+
+void UMM_GridVisualsComponent::EmptyBlockPool()
+{
+	for (AMM_GridBlock* Block : BlockPool)
+	{
+		if (IsValid(Block))
+		{
+			Block->Destroy();
+		}
+	}
+	BlockPool.Empty();
+}
+
+AMM_GridBlock* UMM_GridVisualsComponent::AcquireBlock(const FIntVector2D& Coord)
+{
+	FTransform BlockTransform = GridManager->CoordToWorldTransform(Coord);
+
+	// Follow the column if it is displaced, such as while being dragged
+	if (const AMM_ColumnControl* ColumnControl = GridManager->GetColumnControl(Coord.X))
+	{
+		const FVector ColumnBase = GridManager->GetCoordinateMapper().CoordToWorld(FIntVector2D(Coord.X, 0));
+		BlockTransform.AddToTranslation(ColumnControl->GetActorLocation() - ColumnBase);
+	}
+
+	AMM_GridBlock* Block = nullptr;
+	if (BlockPool.Num() > 0)
+	{
+		Block = BlockPool.Pop(false);
+		Block->SetActorTransform(BlockTransform);
+	}
+	else
+	{
+		// Check class is valid
+		TSubclassOf<AMM_GridBlock> BlockClass = GridManager->GridBlockClass;
+		if (!BlockClass)
+		{
+			BlockClass = AMM_GridBlock::StaticClass();
+		}
+
+		LLM_SCOPE_BYTAG(MiceMen_BlockVisuals);
+		Block = GetWorld()->SpawnActor<AMM_GridBlock>(BlockClass, BlockTransform);
+		if (!Block)
+		{
+			UE_LOG(MiceMenEventLog, Error, TEXT("UMM_GridVisualsComponent::AcquireBlock | Failed to create Grid Block!"));
+			return nullptr;
+		}
+	}
+
+	// Attaches to the column to move with it
+	Block->SetupGridVariables(GridManager, GetWorld()->GetAuthGameMode<AMM_GameMode>(), Coord);
+	Block->UpdateGridPosition(Coord);
+	SetActorVisualActive(Block, true);
+
+	return Block;
+}
+
+void UMM_GridVisualsComponent::ReleaseBlock(AMM_GridBlock* Block)
+{
+	if (!IsValid(Block))
+	{
+		return;
+	}
+
+	SetActorVisualActive(Block, false);
+	BlockPool.Add(Block);
+}
+
+void UMM_GridVisualsComponent::SetActorVisualActive(AActor* Actor, bool bActive)
+{
+	Actor->SetActorHiddenInGame(!bActive);
+	Actor->SetActorEnableCollision(bActive);
+	Actor->SetActorTickEnabled(bActive);
+}
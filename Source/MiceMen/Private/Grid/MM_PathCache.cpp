@@ -0,0 +1,125 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Grid/MM_PathCache.h"
+
+// ################################ Setup ################################
+
+void FMM_PathCache::Setup(const FIntVector2D& InGridSize)
+{
+	GridSize = InGridSize;
+
+	// Entries are reset rather than kept, the grid they were valid for is gone
+	Entries.Reset();
+	Entries.SetNum(GridSize.X * GridSize.Y * 2);
+
+	// Empty columns have no taken slots to hash
+	ColumnHashes.Init(0, GridSize.X);
+	ColumnHashTree.Init(0, GridSize.X + 1);
+}
+
+void FMM_PathCache::Empty()
+{
+	GridSize = FIntVector2D(0, 0);
+	Entries.Empty();
+	ColumnHashes.Empty();
+	ColumnHashTree.Empty();
+}
+
+SIZE_T FMM_PathCache::GetAllocatedSize() const
+{
+	return Entries.GetAllocatedSize() + ColumnHashes.GetAllocatedSize() + ColumnHashTree.GetAllocatedSize();
+}
+
+// ################################ Column Hashes ################################
+
+void FMM_PathCache::ToggleSlot(const FIntVector2D& Coord)
+{
+	ApplyColumnChange(Coord.X, GetSlotKey(Coord.X, Coord.Y));
+}
+
+void FMM_PathCache::RehashColumn(int Column, TArrayView<const EGridSlotType> ColumnSlotTypes)
+{
+	uint64 NewHash = 0;
+	for (int y = 0; y < ColumnSlotTypes.Num(); y++)
+	{
+		if (ColumnSlotTypes[y] != EGridSlotType::E_EMPTY)
+		{
+			NewHash ^= GetSlotKey(Column, y);
+		}
+	}
+
+	// Moving a column back restores its hash, so results from before the move are valid again
+	ApplyColumnChange(Column, ColumnHashes[Column] ^ NewHash);
+}
+
+uint64 FMM_PathCache::GetColumnRangeHash(int FirstColumn, int LastColumn) const
+{
+	// Exclusive or cancels the shared prefix, leaving the range
+	uint64 RangeHash = 0;
+	for (int i = FMath::Min(LastColumn + 1, GridSize.X); i > 0; i -= i & -i)
+	{
+		RangeHash ^= ColumnHashTree[i];
+	}
+	for (int i = FMath::Min(FirstColumn, GridSize.X); i > 0; i -= i & -i)
+	{
+		RangeHash ^= ColumnHashTree[i];
+	}
+	return RangeHash;
+}
+
+uint64 FMM_PathCache::GetSlotKey(int Column, int Row) const
+{
+	// Split mix finalizer, spreads consecutive slot indices across all bits
+	uint64 Key = static_cast<uint64>(Column * GridSize.Y + Row + 1) * 0x9E3779B97F4A7C15ull;
+	Key = (Key ^ (Key >> 30)) * 0xBF58476D1CE4E5B9ull;
+	Key = (Key ^ (Key >> 27)) * 0x94D049BB133111EBull;
+	return Key ^ (Key >> 31);
+}
+
+void FMM_PathCache::ApplyColumnChange(int Column, uint64 Change)
+{
+	ColumnHashes[Column] ^= Change;
+	for (int i = Column + 1; i <= GridSize.X; i += i & -i)
+	{
+		ColumnHashTree[i] ^= Change;
+	}
+}
+
+// ################################ Results ################################
+
+bool FMM_PathCache::Find(const FIntVector2D& Start, EDirection Direction, FIntVector2D& OutFinal, int& OutStepCount) const
+{
+	const FEntry& Entry = Entries[GetEntryIndex(Start, Direction)];
+
+	// Never stored, or a depended on column has changed since
+	if (Entry.FirstColumn == INDEX_NONE || GetColumnRangeHash(Entry.FirstColumn, Entry.LastColumn) != Entry.RangeHash)
+	{
+		return false;
+	}
+
+	OutFinal = FIntVector2D(Entry.FinalX, Entry.FinalY);
+	OutStepCount = Entry.StepCount;
+	return true;
+}
+
+void FMM_PathCache::Store(const FIntVector2D& Start, EDirection Direction, const FIntVector2D& Final, int StepCount)
+{
+	// Columns walked through, and the column ahead of the final position which stopped the walk
+	const int HorizontalStep = Direction == EDirection::E_RIGHT ? 1 : -1;
+	const int BlockingColumn = FMath::Clamp(Final.X + HorizontalStep, 0, GridSize.X - 1);
+	const int FirstColumn = FMath::Min3(Start.X, Final.X, BlockingColumn);
+	const int LastColumn = FMath::Max3(Start.X, Final.X, BlockingColumn);
+
+	FEntry& Entry = Entries[GetEntryIndex(Start, Direction)];
+	Entry.RangeHash = GetColumnRangeHash(FirstColumn, LastColumn);
+	Entry.FirstColumn = static_cast<int16>(FirstColumn);
+	Entry.LastColumn = static_cast<int16>(LastColumn);
+	Entry.FinalX = static_cast<int16>(Final.X);
+	Entry.FinalY = static_cast<int16>(Final.Y);
+	Entry.StepCount = StepCount;
+}
+
+int FMM_PathCache::GetEntryIndex(const FIntVector2D& Start, EDirection Direction) const
+{
+	return (Start.X * GridSize.Y + Start.Y) * 2 + (Direction == EDirection::E_RIGHT ? 1 : 0);
+}
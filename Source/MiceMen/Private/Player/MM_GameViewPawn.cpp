@@ -3,7 +3,6 @@
 #include "Player/MM_GameViewPawn.h"
 
 #include "CineCameraComponent.h"
-#include "Kismet/KismetMathLibrary.h"
 
 #include "Player/MM_PlayerController.h"
 #include "Gameplay/MM_ColumnControl.h"
@@ -82,8 +81,7 @@ void AMM_GameViewPawn::BeginTurn()
 	if (MMGameMode && MMGameMode->GetCurrentGameType() == EGameType::E_SANDBOX)
 	{
 		// Add all columns as interactable
-		TMap<int, AMM_ColumnControl*> AllColumnControls = GridManager->GetColumnControls();
-		for (const TPair<int, AMM_ColumnControl*>& Column : AllColumnControls)
+		for (const TPair<int, AMM_ColumnControl*>& Column : GridManager->GetColumnControls())
 		{
 			CurrentColumnControls.Add(Column.Value);
 		}
@@ -92,7 +90,8 @@ void AMM_GameViewPawn::BeginTurn()
 	else
 	{
 		// Get available column indexes for this player
-		TArray<int> AvailableColumns = GridManager->GetTeamColumns(MMPlayerController->GetCurrentTeam());
+		TArray<int>& AvailableColumns = AvailableColumnsScratch;
+		GridManager->CollectTeamColumns(MMPlayerController->GetCurrentTeam(), AvailableColumns);
 		int FallbackColumn = -1;
 
 		// For each available column
@@ -134,13 +133,9 @@ void AMM_GameViewPawn::AITurnComplete(AMM_ColumnControl* ColumnControl)
 
 void AMM_GameViewPawn::AddColumnAsGrabbable(int Column)
 {
-	// Get all columns in grid
-	TMap<int, AMM_ColumnControl*> AllColumnControls = GridManager->GetColumnControls();
-
 	// Check column controls has the index and that it is a valid pointer
-	if (AllColumnControls.Contains(Column) && AllColumnControls[Column])
+	if (AMM_ColumnControl* ColumnControl = GridManager->GetColumnControl(Column))
 	{
-		AMM_ColumnControl* ColumnControl = AllColumnControls[Column];
 		// Display column as grabbable with a highlight and store
 		ColumnControl->DisplayAsGrabbable(true, MMPlayerController->GetCurrentTeam());
 		CurrentColumnControls.Add(ColumnControl);
@@ -164,11 +159,16 @@ void AMM_GameViewPawn::BeginGrab()
 		return;
 	}
 
-	// Get hit at mouse position in world on interactable channel
-	FHitResult InteractHit;
-	if (!GetWorld()->LineTraceSingleByChannel(InteractHit, WorldLocation,
-	                                          WorldLocation + WorldDirection * InteractTraceDistance,
-	                                          ECC_GameTraceChannel1))
+	if (!GetGridManager())
+	{
+		return;
+	}
+
+	// Find the grid coordinate under the mouse, calculated from the grid transform without a physics trace
+	FIntVector2D HitCoord;
+	FVector HitLocation;
+	const bool bHitGrid = GridManager->WorldRayToCoord(WorldLocation, WorldDirection, HitCoord, HitLocation);
+	if (!bHitGrid || FVector::Dist(WorldLocation, HitLocation) > InteractTraceDistance)
 	{
 		// Failed hit
 		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GameViewPawn::BeginGrab | Did not hit a column"));
@@ -176,10 +176,10 @@ void AMM_GameViewPawn::BeginGrab()
 	}
 
 	// Find column interacted with and check valid
-	AMM_ColumnControl* NewColumn = Cast<AMM_ColumnControl>(InteractHit.GetActor());
+	AMM_ColumnControl* NewColumn = GridManager->GetColumnControl(HitCoord.X);
 	if (!NewColumn)
 	{
-		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GameViewPawn::BeginGrab | Actor hit was not a column"));
+		UE_LOG(MiceMenEventLog, Warning, TEXT("AMM_GameViewPawn::BeginGrab | No column at %s"), *HitCoord.ToString());
 		return;
 	}
 
@@ -195,7 +195,7 @@ void AMM_GameViewPawn::BeginGrab()
 			UE_LOG(MiceMenEventLog, Display, TEXT("AMM_GameViewPawn::BeginGrab | Begin grabbing column %i"),
 			       CurrentColumn->GetColumnIndex());
 			// Store offset from grab position to update location correctly
-			HitColumnOffset = CurrentColumn->GetActorLocation() - InteractHit.Location;
+			HitColumnOffset = CurrentColumn->GetActorLocation() - HitLocation;
 		}
 		else
 		{
@@ -280,16 +280,9 @@ void AMM_GameViewPawn::HandleGrab()
 		return;
 	}
 
-	const FVector StartingLocation = WorldLocation;
-	const FVector EndLocation = StartingLocation + WorldDirection * InteractTraceDistance;
-
-	float IntersectDistance;
+	// Project onto the grid plane, which the column moves along
 	FVector IntersectionLocation;
-	if (!UKismetMathLibrary::LinePlaneIntersection_OriginNormal(StartingLocation, EndLocation,
-	                                                            CurrentColumn->GetActorLocation(),
-	                                                            CurrentColumn->GetActorForwardVector() * -1,
-	                                                            IntersectDistance,
-	                                                            IntersectionLocation))
+	if (!GetGridManager() || !GridManager->IntersectGridPlane(WorldLocation, WorldDirection, IntersectionLocation))
 	{
 		// Failed to intersect the plane
 		return;
@@ -328,7 +321,7 @@ void AMM_GameViewPawn::TurnEnded()
 		}
 	}
 
-	CurrentColumnControls.Empty();
+	CurrentColumnControls.Reset();
 }
 
 AMM_GridManager* AMM_GameViewPawn::GetGridManager()
@@ -8,6 +8,8 @@
 #include "Grid/MM_GridManager.h"
 #include "MiceMen.h"
 #include "Gameplay/MM_Mouse.h"
+#include "Rules/MM_RulesSearch.h"
+#include "Rules/MM_OpeningBook.h"
 
 AMM_PlayerController::AMM_PlayerController()
 {
@@ -49,6 +51,8 @@ void AMM_PlayerController::ClearAI()
 
 void AMM_PlayerController::BeginTurn()
 {
+	LastAIThinkTime = 0.0;
+
 	if (MMPawn)
 	{
 		MMPawn->BeginTurn();
@@ -63,8 +67,17 @@ bool AMM_PlayerController::TakeAITurn()
 		return false;
 	}
 
+	const double ThinkStartTime = FPlatformTime::Seconds();
+
+	// Stalemates are solved exactly by the search, so any AI that isn't random plays them perfectly
+	const bool bSolveStalemate = MMGameMode && MMGameMode->GetStalemateCount() >= 0 && MMGameMode->GetCurrentAIDifficulty() == EAIDifficulty::E_ADVANCED;
+
 	bool bTurnSuccess = false;
-	if (MMGameMode && MMGameMode->GetCurrentAIDifficulty() == EAIDifficulty::E_ADVANCED)
+	if (MMGameMode && (MMGameMode->GetCurrentAIDifficulty() == EAIDifficulty::E_EXPERT || bSolveStalemate))
+	{
+		bTurnSuccess = TakeExpertAITurn();
+	}
+	else if (MMGameMode && MMGameMode->GetCurrentAIDifficulty() == EAIDifficulty::E_ADVANCED)
 	{
 		bTurnSuccess = TakeAdvancedAITurn();
 	}
@@ -73,6 +86,8 @@ bool AMM_PlayerController::TakeAITurn()
 		bTurnSuccess = TakeRandomAITurn();
 	}
 
+	LastAIThinkTime = FPlatformTime::Seconds() - ThinkStartTime;
+
 	return bTurnSuccess;
 }
 
@@ -98,8 +113,8 @@ bool AMM_PlayerController::PerformColumnAIMovement(AMM_ColumnControl* Column, co
 	       Direction, Column->GetColumnIndex());
 	Column->UpdatePreviewLocation(NewLocation);
 
-	// If testing mode, instantly move column
-	if (MMGameMode && MMGameMode->GetCurrentGameType() == EGameType::E_TEST)
+	// If visuals are skipped, instantly move column
+	if (MMGameMode && MMGameMode->IsInstantVisuals())
 	{
 		Column->SetActorLocation(NewLocation);
 	}
@@ -118,7 +133,7 @@ bool AMM_PlayerController::TakeRandomAITurn() const
 		return false;
 	}
 
-	TArray<AMM_ColumnControl*> CurrentColumnControls = MMPawn->GetCurrentColumnControls();
+	const TArray<AMM_ColumnControl*>& CurrentColumnControls = MMPawn->GetCurrentColumnControls();
 
 	// Find random column
 	const int RandomIndex = FMath::RandRange(0, CurrentColumnControls.Num() - 1);
@@ -138,6 +153,8 @@ bool AMM_PlayerController::TakeRandomAITurn() const
 
 bool AMM_PlayerController::TakeAdvancedAITurn() const
 {
+	MM_TRACE_SCOPE("AMM_PlayerController::TakeAdvancedAITurn");
+
 	if (!MMPawn)
 	{
 		return false;
@@ -147,63 +164,25 @@ bool AMM_PlayerController::TakeAdvancedAITurn() const
 		return false;
 	}
 
-	TArray<AMM_ColumnControl*> CurrentColumnControls = MMPawn->GetCurrentColumnControls();
-	TArray<AMM_Mouse*> TeamMice = MMGameMode->GetGridManager()->GetMiceTeams()[CurrentTeam];
-
-	int HighestScore = 0;
-	int BestColumn = -1;
-	
-	// Having up first means the default state when no optimal moves exist will be to move the column upwards
-	EDirection BestColumnDirection = EDirection::E_UP;
-
-	for (const AMM_ColumnControl* ColumnControl : CurrentColumnControls)
+	// Test the columns the player can currently move
+	TArray<int, TInlineAllocator<64>> CandidateColumns;
+	for (const AMM_ColumnControl* ColumnControl : MMPawn->GetCurrentColumnControls())
 	{
-		const int ColumnIndex = ColumnControl->GetColumnIndex();
-		TArray<EDirection> Directions = {EDirection::E_UP, EDirection::E_DOWN};
-		for (const EDirection Direction : Directions)
-		{
-			int CurrentScore = 0;
-
-			// Find direction to move back column
-			EDirection OppositeDirection = EDirection::E_UP;
-			if (Direction == EDirection::E_UP)
-			{
-				OppositeDirection = EDirection::E_DOWN;
-			}
-
-			// Move column to test for score
-			AMM_GridElement* LastGridElement;
-			MMGameMode->GetGridManager()->AdjustColumnInGridObject(ColumnIndex, Direction, LastGridElement);
-
-			// Find out score ie amount of movement for all mice
-			for (const AMM_Mouse* Mouse : TeamMice)
-			{
-				// Minus one as by default the path has the initial position (no movement)
-				CurrentScore += FMath::Max(0, Mouse->GetMovementPath().Num() - 1);
-			}
-
-			// Return the column back
-			MMGameMode->GetGridManager()->AdjustColumnInGridObject(ColumnIndex, OppositeDirection, LastGridElement);
-
-			// Compare score
-			if (CurrentScore > HighestScore)
-			{
-				HighestScore = CurrentScore;
-				BestColumn = ColumnIndex;
-				BestColumnDirection = Direction;
-			}
-		}
+		CandidateColumns.Add(ColumnControl->GetColumnIndex());
 	}
 
+	int BestColumn;
+	EDirection BestColumnDirection;
+
 	// No column movement was found
-	if (BestColumn < 0)
+	if (!MMGameMode->GetGridManager()->FindBestColumnMove(CurrentTeam, CandidateColumns, BestColumn, BestColumnDirection))
 	{
 		// Default to random movement
 		return TakeRandomAITurn();
 	}
 
 	// Apply column movement
-	AMM_ColumnControl* CurrentColumn = MMGameMode->GetGridManager()->GetColumnControls()[BestColumn];
+	AMM_ColumnControl* CurrentColumn = MMGameMode->GetGridManager()->GetColumnControl(BestColumn);
 	const int Direction = BestColumnDirection == EDirection::E_UP ? 1 : -1;
 
 	if (!PerformColumnAIMovement(CurrentColumn, Direction))
@@ -215,6 +194,76 @@ bool AMM_PlayerController::TakeAdvancedAITurn() const
 	return true;
 }
 
+bool AMM_PlayerController::TakeExpertAITurn() const
+{
+	MM_TRACE_SCOPE("AMM_PlayerController::TakeExpertAITurn");
+
+	if (!MMPawn)
+	{
+		return false;
+	}
+	if (!MMGameMode->GetGridManager())
+	{
+		return false;
+	}
+
+	FMM_RulesBoard Board;
+	MMGameMode->GetGridManager()->BuildRulesBoard(Board);
+
+	// Only this player's moved columns are known, the other team starts unlimited
+	const ERulesTeam Team = static_cast<ERulesTeam>(CurrentTeam);
+	FMM_SameColumnLimits ColumnLimits;
+	ColumnLimits.LastMovedColumns[Team == ERulesTeam::E_TEAM_A ? 0 : 1] = MMPawn->GetLastMovedColumn();
+	ColumnLimits.SameMovedColumnCounts[Team == ERulesTeam::E_TEAM_A ? 0 : 1] = MMPawn->GetSameMovedColumnCount();
+
+	FMM_SearchSettings Settings;
+	Settings.MaxDepth = MMGameMode->ExpertSearchDepth;
+	Settings.SameColumnMax = MMPawn->SameColumnMax;
+
+	FMM_RulesSearch Search(MMGameMode->GetAITranspositionTable());
+	FMM_SearchMove BestMove;
+	int32 StalemateScore;
+	if (MMGameMode->GetOpeningBook().FindMove(FMM_OpeningBook::GetPositionKey(Board, Team, MMPawn->GetLastMovedColumn(), MMPawn->GetSameMovedColumnCount(), Settings.SameColumnMax), BestMove))
+	{
+		UE_LOG(MiceMenEventLog, Log, TEXT("AMM_PlayerController::TakeExpertAITurn | Opening book move for board seed %i"), MMGameMode->GetCurrentBoardSeed());
+	}
+	else if (Search.SolveStalemate(Board, Team, ColumnLimits, Settings, BestMove, StalemateScore))
+	{
+		UE_LOG(MiceMenEventLog, Log, TEXT("AMM_PlayerController::TakeExpertAITurn | Stalemate solved, %s with perfect play"),
+		       StalemateScore > 0 ? TEXT("winning") : StalemateScore < 0 ? TEXT("losing") : TEXT("drawing"));
+	}
+	else if (!Search.FindBestMove(Board, Team, ColumnLimits, Settings, BestMove))
+	{
+		return TakeAdvancedAITurn();
+	}
+
+	// Check the move is one of the columns the player can currently move
+	AMM_ColumnControl* CurrentColumn = nullptr;
+	for (AMM_ColumnControl* ColumnControl : MMPawn->GetCurrentColumnControls())
+	{
+		if (ColumnControl && ColumnControl->GetColumnIndex() == BestMove.Column)
+		{
+			CurrentColumn = ColumnControl;
+			break;
+		}
+	}
+	if (!CurrentColumn)
+	{
+		return TakeAdvancedAITurn();
+	}
+
+	UE_LOG(MiceMenEventLog, Verbose, TEXT("AMM_PlayerController::TakeExpertAITurn | Searched %i positions, %i from the table"),
+	       Search.GetNodeCount(), Search.GetTableHitCount());
+
+	if (!PerformColumnAIMovement(CurrentColumn, BestMove.bUp ? 1 : -1))
+	{
+		return false;
+	}
+
+	OnAITurnComplete.Broadcast(CurrentColumn);
+	return true;
+}
+
 void AMM_PlayerController::TurnEnded()
 {
 }
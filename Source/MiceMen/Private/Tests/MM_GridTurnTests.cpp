@@ -0,0 +1,244 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/MM_TestWorld.h"
+#include "Grid/MM_GridManager.h"
+#include "Gameplay/MM_Mouse.h"
+#include "Gameplay/MM_ColumnControl.h"
+#include "Tools/MM_AllocationCounter.h"
+
+// ################################ Steady State Turns ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_SteadyStateTurnAllocationsTest, "MiceMen.Grid.SteadyStateTurnAllocations",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_SteadyStateTurnAllocationsTest::RunTest(const FString& Parameters)
+{
+	// Turns played before counting, so scratch buffers and containers have grown to size
+	static constexpr int WarmupTurns = 10;
+	static constexpr int MeasuredTurns = 10;
+
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		AMM_GridManager* GridManager = TestWorld.CreateBoard(BoardSize, MouseDensity, 1337);
+		if (!TestNotNull(*FString::Printf(TEXT("Board %s"), *BoardName), GridManager))
+		{
+			return;
+		}
+
+		TArray<int> Columns;
+		Columns.Reserve(BoardSize.X);
+
+		// One advanced AI decision, the column move and resolving all mice
+		const auto PlayTurn = [GridManager, &Columns](ETeam Team)
+		{
+			GridManager->CollectTeamColumns(Team, Columns);
+			int BestColumn = INDEX_NONE;
+			EDirection BestDirection = EDirection::E_UP;
+			if (!GridManager->FindBestColumnMove(Team, Columns, BestColumn, BestDirection))
+			{
+				// No move results in any movement, so move any available column
+				if (Columns.Num() <= 0)
+				{
+					return;
+				}
+				BestColumn = Columns[0];
+				BestDirection = EDirection::E_UP;
+			}
+
+			AMM_GridElement* LastElement;
+			GridManager->AdjustColumnInGridObject(BestColumn, BestDirection, LastElement);
+			GridManager->ResolveMiceImmediately(Team);
+		};
+
+		for (int i = 0; i < WarmupTurns; i++)
+		{
+			PlayTurn(i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B);
+		}
+
+		uint64 AllocationCount = 0;
+		{
+			FMM_ScopedAllocationCounter AllocationCounter;
+			for (int i = 0; i < MeasuredTurns; i++)
+			{
+				PlayTurn(i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B);
+			}
+			AllocationCount = AllocationCounter.GetAllocationCount();
+		}
+		if (AllocationCount > 0)
+		{
+			AddError(FString::Printf(TEXT("%llu heap allocations in %i steady state turns on %s"), AllocationCount, MeasuredTurns, *BoardName));
+		}
+
+		GridManager->Destroy();
+	});
+
+	return true;
+}
+
+// ################################ Cached Walks ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_CachedWalksTest, "MiceMen.Grid.CachedWalks",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_CachedWalksTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		FMM_PathBatch CachedBatch;
+		FMM_PathBatch WalkedBatch;
+		int StaleCount = 0;
+		TestWorld.PlayRandomCascades(BoardSize, MouseDensity, [&](AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)
+		{
+			// A stale cache keeps going stale, so stop at the first cascade that found any
+			if (StaleCount > 0)
+			{
+				return;
+			}
+
+			AMM_GridElement* LastElement;
+			GridManager->AdjustColumnInGridObject(Column, Direction, LastElement);
+			GridManager->ResolveMiceImmediately(Team);
+
+			// Cached results are checked after every cascade, as cascades change the most columns
+			for (ETeam CheckedTeam = ETeam::E_TEAM_A; CheckedTeam < ETeam::E_MAX; ++CheckedTeam)
+			{
+				// Storing paths always walks, so compares against the cached results
+				GridManager->ComputeTeamPaths(CheckedTeam, CachedBatch);
+				GridManager->ComputeTeamPaths(CheckedTeam, WalkedBatch, true);
+				for (int MouseIndex = 0; MouseIndex < CachedBatch.Num(); MouseIndex++)
+				{
+					if (CachedBatch.GetFinalPosition(MouseIndex) != WalkedBatch.GetFinalPosition(MouseIndex) || CachedBatch.StepCounts[MouseIndex] != WalkedBatch.StepCounts[MouseIndex])
+					{
+						AddError(FString::Printf(TEXT("Cached walk from %s ends at %s, walking ends at %s on %s"),
+						                         *FIntVector2D(CachedBatch.StartX[MouseIndex], CachedBatch.StartY[MouseIndex]).ToString(),
+						                         *CachedBatch.GetFinalPosition(MouseIndex).ToString(), *WalkedBatch.GetFinalPosition(MouseIndex).ToString(), *BoardName));
+						StaleCount++;
+					}
+				}
+			}
+		});
+	});
+
+	return true;
+}
+
+// ################################ Cascade Preview ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_CascadePreviewTest, "MiceMen.Grid.CascadePreview",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_CascadePreviewTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		TMap<const AMM_Mouse*, const FMM_PreviewMouseMove*> LastMoves;
+		TestWorld.PlayRandomCascades(BoardSize, MouseDensity, [&](AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)
+		{
+			// The preview shown while dragging, simulated before the column moves
+			FMM_CascadePreview Preview;
+			GridManager->SimulateColumnMove(Column, Direction, Team, Preview);
+
+			AMM_GridElement* LastElement;
+			GridManager->AdjustColumnInGridObject(Column, Direction, LastElement);
+			GridManager->ResolveMiceImmediately(Team);
+
+			// Only the last movement of each mouse is where it ended up
+			LastMoves.Reset();
+			for (const FMM_PreviewMouseMove& Move : Preview.Moves)
+			{
+				LastMoves.Add(Move.Mouse, &Move);
+			}
+			for (const TPair<const AMM_Mouse*, const FMM_PreviewMouseMove*>& LastMove : LastMoves)
+			{
+				const AMM_Mouse* Mouse = LastMove.Key;
+				const FMM_PreviewMouseMove& Move = *LastMove.Value;
+				if (!Mouse || Mouse->HasReachedEnd() != Move.bScores || (!Move.bScores && Mouse->GetCoordinates() != Move.Path.Last()))
+				{
+					AddError(FString::Printf(TEXT("Mouse previewed to end at %s (scoring %i) but ended at %s on %s"),
+					                         *Move.Path.Last().ToString(), Move.bScores ? 1 : 0, Mouse ? *Mouse->GetCoordinates().ToString() : TEXT("none"), *BoardName));
+				}
+			}
+		});
+	});
+
+	return true;
+}
+
+// ################################ AI Column Settle ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_AIColumnSettleTest, "MiceMen.Grid.AIColumnSettle",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_AIColumnSettleTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	AMM_GridManager* GridManager = TestWorld.CreateBoard(FIntVector2D(19, 13), 0.2f, 1337);
+	if (!TestNotNull(TEXT("Board 19x13"), GridManager))
+	{
+		return false;
+	}
+
+	AMM_ColumnControl* ColumnControl = GridManager->GetColumnControl(0);
+	if (!TestNotNull(TEXT("Column control"), ColumnControl))
+	{
+		GridManager->Destroy();
+		return false;
+	}
+
+	// The AI turns of the player controller, placing the column when grabbed with instant visuals and releasing it.
+	// The column is kept in its slot, as moving it resolves the mice through the game mode
+	for (int Turn = 0; Turn < 2; Turn++)
+	{
+		if (!TestTrue(TEXT("Column grabbed"), ColumnControl->BeginGrab()))
+		{
+			break;
+		}
+		const FVector NewLocation = ColumnControl->GetActorLocation();
+		ColumnControl->UpdatePreviewLocation(NewLocation);
+		ColumnControl->SetActorLocation(NewLocation);
+		ColumnControl->EndGrab();
+
+		// Already in its slot, so locks in on the next tick
+		ColumnControl->Tick(0.0f);
+
+		const double SettleTime = ColumnControl->GetLastSettleTime();
+		if (SettleTime < 0.0 || SettleTime > 1.0)
+		{
+			AddError(FString::Printf(TEXT("AI column settled in %f seconds on turn %i"), SettleTime, Turn));
+		}
+	}
+
+	GridManager->Destroy();
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,351 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/MM_TestWorld.h"
+#include "Grid/MM_GridManager.h"
+#include "Gameplay/MM_Mouse.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_FixedBoard.h"
+#include "Rules/MM_LockstepBoards.h"
+
+// ################################ Cascades ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_RulesCascadeTest, "MiceMen.Rules.CascadeMatchesGrid",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_RulesCascadeTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	const auto CoordLess = [](const FIntPoint& A, const FIntPoint& B) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; };
+	FMM_RulesBoard RulesBoard;
+	TArray<FIntPoint> GridMiceCoords;
+	TArray<FIntPoint> RulesMiceCoords;
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		TestWorld.PlayRandomCascades(BoardSize, MouseDensity, [&](AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)
+		{
+			// The same cascade resolved on a rules board copied from the grid should end the same once applied to the mice
+			AMM_GridElement* LastElement;
+			GridManager->AdjustColumnInGridObject(Column, Direction, LastElement);
+			GridManager->BuildRulesBoard(RulesBoard);
+			RulesBoard.ResolveCascade(static_cast<ERulesTeam>(Team));
+			GridManager->ResolveMiceImmediately(Team);
+
+			for (ETeam CheckedTeam = ETeam::E_TEAM_A; CheckedTeam < ETeam::E_MAX; ++CheckedTeam)
+			{
+				GridMiceCoords.Reset();
+				if (const TArray<AMM_Mouse*>* TeamMice = GridManager->GetMiceTeams().Find(CheckedTeam))
+				{
+					for (const AMM_Mouse* Mouse : *TeamMice)
+					{
+						GridMiceCoords.Add(FIntPoint(Mouse->GetCoordinates().X, Mouse->GetCoordinates().Y));
+					}
+				}
+
+				RulesMiceCoords.Reset();
+				for (const FMM_RulesMouse& RulesMouse : RulesBoard.GetMice())
+				{
+					if (RulesMouse.bActive && RulesMouse.Team == static_cast<ERulesTeam>(CheckedTeam))
+					{
+						RulesMiceCoords.Add(RulesMouse.Coord);
+					}
+				}
+
+				// Mice are compared by position, the order they are stored in can differ
+				GridMiceCoords.Sort(CoordLess);
+				RulesMiceCoords.Sort(CoordLess);
+				if (GridMiceCoords != RulesMiceCoords)
+				{
+					AddError(FString::Printf(TEXT("Team %i has %i mice on the grid and %i on the rules board, or they ended in different positions on %s"),
+					                         static_cast<int>(CheckedTeam), GridMiceCoords.Num(), RulesMiceCoords.Num(), *BoardName));
+				}
+			}
+		});
+	});
+
+	return true;
+}
+
+// ################################ Fixed Boards ################################
+
+/** Compares each team's total steps on the grid and on a board specialized for the grid size */
+template <int32 Width, int32 Height>
+static void MM_TestFixedBoardSteps(FAutomationTestBase& Test, const AMM_GridManager* GridManager, FMM_PathBatch& WalkedBatch)
+{
+	TMM_FixedBoard<Width, Height> Board;
+	GridManager->BuildFixedBoard(Board);
+	for (ETeam Team = ETeam::E_TEAM_A; Team < ETeam::E_MAX; ++Team)
+	{
+		GridManager->ComputeTeamPaths(Team, WalkedBatch, true);
+		const int FixedStepCount = Board.GetTeamStepCount(static_cast<ERulesTeam>(Team));
+		if (FixedStepCount != WalkedBatch.GetTotalStepCount())
+		{
+			Test.AddError(FString::Printf(TEXT("Team %i walked %i steps on the grid and %i on the %ix%i fixed board"),
+			                              static_cast<int>(Team), WalkedBatch.GetTotalStepCount(), FixedStepCount, Width, Height));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_FixedBoardTest, "MiceMen.Rules.FixedBoards",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_FixedBoardTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	FMM_PathBatch WalkedBatch;
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		TestWorld.PlayRandomCascades(BoardSize, MouseDensity, [&](AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)
+		{
+			AMM_GridElement* LastElement;
+			GridManager->AdjustColumnInGridObject(Column, Direction, LastElement);
+			GridManager->ResolveMiceImmediately(Team);
+
+			// Only the sizes the grid manager specializes have a fixed board
+			if (BoardSize == FIntVector2D(19, 13))
+			{
+				MM_TestFixedBoardSteps<19, 13>(*this, GridManager, WalkedBatch);
+			}
+			else if (BoardSize == FIntVector2D(64, 32))
+			{
+				MM_TestFixedBoardSteps<64, 32>(*this, GridManager, WalkedBatch);
+			}
+		});
+	});
+
+	return true;
+}
+
+// ################################ Lockstep Boards ################################
+
+/** Plays a full set of games in lockstep from the same board with random moves, checking every game matches a rules board playing the same moves */
+template <int32 Width, int32 Height>
+static void MM_TestLockstepGames(FAutomationTestBase& Test, const FMM_TestWorld& TestWorld, float MouseDensity, const FString& BoardName)
+{
+	static constexpr int TurnCount = 200;
+
+	AMM_GridManager* GridManager = TestWorld.CreateBoard(FIntVector2D(Width, Height), MouseDensity, 1337);
+	if (!GridManager)
+	{
+		return;
+	}
+	FMM_RulesBoard StartBoard;
+	GridManager->BuildRulesBoard(StartBoard);
+	GridManager->Destroy();
+
+	// Every lane starts from the same board then plays its own random moves
+	using FLockstepBoards = TMM_LockstepBoards<Width, Height>;
+	const int32 LaneCount = FLockstepBoards::MaxLanes;
+	const TUniquePtr<FLockstepBoards> LockstepBoards = MakeUnique<FLockstepBoards>();
+	TArray<FMM_RulesBoard> RulesBoards;
+	const auto ResetGames = [&]()
+	{
+		LockstepBoards->Setup(LaneCount, StartBoard.GetMicePerTeam(), StartBoard.GetStalemateTurns());
+		RulesBoards.Init(StartBoard, LaneCount);
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			LockstepBoards->CopyLane(Lane, StartBoard);
+		}
+	};
+	ResetGames();
+
+	TArray<int32> LaneColumns;
+	LaneColumns.SetNum(LaneCount);
+	TArray<FMM_RulesTurnResult> LaneResults;
+	LaneResults.SetNum(LaneCount);
+	TArray<int32> MovableColumns;
+	ERulesTeam Team = ERulesTeam::E_TEAM_A;
+	FMath::RandInit(1337);
+	for (int i = 0; i < TurnCount; i++)
+	{
+		// Start over once every game has ended
+		if (LockstepBoards->GetPlayingLanes() == 0)
+		{
+			ResetGames();
+		}
+
+		uint64 UpLanes = 0;
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			LockstepBoards->CollectMovableColumns(Lane, Team, MovableColumns);
+			LaneColumns[Lane] = MovableColumns.Num() > 0 ? MovableColumns[FMath::RandRange(0, MovableColumns.Num() - 1)] : INDEX_NONE;
+			UpLanes |= FMath::RandBool() ? 1ull << Lane : 0;
+		}
+
+		LockstepBoards->PlayTurn(Team, LaneColumns, UpLanes, LaneResults);
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			if (!RulesBoards[Lane].IsGameOver() && LaneColumns[Lane] != INDEX_NONE)
+			{
+				RulesBoards[Lane].PlayTurn(Team, LaneColumns[Lane], ((UpLanes >> Lane) & 1) != 0);
+			}
+		}
+
+		int MismatchCount = 0;
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			MismatchCount += LockstepBoards->MatchesBoard(Lane, RulesBoards[Lane]) ? 0 : 1;
+		}
+
+		// A mismatched game would keep mismatching, so stop comparing
+		if (MismatchCount > 0)
+		{
+			Test.AddError(FString::Printf(TEXT("%i lockstep games differed from the rules board on turn %i of %s"), MismatchCount, i, *BoardName));
+			return;
+		}
+
+		Team = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_LockstepBoardsTest, "MiceMen.Rules.LockstepBoards",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_LockstepBoardsTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		// Only the sizes with lockstep boards
+		if (BoardSize == FIntVector2D(19, 13))
+		{
+			MM_TestLockstepGames<19, 13>(*this, TestWorld, MouseDensity, BoardName);
+		}
+		else if (BoardSize == FIntVector2D(64, 32))
+		{
+			MM_TestLockstepGames<64, 32>(*this, TestWorld, MouseDensity, BoardName);
+		}
+	});
+
+	return true;
+}
+
+// ################################ No Valid Moves ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_NoValidMovesTest, "MiceMen.Rules.NoValidMoves",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_NoValidMovesTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	// Checked after every turn, so should end the game the same way on the grid and on the rules board
+	FMM_RulesBoard RulesBoard;
+	FMM_TestWorld::ForEachTestBoard([&](const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)
+	{
+		TestWorld.PlayRandomCascades(BoardSize, MouseDensity, [&](AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)
+		{
+			AMM_GridElement* LastElement;
+			GridManager->AdjustColumnInGridObject(Column, Direction, LastElement);
+			GridManager->ResolveMiceImmediately(Team);
+			GridManager->BuildRulesBoard(RulesBoard);
+
+			const bool bRulesNoValidMoves = RulesBoard.HasNoValidMoves();
+			if (bRulesNoValidMoves != GridManager->CheckNoValidMoves())
+			{
+				AddError(FString::Printf(TEXT("No valid moves is %i on the rules board and differs on the grid on %s"), bRulesNoValidMoves ? 1 : 0, *BoardName));
+			}
+		});
+	});
+
+	// A lone mouse walled in by full columns can never score, a gap in the wall lets it through
+	FMM_RulesBoard WalledBoard;
+	WalledBoard.Setup(5, 3, 1, 8);
+	for (int y = 0; y < 3; y++)
+	{
+		WalledBoard.AddBlock(FIntPoint(2, y));
+	}
+	WalledBoard.AddMouse(FIntPoint(1, 2), ERulesTeam::E_TEAM_A);
+	WalledBoard.SetGameState(0, 0, INDEX_NONE, -1);
+	TestTrue(TEXT("Walled in mouse has no valid moves"), WalledBoard.HasNoValidMoves());
+
+	FMM_RulesBoard OpenBoard;
+	OpenBoard.Setup(5, 3, 1, 8);
+	OpenBoard.AddBlock(FIntPoint(2, 0));
+	OpenBoard.AddBlock(FIntPoint(2, 1));
+	OpenBoard.AddMouse(FIntPoint(1, 2), ERulesTeam::E_TEAM_A);
+	OpenBoard.SetGameState(0, 0, INDEX_NONE, -1);
+	TestFalse(TEXT("Mouse facing a column with a gap has valid moves"), OpenBoard.HasNoValidMoves());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_WalledStalemateTest, "MiceMen.Rules.WalledStalemate",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_WalledStalemateTest::RunTest(const FString& Parameters)
+{
+	// The last mouse of each team walled in by full columns, team A further from its start so ahead on distance
+	static constexpr int Width = 7;
+	static constexpr int Height = 3;
+	FMM_RulesBoard Board;
+	Board.Setup(Width, Height, 3, 8);
+	for (int y = 0; y < Height; y++)
+	{
+		Board.AddBlock(FIntPoint(3, y));
+		Board.AddBlock(FIntPoint(4, y));
+	}
+	Board.AddMouse(FIntPoint(2, 0), ERulesTeam::E_TEAM_A);
+	Board.AddMouse(FIntPoint(5, 0), ERulesTeam::E_TEAM_B);
+	Board.SetGameState(2, 2, INDEX_NONE, 0);
+	if (!TestTrue(TEXT("Walled in mice have no valid moves"), Board.HasNoValidMoves()))
+	{
+		return false;
+	}
+
+	int DistanceWonBy;
+	const ERulesTeam ExpectedWinner = Board.GetWinningStalemateTeam(DistanceWonBy);
+	TestTrue(TEXT("Team ahead on distance"), ExpectedWinner == ERulesTeam::E_TEAM_A);
+
+	// Scores are level, so ending on no valid moves would tie, the stalemate should play out and go to the mouse ahead
+	TMM_LockstepBoards<Width, Height> LockstepBoards;
+	LockstepBoards.Setup(1, Board.GetMicePerTeam(), Board.GetStalemateTurns());
+	LockstepBoards.CopyLane(0, Board);
+	FMM_RulesTurnResult LaneResults[1];
+	ERulesTeam Team = ERulesTeam::E_TEAM_A;
+	for (int Turn = 1; Turn <= Board.GetStalemateTurns(); Turn++)
+	{
+		const int32 LaneColumns[1] = {Team == ERulesTeam::E_TEAM_A ? 2 : 5};
+		const FMM_RulesTurnResult Result = Board.PlayTurn(Team, LaneColumns[0], Turn % 4 < 2);
+		LockstepBoards.PlayTurn(Team, LaneColumns, Turn % 4 < 2 ? 1 : 0, LaneResults);
+
+		const bool bLastTurn = Turn == Board.GetStalemateTurns();
+		const ERulesOutcome ExpectedOutcome = bLastTurn ? ERulesOutcome::E_STALEMATE : ERulesOutcome::E_IN_PROGRESS;
+		TestTrue(*FString::Printf(TEXT("Rules board outcome on turn %i"), Turn), Result.Outcome == ExpectedOutcome);
+		TestTrue(*FString::Printf(TEXT("Lockstep outcome on turn %i"), Turn), LaneResults[0].Outcome == ExpectedOutcome);
+		if (bLastTurn)
+		{
+			TestTrue(TEXT("Rules board stalemate winner"), Result.Winner == ExpectedWinner);
+			TestTrue(TEXT("Lockstep stalemate winner"), LaneResults[0].Winner == ExpectedWinner);
+		}
+
+		Team = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,369 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/MM_TestWorld.h"
+#include "Grid/MM_GridManager.h"
+#include "Tools/MM_AllocationCounter.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_RulesSearch.h"
+#include "Rules/MM_PuzzleSolver.h"
+
+/** Builds the rules board of a standard size board, the only size the search is used on */
+static bool MM_BuildStandardBoard(FAutomationTestBase& Test, const FMM_TestWorld& TestWorld, FMM_RulesBoard& OutBoard)
+{
+	AMM_GridManager* GridManager = TestWorld.CreateBoard(FIntVector2D(19, 13), 0.2f, 1337);
+	if (!Test.TestNotNull(TEXT("Standard board"), GridManager))
+	{
+		return false;
+	}
+
+	GridManager->BuildRulesBoard(OutBoard);
+	GridManager->Destroy();
+	return true;
+}
+
+// ################################ Search Allocations ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_SearchAllocationsTest, "MiceMen.Search.WarmedSearchAllocations",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_SearchAllocationsTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	FMM_RulesBoard Board;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()) || !MM_BuildStandardBoard(*this, TestWorld, Board))
+	{
+		return false;
+	}
+
+	FMM_TranspositionTable Table;
+	Table.Resize(16);
+	FMM_RulesSearch Search(Table);
+	FMM_SearchMove Move;
+
+	// Warm up the thread's nodes and arena, so searching again should only reuse them
+	Search.FindBestMove(Board, ERulesTeam::E_TEAM_A, FMM_SameColumnLimits(), FMM_SearchSettings(), Move);
+	Search.FindBestMove(Board, ERulesTeam::E_TEAM_B, FMM_SameColumnLimits(), FMM_SearchSettings(), Move);
+
+	uint64 AllocationCount = 0;
+	{
+		FMM_ScopedAllocationCounter AllocationCounter;
+		Search.FindBestMove(Board, ERulesTeam::E_TEAM_A, FMM_SameColumnLimits(), FMM_SearchSettings(), Move);
+		AllocationCount = AllocationCounter.GetAllocationCount();
+	}
+	if (AllocationCount > 0)
+	{
+		AddError(FString::Printf(TEXT("%llu heap allocations in a warmed up search"), AllocationCount));
+	}
+
+	return true;
+}
+
+// ################################ Position Keys ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_PositionKeysTest, "MiceMen.Search.PositionKeys",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_PositionKeysTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 SameColumnMax = 6;
+
+	FMM_RulesBoard Board;
+	Board.Setup(7, 3, 3, 10);
+	Board.AddBlock(FIntPoint(3, 1));
+	Board.AddMouse(FIntPoint(1, 0), ERulesTeam::E_TEAM_A);
+	Board.AddMouse(FIntPoint(5, 2), ERulesTeam::E_TEAM_B);
+
+	// Counts under the limit don't change the moves, so they key the same as a team that hasn't moved
+	FMM_SameColumnLimits UnlimitedLimits;
+	FMM_SameColumnLimits UnderLimits;
+	for (int32 i = 0; i < SameColumnMax - 1; i++)
+	{
+		UnderLimits.RecordMove(ERulesTeam::E_TEAM_A, 1);
+		UnderLimits.RecordMove(ERulesTeam::E_TEAM_B, 5);
+	}
+	FMM_SameColumnLimits AtLimits = UnderLimits;
+	AtLimits.RecordMove(ERulesTeam::E_TEAM_B, 5);
+
+	FMM_PackedPosition UnlimitedPosition;
+	FMM_PackedPosition UnderPosition;
+	FMM_PackedPosition AtPosition;
+	UnlimitedPosition.Pack(Board, ERulesTeam::E_TEAM_A, UnlimitedLimits, SameColumnMax);
+	UnderPosition.Pack(Board, ERulesTeam::E_TEAM_A, UnderLimits, SameColumnMax);
+	AtPosition.Pack(Board, ERulesTeam::E_TEAM_A, AtLimits, SameColumnMax);
+
+	TestTrue(TEXT("Counts under the limit match an unlimited position"), UnderPosition.GetKey() == UnlimitedPosition.GetKey() && UnderPosition == UnlimitedPosition);
+	TestTrue(TEXT("A column at the limit is a different position"), AtPosition.GetKey() != UnderPosition.GetKey() && !(AtPosition == UnderPosition));
+
+	return true;
+}
+
+// ################################ Incremental Keys ################################
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_IncrementalKeysTest, "MiceMen.Search.IncrementalKeys",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_IncrementalKeysTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 TurnCount = 100;
+
+	FMM_TestWorld TestWorld;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()))
+	{
+		return false;
+	}
+
+	FMM_RulesBoard Board;
+	if (!MM_BuildStandardBoard(*this, TestWorld, Board))
+	{
+		return false;
+	}
+
+	// The key kept through column moves and cascades should match the key of the same slots placed on an empty board
+	FRandomStream RandomStream(1337);
+	FMM_RulesBoard PlacedBoard;
+	TArray<int> Columns;
+	ERulesTeam Team = ERulesTeam::E_TEAM_A;
+	for (int32 Turn = 0; Turn < TurnCount && !Board.IsGameOver(); Turn++)
+	{
+		Board.CollectMovableColumns(Team, Columns);
+		if (Columns.Num() <= 0)
+		{
+			break;
+		}
+		Board.PlayTurn(Team, Columns[RandomStream.RandHelper(Columns.Num())], RandomStream.FRand() < 0.5f);
+		Team = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+
+		FMM_TestWorld::CopyBlocks(Board, PlacedBoard);
+		for (const FMM_RulesMouse& Mouse : Board.GetMice())
+		{
+			if (Mouse.bActive)
+			{
+				PlacedBoard.AddMouse(Mouse.Coord, Mouse.Team);
+			}
+		}
+		if (Board.GetCellsKey() != PlacedBoard.GetCellsKey())
+		{
+			AddError(FString::Printf(TEXT("Cells key %llu after turn %i, placing the same slots keys %llu"), Board.GetCellsKey(), Turn, PlacedBoard.GetCellsKey()));
+			break;
+		}
+	}
+
+	return true;
+}
+
+// ################################ Stalemate Solver ################################
+
+/**
+* Score of a finished or stalemated game with perfect play for the team to move, as the search scores it:
+* a win less the turns until it, a loss plus the turns until it, 0 for a draw.
+* @param Ply turns played since the searched position
+*/
+static int32 MM_SolveStalemateExhaustively(const FMM_RulesBoard& Board, ERulesTeam Team, ERulesTeam Winner, int32 Ply = 0)
+{
+	if (Board.IsGameOver())
+	{
+		return Winner == ERulesTeam::E_NONE ? 0 : Winner == Team ? FMM_RulesSearch::WinScore - Ply : -FMM_RulesSearch::WinScore + Ply;
+	}
+
+	// With one mouse a team has one column, so the same column limit never applies
+	TArray<int> Columns;
+	Board.CollectMovableColumns(Team, Columns);
+
+	int32 BestScore = -FMM_RulesSearch::WinScore - 1;
+	const ERulesTeam OtherTeam = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+	for (const int Column : Columns)
+	{
+		for (const bool bUp : {true, false})
+		{
+			FMM_RulesBoard NextBoard = Board;
+			const ERulesTeam NextWinner = NextBoard.PlayTurn(Team, Column, bUp).Winner;
+			BestScore = FMath::Max(BestScore, -MM_SolveStalemateExhaustively(NextBoard, OtherTeam, NextWinner, Ply + 1));
+		}
+	}
+	return BestScore;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_StalemateSolverTest, "MiceMen.Search.StalemateSolver",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_StalemateSolverTest::RunTest(const FString& Parameters)
+{
+	FMM_TestWorld TestWorld;
+	FMM_RulesBoard Board;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()) || !MM_BuildStandardBoard(*this, TestWorld, Board))
+	{
+		return false;
+	}
+
+	TArray<FIntPoint> TeamMice[2];
+	for (const FMM_RulesMouse& Mouse : Board.GetMice())
+	{
+		if (Mouse.bActive)
+		{
+			TeamMice[Mouse.Team == ERulesTeam::E_TEAM_A ? 0 : 1].Add(Mouse.Coord);
+		}
+	}
+
+	// Stalemates from pairs of mice on the board's blocks, solved by the search and by every line without pruning or the table
+	FMM_TranspositionTable Table;
+	Table.Resize(1);
+	FMM_RulesSearch Search(Table);
+	FMM_RulesBoard StalemateBoard;
+	FMM_RulesBoard NextBoard;
+	TArray<int> Columns;
+	for (int i = 0; i < FMath::Min(TeamMice[0].Num(), TeamMice[1].Num()); i++)
+	{
+		// One mouse left on each team, each a point away from winning
+		FMM_TestWorld::CopyBlocks(Board, StalemateBoard);
+		StalemateBoard.AddMouse(TeamMice[0][i], ERulesTeam::E_TEAM_A);
+		StalemateBoard.AddMouse(TeamMice[1][i], ERulesTeam::E_TEAM_B);
+		StalemateBoard.SetGameState(Board.GetMicePerTeam() - 1, Board.GetMicePerTeam() - 1, INDEX_NONE, 0);
+
+		for (ERulesTeam Team : {ERulesTeam::E_TEAM_A, ERulesTeam::E_TEAM_B})
+		{
+			const int32 ExpectedScore = MM_SolveStalemateExhaustively(StalemateBoard, Team, ERulesTeam::E_NONE);
+
+			FMM_SearchMove Move;
+			int32 Score = 0;
+			Table.Clear();
+			bool bSolved = Search.SolveStalemate(StalemateBoard, Team, FMM_SameColumnLimits(), FMM_SearchSettings(), Move, Score);
+			if (!bSolved || Score != ExpectedScore)
+			{
+				AddError(FString::Printf(TEXT("Stalemate %i solved as %i for team %i, every line gives %i"), i, Score, static_cast<int>(Team), ExpectedScore));
+			}
+
+			// Solving each position after the team's moves first stores their wins a turn closer, so reading them back
+			// one turn down from the root has to count the turn again
+			Table.Clear();
+			const ERulesTeam OtherTeam = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+			StalemateBoard.CollectMovableColumns(Team, Columns);
+			for (const int Column : Columns)
+			{
+				for (const bool bUp : {true, false})
+				{
+					NextBoard = StalemateBoard;
+					NextBoard.PlayTurn(Team, Column, bUp);
+					FMM_SameColumnLimits NextLimits;
+					NextLimits.RecordMove(Team, Column);
+					int32 NextScore;
+					Search.SolveStalemate(NextBoard, OtherTeam, NextLimits, FMM_SearchSettings(), Move, NextScore);
+				}
+			}
+			bSolved = Search.SolveStalemate(StalemateBoard, Team, FMM_SameColumnLimits(), FMM_SearchSettings(), Move, Score);
+			if (!bSolved || Score != ExpectedScore)
+			{
+				AddError(FString::Printf(TEXT("Stalemate %i solved from stored turns as %i for team %i, every line gives %i"), i, Score, static_cast<int>(Team), ExpectedScore));
+			}
+		}
+	}
+
+	return true;
+}
+
+// ################################ Puzzle Solver ################################
+
+/** Whether any sequence of the team's moves no longer than the count completes all of the team's mice */
+static bool MM_CanSolvePuzzleExhaustively(const FMM_RulesBoard& Board, ERulesTeam Team, int MoveCount)
+{
+	if (Board.GetTeamMiceCount(Team) == 0)
+	{
+		return true;
+	}
+	if (MoveCount <= 0)
+	{
+		return false;
+	}
+
+	FMM_RulesBoard PuzzleBoard;
+	FMM_StandardPuzzleSolver::BuildPuzzleBoard(Board, PuzzleBoard);
+	for (int Column = 0; Column < PuzzleBoard.GetWidth(); Column++)
+	{
+		for (const bool bUp : {true, false})
+		{
+			FMM_RulesBoard NextBoard = PuzzleBoard;
+			NextBoard.PlayTurn(Team, Column, bUp);
+			if (NextBoard.GetTeamMiceCount(Team) == 0 || (!NextBoard.IsGameOver() && MM_CanSolvePuzzleExhaustively(NextBoard, Team, MoveCount - 1)))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMM_PuzzleSolverTest, "MiceMen.Search.PuzzleSolver",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMM_PuzzleSolverTest::RunTest(const FString& Parameters)
+{
+	// Short puzzles so every solve stays quick, solutions of up to two moves are also checked against every shorter sequence
+	static constexpr int PuzzleCount = 8;
+	static constexpr int MaxExhaustiveMoves = 2;
+
+	FMM_TestWorld TestWorld;
+	FMM_RulesBoard Board;
+	if (!TestTrue(TEXT("Test world created"), TestWorld.IsValid()) || !MM_BuildStandardBoard(*this, TestWorld, Board))
+	{
+		return false;
+	}
+
+	FMM_PuzzleSettings Settings;
+	Settings.MaxMoves = 3;
+	Settings.MaxBoards = 2000000;
+
+	FMM_StandardPuzzleSolver Solver;
+	FMM_RulesBoard PuzzleBoard;
+	TArray<FMM_SearchMove> Moves;
+	int PuzzleIndex = 0;
+	int SolvedCount = 0;
+	for (const FMM_RulesMouse& Mouse : Board.GetMice())
+	{
+		if (!Mouse.bActive || PuzzleIndex >= PuzzleCount)
+		{
+			continue;
+		}
+		PuzzleIndex++;
+
+		// The same blocks with only this mouse left
+		FMM_TestWorld::CopyBlocks(Board, PuzzleBoard);
+		PuzzleBoard.AddMouse(Mouse.Coord, Mouse.Team);
+		PuzzleBoard.SetGameState(0, 0, INDEX_NONE, -1);
+
+		const EPuzzleResult Result = Solver.Solve(PuzzleBoard, Mouse.Team, Settings, Moves);
+		if (Result != EPuzzleResult::E_SOLVED)
+		{
+			continue;
+		}
+		SolvedCount++;
+
+		// Replay the solution, the mouse should only be completed by the last move
+		FMM_RulesBoard ReplayBoard;
+		FMM_StandardPuzzleSolver::BuildPuzzleBoard(PuzzleBoard, ReplayBoard);
+		bool bReplayed = Moves.Num() > 0;
+		for (int i = 0; i < Moves.Num() && bReplayed; i++)
+		{
+			ReplayBoard.PlayTurn(Mouse.Team, Moves[i].Column, Moves[i].bUp);
+			bReplayed = (ReplayBoard.GetTeamMiceCount(Mouse.Team) == 0) == (i == Moves.Num() - 1);
+		}
+
+		// No shorter sequence should complete it
+		const bool bShortest = Moves.Num() - 1 > MaxExhaustiveMoves || !MM_CanSolvePuzzleExhaustively(PuzzleBoard, Mouse.Team, Moves.Num() - 1);
+		if (!bReplayed || !bShortest)
+		{
+			AddError(FString::Printf(TEXT("Puzzle %i solved in %i moves, replayed %i, shortest %i"), PuzzleIndex, Moves.Num(), bReplayed ? 1 : 0, bShortest ? 1 : 0));
+		}
+	}
+
+	// Otherwise nothing was checked
+	TestEqual(TEXT("Puzzles made"), PuzzleIndex, PuzzleCount);
+	TestTrue(FString::Printf(TEXT("%i of %i puzzles solved"), SolvedCount, PuzzleIndex), SolvedCount > 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Tests/MM_TestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#include "Grid/MM_GridManager.h"
+#include "Rules/MM_RulesBoard.h"
+
+FMM_TestWorld::FMM_TestWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MM_TestWorld"));
+	if (!World || !GEngine)
+	{
+		World = nullptr;
+		return;
+	}
+
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+}
+
+FMM_TestWorld::~FMM_TestWorld()
+{
+	if (!World)
+	{
+		return;
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+AMM_GridManager* FMM_TestWorld::CreateBoard(const FIntVector2D& BoardSize, float MouseDensity, int BoardSeed) const
+{
+	AMM_GridManager* GridManager = World ? World->SpawnActor<AMM_GridManager>() : nullptr;
+	if (!GridManager)
+	{
+		return nullptr;
+	}
+
+	// Same seed builds the same board
+	FMath::RandInit(BoardSeed);
+
+	// Density is of one team's side, matching how the grid manager splits the board
+	const int TeamSlots = (BoardSize.X / 2) * BoardSize.Y;
+	const int MicePerTeam = FMath::Max(1, FMath::RoundToInt(TeamSlots * MouseDensity));
+
+	GridManager->SetupGridVariables(BoardSize, nullptr);
+	GridManager->RebuildGrid(MicePerTeam);
+
+	return GridManager;
+}
+
+void FMM_TestWorld::ForEachTestBoard(TFunctionRef<void(const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)> Test)
+{
+	// The default board and the larger size with specialized boards, sparse and crowded
+	for (const FIntVector2D& BoardSize : {FIntVector2D(19, 13), FIntVector2D(64, 32)})
+	{
+		for (const float MouseDensity : {0.05f, 0.2f})
+		{
+			Test(BoardSize, MouseDensity, FString::Printf(TEXT("%ix%i/%i%%"), BoardSize.X, BoardSize.Y, FMath::RoundToInt(MouseDensity * 100.0f)));
+		}
+	}
+}
+
+bool FMM_TestWorld::ChooseRandomMove(const AMM_GridManager* GridManager, ETeam Team, int& OutColumn, EDirection& OutDirection)
+{
+	const TArray<int> Columns = GridManager->GetTeamColumns(Team);
+	if (Columns.Num() <= 0)
+	{
+		return false;
+	}
+
+	OutColumn = Columns[FMath::RandRange(0, Columns.Num() - 1)];
+	OutDirection = FMath::RandBool() ? EDirection::E_UP : EDirection::E_DOWN;
+	return true;
+}
+
+void FMM_TestWorld::CopyBlocks(const FMM_RulesBoard& Board, FMM_RulesBoard& OutBoard)
+{
+	OutBoard.Setup(Board.GetWidth(), Board.GetHeight(), Board.GetMicePerTeam(), Board.GetStalemateTurns());
+	for (int x = 0; x < Board.GetWidth(); x++)
+	{
+		for (int y = 0; y < Board.GetHeight(); y++)
+		{
+			if (Board.GetSlot(FIntPoint(x, y)) == ERulesSlot::E_BLOCK)
+			{
+				OutBoard.AddBlock(FIntPoint(x, y));
+			}
+		}
+	}
+}
+
+void FMM_TestWorld::PlayRandomCascades(const FIntVector2D& BoardSize, float MouseDensity, TFunctionRef<void(AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)> PlayMove) const
+{
+	AMM_GridManager* GridManager = nullptr;
+	for (int i = 0; i < CascadeCount; i++)
+	{
+		if (i % CascadesPerBoard == 0)
+		{
+			if (GridManager)
+			{
+				GridManager->Destroy();
+			}
+			GridManager = CreateBoard(BoardSize, MouseDensity, 1337 + i);
+		}
+
+		const ETeam Team = i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B;
+		int Column;
+		EDirection Direction;
+		if (GridManager && ChooseRandomMove(GridManager, Team, Column, Direction))
+		{
+			PlayMove(GridManager, Team, Column, Direction);
+		}
+	}
+	if (GridManager)
+	{
+		GridManager->Destroy();
+	}
+}
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Grid/IntVector2D.h"
+#include "Base/MM_GameEnums.h"
+#include "Base/MM_GridEnums.h"
+
+class UWorld;
+class AMM_GridManager;
+struct FMM_RulesBoard;
+
+/**
+ * Transient world for automation tests that spawn boards, nothing is rendered.
+ * The world and every board spawned in it are destroyed when it goes out of scope.
+ */
+class FMM_TestWorld
+{
+public:
+	FMM_TestWorld();
+
+	~FMM_TestWorld();
+
+	bool IsValid() const { return World != nullptr; }
+
+	/**
+	* Spawns a grid manager with a populated board, without a game mode so mice move instantly without visuals.
+	* @param MouseDensity fraction of each team's side of the board to fill with mice
+	* @param BoardSeed the board is the same every time for the same seed
+	*/
+	AMM_GridManager* CreateBoard(const FIntVector2D& BoardSize, float MouseDensity, int BoardSeed) const;
+
+	/** Runs the test on every tested board size and mouse density, named such as 64x32/20% */
+	static void ForEachTestBoard(TFunctionRef<void(const FIntVector2D& BoardSize, float MouseDensity, const FString& BoardName)> Test);
+
+	/** Picks a random column the team can move and a random direction, false if the team has no columns */
+	static bool ChooseRandomMove(const AMM_GridManager* GridManager, ETeam Team, int& OutColumn, EDirection& OutDirection);
+
+	/** Sets up a board of the same size and rules with the same blocks and no mice */
+	static void CopyBlocks(const FMM_RulesBoard& Board, FMM_RulesBoard& OutBoard);
+
+	/**
+	* Plays random column moves with each team in turn, rebuilding the board every CascadesPerBoard moves.
+	* @param PlayMove moves the column and resolves the cascade on the grid manager, and anything compared against it
+	*/
+	void PlayRandomCascades(const FIntVector2D& BoardSize, float MouseDensity, TFunctionRef<void(AMM_GridManager* GridManager, ETeam Team, int Column, EDirection Direction)> PlayMove) const;
+
+	/** Cascades played on a board before it is rebuilt, so the board doesn't empty as mice reach their goals */
+	static constexpr int CascadesPerBoard = 20;
+
+	static constexpr int CascadeCount = 100;
+
+protected:
+	UWorld* World = nullptr;
+};
+
+#endif
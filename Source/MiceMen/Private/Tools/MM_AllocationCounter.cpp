@@ -0,0 +1,62 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Tools/MM_AllocationCounter.h"
+
+#include "HAL/PlatformTLS.h"
+
+FMM_ScopedAllocationCounter::FMM_ScopedAllocationCounter()
+{
+	// Blocks are passed straight through, so they can be freed whether or not the counter is still active
+	WrappedMalloc = GMalloc;
+	GMalloc = this;
+}
+
+FMM_ScopedAllocationCounter::~FMM_ScopedAllocationCounter()
+{
+	GMalloc = WrappedMalloc;
+}
+
+void* FMM_ScopedAllocationCounter::Malloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation();
+	return WrappedMalloc->Malloc(Count, Alignment);
+}
+
+void* FMM_ScopedAllocationCounter::TryMalloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation();
+	return WrappedMalloc->TryMalloc(Count, Alignment);
+}
+
+void* FMM_ScopedAllocationCounter::Realloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	// Shrinking to nothing is a free
+	if (Count > 0)
+	{
+		CountAllocation();
+	}
+	return WrappedMalloc->Realloc(Original, Count, Alignment);
+}
+
+void* FMM_ScopedAllocationCounter::TryRealloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	if (Count > 0)
+	{
+		CountAllocation();
+	}
+	return WrappedMalloc->TryRealloc(Original, Count, Alignment);
+}
+
+void FMM_ScopedAllocationCounter::Free(void* Original)
+{
+	WrappedMalloc->Free(Original);
+}
+
+void FMM_ScopedAllocationCounter::CountAllocation()
+{
+	// Other threads may allocate at any time, only the game thread runs the turn
+	if (FPlatformTLS::GetCurrentThreadId() == GGameThreadId)
+	{
+		AllocationCount++;
+	}
+}
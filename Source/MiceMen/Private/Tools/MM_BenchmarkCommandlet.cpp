@@ -0,0 +1,645 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Tools/MM_BenchmarkCommandlet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+#include "Grid/MM_GridManager.h"
+#include "Grid/MM_GridObject.h"
+#include "Gameplay/MM_Mouse.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_LockstepBoards.h"
+#include "Rules/MM_RulesSearch.h"
+#include "Rules/MM_PuzzleSolver.h"
+#include "MiceMen.h"
+
+UMM_BenchmarkCommandlet::UMM_BenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+
+	BoardSizes = {FIntVector2D(19, 13), FIntVector2D(64, 32), FIntVector2D(200, 100)};
+	MouseDensities = {0.05f, 0.2f};
+}
+
+int32 UMM_BenchmarkCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("samples="), SampleCount);
+	FParse::Value(*Params, TEXT("seed="), Seed);
+	FParse::Value(*Params, TEXT("tolerance="), Tolerance);
+	SampleCount = FMath::Max(SampleCount, 1);
+
+	FString BaselinePath = FPaths::ProjectDir() / TEXT("Build") / TEXT("Benchmarks") / TEXT("MM_BenchmarkBaseline.csv");
+	FParse::Value(*Params, TEXT("baseline="), BaselinePath);
+	const bool bUpdateBaseline = FParse::Param(*Params, TEXT("updatebaseline"));
+
+	// Transient world to spawn boards in, nothing is rendered
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MM_BenchmarkWorld"));
+	if (!World || !GEngine)
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_BenchmarkCommandlet::Main | Failed to create benchmark world!"));
+		return 2;
+	}
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// Per element logging would dominate the timings
+	const ELogVerbosity::Type PreviousVerbosity = MiceMenEventLog.GetVerbosity();
+	MiceMenEventLog.SetVerbosity(ELogVerbosity::Warning);
+
+	for (const FIntVector2D& BoardSize : BoardSizes)
+	{
+		for (const float MouseDensity : MouseDensities)
+		{
+			RunBoardBenchmarks(World, BoardSize, MouseDensity);
+		}
+	}
+
+	MiceMenEventLog.SetVerbosity(PreviousVerbosity);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	// Report
+	for (const FMM_BenchmarkResult& Result : Results)
+	{
+		UE_LOG(MiceMenEventLog, Display, TEXT("UMM_BenchmarkCommandlet::Main | %-48s median %10.3f us  p99 %10.3f us  (%i samples)"),
+		       *Result.Name, Result.MedianMicroseconds, Result.P99Microseconds, Result.SampleCount);
+	}
+
+	const FString ResultsPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("MM_Benchmark_%s.csv"), *FDateTime::Now().ToString());
+	WriteResults(ResultsPath, Results);
+
+	if (bUpdateBaseline)
+	{
+		if (!WriteResults(BaselinePath, Results))
+		{
+			return 2;
+		}
+		UE_LOG(MiceMenEventLog, Display, TEXT("UMM_BenchmarkCommandlet::Main | Stored baseline %s"), *BaselinePath);
+		return 0;
+	}
+
+	// The baseline is committed with the project, without it nothing can be checked so the run fails
+	TMap<FString, FMM_BenchmarkResult> Baseline;
+	if (!ReadResults(BaselinePath, Baseline))
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_BenchmarkCommandlet::Main | No baseline at %s, run with -updatebaseline to store one"), *BaselinePath);
+		return 2;
+	}
+
+	TArray<FMM_BenchmarkResult> MissingResults;
+	const int RegressionCount = CountRegressions(Baseline, MissingResults);
+
+	// New operations start their baseline from this run, so they are checked from the next one
+	if (MissingResults.Num() > 0)
+	{
+		TArray<FMM_BenchmarkResult> UpdatedBaseline;
+		Baseline.GenerateValueArray(UpdatedBaseline);
+		UpdatedBaseline.Append(MissingResults);
+		if (WriteResults(BaselinePath, UpdatedBaseline))
+		{
+			UE_LOG(MiceMenEventLog, Warning, TEXT("UMM_BenchmarkCommandlet::Main | Added %i operations to %s, commit it to check them"), MissingResults.Num(), *BaselinePath);
+		}
+	}
+
+	if (RegressionCount > 0)
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_BenchmarkCommandlet::Main | %i operations regressed against %s"), RegressionCount, *BaselinePath);
+		return 1;
+	}
+
+	UE_LOG(MiceMenEventLog, Display, TEXT("UMM_BenchmarkCommandlet::Main | No regressions against %s"), *BaselinePath);
+	return 0;
+}
+
+// ################################ Benchmarks ################################
+
+void UMM_BenchmarkCommandlet::RunBoardBenchmarks(UWorld* World, const FIntVector2D& BoardSize, float MouseDensity)
+{
+	const FString BoardName = FString::Printf(TEXT("%ix%i/%i%%"), BoardSize.X, BoardSize.Y, FMath::RoundToInt(MouseDensity * 100.0f));
+
+	AMM_GridManager* GridManager = CreateBoard(World, BoardSize, MouseDensity, Seed);
+	if (!GridManager || !GridManager->GetGridObject())
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_BenchmarkCommandlet::RunBoardBenchmarks | Failed to create board %s!"), *BoardName);
+		return;
+	}
+	UMM_GridObject* GridObject = GridManager->GetGridObject();
+
+	TArray<double> SampleTimes;
+	SampleTimes.Reserve(SampleCount);
+
+	// Inputs are chosen before timing so the random calls aren't measured
+	TArray<FIntVector2D> RandomCoords;
+	FMath::RandInit(Seed);
+	for (int i = 0; i < SampleCount; i++)
+	{
+		RandomCoords.Add(FIntVector2D(FMath::RandRange(0, BoardSize.X - 1), FMath::RandRange(0, BoardSize.Y - 1)));
+	}
+
+	// Placing mice in random free slots, as when populating the board, on a separate board so this one is unchanged
+	AMM_GridManager* PlacementGridManager = CreateBoard(World, BoardSize, MouseDensity, Seed);
+	if (PlacementGridManager && PlacementGridManager->GetGridObject())
+	{
+		UMM_GridObject* PlacementGridObject = PlacementGridManager->GetGridObject();
+		TArray<AMM_Mouse*> PlacedMice;
+		for (const TPair<ETeam, TArray<AMM_Mouse*>>& Team : PlacementGridManager->GetMiceTeams())
+		{
+			PlacedMice.Append(Team.Value);
+		}
+		for (int i = 0; i < SampleCount && PlacedMice.Num() > 0; i++)
+		{
+			AMM_Mouse* Mouse = PlacedMice[i % PlacedMice.Num()];
+			const FIntVector2D FreeCoord = PlacementGridObject->GetRandomGridCoord();
+			SampleTimes.Add(TimeCall([&]() { PlacementGridObject->MoveGridElement(FreeCoord, Mouse); }));
+		}
+		AddResult(TEXT("PlaceGridElement/") + BoardName, SampleTimes);
+		PlacementGridManager->Destroy();
+	}
+
+	// Column moves, alternating directions so the board returns to its original state
+	for (int i = 0; i < SampleCount; i++)
+	{
+		const int Column = RandomCoords[i - i % 2].X;
+		const EDirection Direction = i % 2 == 0 ? EDirection::E_UP : EDirection::E_DOWN;
+		SampleTimes.Add(TimeCall([&]() { GridObject->MoveColumnElements(Column, Direction); }));
+	}
+	AddResult(TEXT("MoveColumnElements/") + BoardName, SampleTimes);
+
+	for (const FIntVector2D& Coord : RandomCoords)
+	{
+		FIntVector2D CurrentPosition = Coord;
+		SampleTimes.Add(TimeCall([&]() { GridObject->FindFreeSlotBelow(CurrentPosition); }));
+	}
+	AddResult(TEXT("FindFreeSlotBelow/") + BoardName, SampleTimes);
+
+	// Free slot draws over a column range ending at each random coordinate, as used when placing mice
+	for (const FIntVector2D& Coord : RandomCoords)
+	{
+		SampleTimes.Add(TimeCall([&]() { GridObject->GetRandomGridCoordInColumnRange(Coord.X / 2, Coord.X); }));
+	}
+	AddResult(TEXT("GetRandomFreeSlot/") + BoardName, SampleTimes);
+
+	// Paths for all mice, cycling through them if there are less mice than samples
+	TArray<AMM_Mouse*> AllMice;
+	for (const TPair<ETeam, TArray<AMM_Mouse*>>& Team : GridManager->GetMiceTeams())
+	{
+		AllMice.Append(Team.Value);
+	}
+	for (int i = 0; i < SampleCount && AllMice.Num() > 0; i++)
+	{
+		const AMM_Mouse* Mouse = AllMice[i % AllMice.Num()];
+		SampleTimes.Add(TimeCall([&]() { Mouse->GetMovementPath(); }));
+	}
+	AddResult(TEXT("GetMovementPath/") + BoardName, SampleTimes);
+
+	// All of a team's mice in one call, alternating teams
+	FMM_PathBatch PathBatch;
+	for (int i = 0; i < SampleCount; i++)
+	{
+		const ETeam Team = i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B;
+		SampleTimes.Add(TimeCall([&]() { GridManager->ComputeTeamPaths(Team, PathBatch); }));
+	}
+	AddResult(TEXT("ComputeTeamPaths/") + BoardName, SampleTimes);
+
+	// One advanced decision for each team in turn, the basic AI's random pick is timed as part of a whole turn below
+	int ChosenColumn = -1;
+	EDirection ChosenDirection = EDirection::E_NONE;
+	for (int i = 0; i < SampleCount; i++)
+	{
+		const ETeam Team = i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B;
+		SampleTimes.Add(TimeCall([&]()
+		{
+			GridManager->FindBestColumnMove(Team, GridManager->GetTeamColumns(Team), ChosenColumn, ChosenDirection);
+		}));
+	}
+	AddResult(TEXT("AIDecision/Advanced/") + BoardName, SampleTimes);
+
+	// Searches are far slower than one turn ahead, so fewer are timed and only on the standard board
+	// The table is cleared before each search, otherwise every search after the first would mostly be table hits
+	if (BoardSize == FIntVector2D(19, 13))
+	{
+		FMM_TranspositionTable Table;
+		Table.Resize(16);
+		FMM_RulesSearch Search(Table);
+		FMM_RulesBoard SearchBoard;
+		GridManager->BuildRulesBoard(SearchBoard);
+		FMM_SearchMove SearchMove;
+		for (int i = 0; i < FMath::Min(SampleCount, 20); i++)
+		{
+			const ERulesTeam Team = i % 2 == 0 ? ERulesTeam::E_TEAM_A : ERulesTeam::E_TEAM_B;
+			Table.Clear();
+			SampleTimes.Add(TimeCall([&]() { Search.FindBestMove(SearchBoard, Team, FMM_SameColumnLimits(), FMM_SearchSettings(), SearchMove); }));
+		}
+		AddResult(TEXT("AIDecision/Expert/") + BoardName, SampleTimes);
+
+		TimeStalemateSolver(SearchBoard, BoardName);
+		TimePuzzleSolver(SearchBoard, BoardName);
+	}
+
+	GridManager->Destroy();
+
+	// Full cascades from a column move, the board changes each time so is rebuilt before it empties
+	// The same cascade is also resolved on a rules board copied from the grid
+	AMM_GridManager* CascadeGridManager = nullptr;
+	FMM_RulesBoard RulesBoard;
+	TArray<double> RulesSampleTimes;
+	RulesSampleTimes.Reserve(SampleCount);
+	TArray<double> NoValidMovesSampleTimes;
+	NoValidMovesSampleTimes.Reserve(SampleCount);
+	TArray<double> PreviewSampleTimes;
+	PreviewSampleTimes.Reserve(SampleCount);
+	for (int i = 0; i < SampleCount; i++)
+	{
+		if (i % CascadesPerBoard == 0)
+		{
+			if (CascadeGridManager)
+			{
+				CascadeGridManager->Destroy();
+			}
+			CascadeGridManager = CreateBoard(World, BoardSize, MouseDensity, Seed + i);
+		}
+		if (!CascadeGridManager)
+		{
+			break;
+		}
+
+		const ETeam Team = i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B;
+		const TArray<int> Columns = CascadeGridManager->GetTeamColumns(Team);
+		if (Columns.Num() <= 0)
+		{
+			continue;
+		}
+		const int Column = Columns[FMath::RandRange(0, Columns.Num() - 1)];
+		const EDirection Direction = FMath::RandBool() ? EDirection::E_UP : EDirection::E_DOWN;
+
+		// The preview shown while dragging, simulated before the column moves
+		FMM_CascadePreview CascadePreview;
+		PreviewSampleTimes.Add(TimeCall([&]() { CascadeGridManager->SimulateColumnMove(Column, Direction, Team, CascadePreview); }));
+
+		AMM_GridElement* LastElement;
+		CascadeGridManager->AdjustColumnInGridObject(Column, Direction, LastElement);
+
+		CascadeGridManager->BuildRulesBoard(RulesBoard);
+		RulesSampleTimes.Add(TimeCall([&]() { RulesBoard.ResolveCascade(static_cast<ERulesTeam>(Team)); }));
+
+		SampleTimes.Add(TimeCall([&]() { CascadeGridManager->ResolveMiceImmediately(Team); }));
+
+		// Checked after every turn, so it should be cheap
+		NoValidMovesSampleTimes.Add(TimeCall([&]() { RulesBoard.HasNoValidMoves(); }));
+	}
+	if (CascadeGridManager)
+	{
+		CascadeGridManager->Destroy();
+	}
+	AddResult(TEXT("Cascade/") + BoardName, SampleTimes);
+	AddResult(TEXT("RulesCascade/") + BoardName, RulesSampleTimes);
+	AddResult(TEXT("NoValidMoves/") + BoardName, NoValidMovesSampleTimes);
+	AddResult(TEXT("CascadePreview/") + BoardName, PreviewSampleTimes);
+
+	// Whole basic AI turns, a random column and direction then moving the column and resolving every mouse
+	AMM_GridManager* TurnGridManager = nullptr;
+	TArray<int> TurnColumns;
+	for (int i = 0; i < SampleCount; i++)
+	{
+		if (i % CascadesPerBoard == 0)
+		{
+			if (TurnGridManager)
+			{
+				TurnGridManager->Destroy();
+			}
+			TurnGridManager = CreateBoard(World, BoardSize, MouseDensity, Seed + i);
+		}
+		if (!TurnGridManager)
+		{
+			break;
+		}
+
+		const ETeam Team = i % 2 == 0 ? ETeam::E_TEAM_A : ETeam::E_TEAM_B;
+		SampleTimes.Add(TimeCall([&]()
+		{
+			TurnGridManager->CollectTeamColumns(Team, TurnColumns);
+			if (TurnColumns.Num() <= 0)
+			{
+				return;
+			}
+
+			AMM_GridElement* LastElement;
+			const EDirection Direction = FMath::RandBool() ? EDirection::E_UP : EDirection::E_DOWN;
+			TurnGridManager->AdjustColumnInGridObject(TurnColumns[FMath::RandRange(0, TurnColumns.Num() - 1)], Direction, LastElement);
+			TurnGridManager->ResolveMiceImmediately(Team);
+		}));
+	}
+	if (TurnGridManager)
+	{
+		TurnGridManager->Destroy();
+	}
+	AddResult(TEXT("RandomTurn/") + BoardName, SampleTimes);
+
+	// Bulk self play for the sizes with lockstep boards
+	if (BoardSize == FIntVector2D(19, 13))
+	{
+		RunLockstepBenchmarks<19, 13>(World, MouseDensity, BoardName);
+	}
+	else if (BoardSize == FIntVector2D(64, 32))
+	{
+		RunLockstepBenchmarks<64, 32>(World, MouseDensity, BoardName);
+	}
+
+	// Remove destroyed boards before the next board size
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+template <int32 Width, int32 Height>
+void UMM_BenchmarkCommandlet::RunLockstepBenchmarks(UWorld* World, float MouseDensity, const FString& BoardName)
+{
+	AMM_GridManager* GridManager = CreateBoard(World, FIntVector2D(Width, Height), MouseDensity, Seed);
+	if (!GridManager)
+	{
+		return;
+	}
+	FMM_RulesBoard StartBoard;
+	GridManager->BuildRulesBoard(StartBoard);
+	GridManager->Destroy();
+
+	// Every lane starts from the same board then plays its own random moves, on the lockstep boards and on a rules board each
+	using FLockstepBoards = TMM_LockstepBoards<Width, Height>;
+	const int32 LaneCount = FLockstepBoards::MaxLanes;
+	const TUniquePtr<FLockstepBoards> LockstepBoards = MakeUnique<FLockstepBoards>();
+	TArray<FMM_RulesBoard> RulesBoards;
+	const auto ResetGames = [&]()
+	{
+		LockstepBoards->Setup(LaneCount, StartBoard.GetMicePerTeam(), StartBoard.GetStalemateTurns());
+		RulesBoards.Init(StartBoard, LaneCount);
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			LockstepBoards->CopyLane(Lane, StartBoard);
+		}
+	};
+	ResetGames();
+
+	TArray<int32> LaneColumns;
+	LaneColumns.SetNum(LaneCount);
+	TArray<FMM_RulesTurnResult> LaneResults;
+	LaneResults.SetNum(LaneCount);
+	TArray<int32> MovableColumns;
+
+	TArray<double> LockstepSampleTimes;
+	TArray<double> RulesSampleTimes;
+	ERulesTeam Team = ERulesTeam::E_TEAM_A;
+	for (int i = 0; i < SampleCount; i++)
+	{
+		// Start over once every game has ended
+		if (LockstepBoards->GetPlayingLanes() == 0)
+		{
+			ResetGames();
+		}
+
+		// Moves are chosen before timing
+		uint64 UpLanes = 0;
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			LockstepBoards->CollectMovableColumns(Lane, Team, MovableColumns);
+			LaneColumns[Lane] = MovableColumns.Num() > 0 ? MovableColumns[FMath::RandRange(0, MovableColumns.Num() - 1)] : INDEX_NONE;
+			UpLanes |= FMath::RandBool() ? 1ull << Lane : 0;
+		}
+
+		LockstepSampleTimes.Add(TimeCall([&]() { LockstepBoards->PlayTurn(Team, LaneColumns, UpLanes, LaneResults); }));
+		RulesSampleTimes.Add(TimeCall([&]()
+		{
+			for (int32 Lane = 0; Lane < LaneCount; Lane++)
+			{
+				if (!RulesBoards[Lane].IsGameOver() && LaneColumns[Lane] != INDEX_NONE)
+				{
+					RulesBoards[Lane].PlayTurn(Team, LaneColumns[Lane], ((UpLanes >> Lane) & 1) != 0);
+				}
+			}
+		}));
+
+		Team = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+	}
+
+	AddResult(FString::Printf(TEXT("LockstepTurn/%igames/"), LaneCount) + BoardName, LockstepSampleTimes);
+	AddResult(FString::Printf(TEXT("RulesTurn/%igames/"), LaneCount) + BoardName, RulesSampleTimes);
+}
+
+void UMM_BenchmarkCommandlet::TimeStalemateSolver(const FMM_RulesBoard& Board, const FString& BoardName)
+{
+	TArray<FIntPoint> TeamMice[2];
+	for (const FMM_RulesMouse& Mouse : Board.GetMice())
+	{
+		if (Mouse.bActive)
+		{
+			TeamMice[Mouse.Team == ERulesTeam::E_TEAM_A ? 0 : 1].Add(Mouse.Coord);
+		}
+	}
+
+	TArray<double> SampleTimes;
+	FMM_TranspositionTable Table;
+	FMM_RulesSearch Search(Table);
+	FMM_RulesBoard StalemateBoard;
+	for (int i = 0; i < FMath::Min(TeamMice[0].Num(), TeamMice[1].Num()); i++)
+	{
+		// The same blocks with one mouse left on each team, each a point away from winning
+		StalemateBoard.Setup(Board.GetWidth(), Board.GetHeight(), Board.GetMicePerTeam(), Board.GetStalemateTurns());
+		for (int x = 0; x < Board.GetWidth(); x++)
+		{
+			for (int y = 0; y < Board.GetHeight(); y++)
+			{
+				if (Board.GetSlot(FIntPoint(x, y)) == ERulesSlot::E_BLOCK)
+				{
+					StalemateBoard.AddBlock(FIntPoint(x, y));
+				}
+			}
+		}
+		StalemateBoard.AddMouse(TeamMice[0][i], ERulesTeam::E_TEAM_A);
+		StalemateBoard.AddMouse(TeamMice[1][i], ERulesTeam::E_TEAM_B);
+		StalemateBoard.SetGameState(Board.GetMicePerTeam() - 1, Board.GetMicePerTeam() - 1, INDEX_NONE, 0);
+
+		for (ERulesTeam Team : {ERulesTeam::E_TEAM_A, ERulesTeam::E_TEAM_B})
+		{
+			FMM_SearchMove Move;
+			int32 Score = 0;
+			SampleTimes.Add(TimeCall([&]() { Search.SolveStalemate(StalemateBoard, Team, FMM_SameColumnLimits(), FMM_SearchSettings(), Move, Score); }));
+		}
+	}
+	AddResult(TEXT("AIDecision/Stalemate/") + BoardName, SampleTimes);
+}
+
+void UMM_BenchmarkCommandlet::TimePuzzleSolver(const FMM_RulesBoard& Board, const FString& BoardName)
+{
+	// Short puzzles so every solve stays quick
+	static constexpr int PuzzleCount = 8;
+	FMM_PuzzleSettings Settings;
+	Settings.MaxMoves = 3;
+	Settings.MaxBoards = 2000000;
+
+	TArray<double> SampleTimes;
+	FMM_StandardPuzzleSolver Solver;
+	FMM_RulesBoard PuzzleBoard;
+	TArray<FMM_SearchMove> Moves;
+	int PuzzleIndex = 0;
+	for (const FMM_RulesMouse& Mouse : Board.GetMice())
+	{
+		if (!Mouse.bActive || PuzzleIndex >= PuzzleCount)
+		{
+			continue;
+		}
+		PuzzleIndex++;
+
+		// The same blocks with only this mouse left
+		PuzzleBoard.Setup(Board.GetWidth(), Board.GetHeight(), Board.GetMicePerTeam(), Board.GetStalemateTurns());
+		for (int x = 0; x < Board.GetWidth(); x++)
+		{
+			for (int y = 0; y < Board.GetHeight(); y++)
+			{
+				if (Board.GetSlot(FIntPoint(x, y)) == ERulesSlot::E_BLOCK)
+				{
+					PuzzleBoard.AddBlock(FIntPoint(x, y));
+				}
+			}
+		}
+		PuzzleBoard.AddMouse(Mouse.Coord, Mouse.Team);
+		PuzzleBoard.SetGameState(0, 0, INDEX_NONE, -1);
+
+		SampleTimes.Add(TimeCall([&]() { Solver.Solve(PuzzleBoard, Mouse.Team, Settings, Moves); }));
+	}
+	AddResult(TEXT("PuzzleSolve/") + BoardName, SampleTimes);
+}
+
+AMM_GridManager* UMM_BenchmarkCommandlet::CreateBoard(UWorld* World, const FIntVector2D& BoardSize, float MouseDensity, int BoardSeed) const
+{
+	AMM_GridManager* GridManager = World->SpawnActor<AMM_GridManager>();
+	if (!GridManager)
+	{
+		return nullptr;
+	}
+
+	// Same seed builds the same board
+	FMath::RandInit(BoardSeed);
+
+	// Density is of one team's side, matching how the grid manager splits the board
+	const int TeamSlots = (BoardSize.X / 2) * BoardSize.Y;
+	const int MicePerTeam = FMath::Max(1, FMath::RoundToInt(TeamSlots * MouseDensity));
+
+	// No game mode, so mice move instantly without visuals
+	GridManager->SetupGridVariables(BoardSize, nullptr);
+	GridManager->RebuildGrid(MicePerTeam);
+
+	return GridManager;
+}
+
+void UMM_BenchmarkCommandlet::AddResult(const FString& Name, TArray<double>& SampleTimes)
+{
+	if (SampleTimes.Num() <= 0)
+	{
+		return;
+	}
+
+	SampleTimes.Sort();
+
+	FMM_BenchmarkResult Result;
+	Result.Name = Name;
+	Result.SampleCount = SampleTimes.Num();
+	Result.MedianMicroseconds = SampleTimes[SampleTimes.Num() / 2] * 1000000.0;
+	const int P99Index = FMath::Clamp(FMath::CeilToInt(SampleTimes.Num() * 0.99) - 1, 0, SampleTimes.Num() - 1);
+	Result.P99Microseconds = SampleTimes[P99Index] * 1000000.0;
+	Results.Add(Result);
+
+	// Ready for the next operation
+	SampleTimes.Reset();
+}
+
+double UMM_BenchmarkCommandlet::TimeCall(TFunctionRef<void()> Call)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Call();
+	return (FPlatformTime::Cycles64() - StartCycles) * FPlatformTime::GetSecondsPerCycle64();
+}
+
+// ################################ Baseline ################################
+
+bool UMM_BenchmarkCommandlet::WriteResults(const FString& FilePath, const TArray<FMM_BenchmarkResult>& InResults)
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Name,Samples,MedianUs,P99Us"));
+	for (const FMM_BenchmarkResult& Result : InResults)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%i,%.3f,%.3f"), *Result.Name, Result.SampleCount, Result.MedianMicroseconds, Result.P99Microseconds));
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_BenchmarkCommandlet::WriteResults | Failed to write %s!"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool UMM_BenchmarkCommandlet::ReadResults(const FString& FilePath, TMap<FString, FMM_BenchmarkResult>& OutResults)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		return false;
+	}
+
+	// Skip header
+	for (int i = 1; i < Lines.Num(); i++)
+	{
+		TArray<FString> Values;
+		Lines[i].ParseIntoArray(Values, TEXT(","));
+		if (Values.Num() < 4)
+		{
+			continue;
+		}
+
+		FMM_BenchmarkResult Result;
+		Result.Name = Values[0];
+		Result.SampleCount = FCString::Atoi(*Values[1]);
+		Result.MedianMicroseconds = FCString::Atod(*Values[2]);
+		Result.P99Microseconds = FCString::Atod(*Values[3]);
+		OutResults.Add(Result.Name, Result);
+	}
+	return true;
+}
+
+int UMM_BenchmarkCommandlet::CountRegressions(const TMap<FString, FMM_BenchmarkResult>& Baseline, TArray<FMM_BenchmarkResult>& OutMissingResults) const
+{
+	int RegressionCount = 0;
+	for (const FMM_BenchmarkResult& Result : Results)
+	{
+		// Nothing to regress against yet, so it is recorded as the baseline instead
+		const FMM_BenchmarkResult* BaselineResult = Baseline.Find(Result.Name);
+		if (!BaselineResult)
+		{
+			UE_LOG(MiceMenEventLog, Warning, TEXT("UMM_BenchmarkCommandlet::CountRegressions | %s has no baseline, recording median %.3f us, p99 %.3f us"),
+			       *Result.Name, Result.MedianMicroseconds, Result.P99Microseconds);
+			OutMissingResults.Add(Result);
+			continue;
+		}
+
+		const auto HasRegressed = [this](double Current, double Previous)
+		{
+			return Current > Previous * (1.0 + Tolerance) && Current - Previous > MinRegressionMicroseconds;
+		};
+
+		if (HasRegressed(Result.MedianMicroseconds, BaselineResult->MedianMicroseconds) ||
+			HasRegressed(Result.P99Microseconds, BaselineResult->P99Microseconds))
+		{
+			UE_LOG(MiceMenEventLog, Error, TEXT("UMM_BenchmarkCommandlet::CountRegressions | %s regressed, median %.3f us (was %.3f us), p99 %.3f us (was %.3f us)"),
+			       *Result.Name, Result.MedianMicroseconds, BaselineResult->MedianMicroseconds, Result.P99Microseconds, BaselineResult->P99Microseconds);
+			RegressionCount++;
+		}
+	}
+	return RegressionCount;
+}
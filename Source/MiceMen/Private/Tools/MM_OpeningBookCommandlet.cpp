@@ -0,0 +1,175 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Tools/MM_OpeningBookCommandlet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/PlatformTime.h"
+
+#include "Base/MM_GameMode.h"
+#include "Grid/MM_GridManager.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_RulesSearch.h"
+#include "Rules/MM_OpeningBook.h"
+#include "MiceMen.h"
+
+UMM_OpeningBookCommandlet::UMM_OpeningBookCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMM_OpeningBookCommandlet::Main(const FString& Params)
+{
+	// Defaults from the game mode, so the book matches the boards games are played on
+	const AMM_GameMode* DefaultGameMode = GetDefault<AMM_GameMode>();
+	SeedCount = DefaultGameMode->BoardSeedCount;
+	InitialMiceCount = DefaultGameMode->InitialMiceCount;
+	GridSize = DefaultGameMode->GetDefaultGridSize();
+	FString BookPath = FPaths::ProjectContentDir() / DefaultGameMode->OpeningBookFile;
+
+	FParse::Value(*Params, TEXT("seeds="), SeedCount);
+	FParse::Value(*Params, TEXT("depth="), SearchDepth);
+	FParse::Value(*Params, TEXT("plies="), BookPlies);
+	FParse::Value(*Params, TEXT("tablemb="), TableMegabytes);
+	FParse::Value(*Params, TEXT("width="), GridSize.X);
+	FParse::Value(*Params, TEXT("height="), GridSize.Y);
+	FParse::Value(*Params, TEXT("out="), BookPath);
+
+	// Without seeded boards there are no openings to store
+	if (SeedCount <= 0)
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_OpeningBookCommandlet::Main | No seeded boards, set BoardSeedCount on the game mode or pass -seeds="));
+		return 2;
+	}
+
+	// Transient world to spawn boards in, nothing is rendered
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("MM_OpeningBookWorld"));
+	if (!World || !GEngine)
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_OpeningBookCommandlet::Main | Failed to create world!"));
+		return 2;
+	}
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// Boards are built on the game thread, only the searches run in parallel
+	const ELogVerbosity::Type PreviousVerbosity = MiceMenEventLog.GetVerbosity();
+	MiceMenEventLog.SetVerbosity(ELogVerbosity::Warning);
+
+	TArray<FMM_RulesBoard> Boards;
+	Boards.SetNum(SeedCount);
+	bool bBuiltBoards = true;
+	for (int Seed = 0; Seed < SeedCount && bBuiltBoards; Seed++)
+	{
+		bBuiltBoards = BuildSeededBoard(World, Seed, Boards[Seed]);
+
+		// Remove destroyed boards as they build up
+		if (Seed % 256 == 255)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	MiceMenEventLog.SetVerbosity(PreviousVerbosity);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!bBuiltBoards)
+	{
+		UE_LOG(MiceMenEventLog, Error, TEXT("UMM_OpeningBookCommandlet::Main | Failed to build the seeded boards!"));
+		return 2;
+	}
+
+	// Every search shares one table, each thread has its own search nodes
+	FMM_TranspositionTable Table;
+	Table.Resize(TableMegabytes);
+
+	TArray<TArray<FMM_OpeningBookEntry>> SeedEntries;
+	SeedEntries.SetNum(SeedCount);
+	FThreadSafeCounter SearchedCount;
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(SeedCount, [&](int32 Seed)
+	{
+		SearchOpening(Boards[Seed], ERulesTeam::E_TEAM_A, Table, SeedEntries[Seed]);
+		SearchOpening(Boards[Seed], ERulesTeam::E_TEAM_B, Table, SeedEntries[Seed]);
+
+		const int32 Searched = SearchedCount.Increment();
+		if (Searched % 256 == 0)
+		{
+			UE_LOG(MiceMenEventLog, Display, TEXT("UMM_OpeningBookCommandlet::Main | Searched %i of %i boards"), Searched, SeedCount);
+		}
+	});
+
+	TArray<FMM_OpeningBookEntry> Entries;
+	for (const TArray<FMM_OpeningBookEntry>& Entry : SeedEntries)
+	{
+		Entries.Append(Entry);
+	}
+
+	UE_LOG(MiceMenEventLog, Display, TEXT("UMM_OpeningBookCommandlet::Main | Searched %i boards %i turns ahead in %.1f seconds"),
+	       SeedCount, SearchDepth, FPlatformTime::Seconds() - StartTime);
+
+	return FMM_OpeningBook::Write(BookPath, Entries) ? 0 : 1;
+}
+
+// ################################ Book ################################
+
+bool UMM_OpeningBookCommandlet::BuildSeededBoard(UWorld* World, int BoardSeed, FMM_RulesBoard& OutBoard) const
+{
+	AMM_GridManager* GridManager = World->SpawnActor<AMM_GridManager>();
+	if (!GridManager)
+	{
+		return false;
+	}
+
+	// Seeded right before rebuilding, as in AMM_GameMode::SetupGridManager
+	GridManager->SetupGridVariables(GridSize, nullptr);
+	FMath::RandInit(BoardSeed);
+	GridManager->RebuildGrid(InitialMiceCount);
+
+	GridManager->BuildRulesBoard(OutBoard, InitialMiceCount);
+	GridManager->Destroy();
+	return true;
+}
+
+void UMM_OpeningBookCommandlet::SearchOpening(const FMM_RulesBoard& Board, ERulesTeam FirstTeam, FMM_TranspositionTable& Table, TArray<FMM_OpeningBookEntry>& OutEntries) const
+{
+	FMM_RulesSearch Search(Table);
+	FMM_SearchSettings Settings;
+	Settings.MaxDepth = SearchDepth;
+
+	FMM_RulesBoard LineBoard = Board;
+	FMM_SameColumnLimits ColumnLimits;
+	ERulesTeam Team = FirstTeam;
+	for (int Ply = 0; Ply < BookPlies && !LineBoard.IsGameOver(); Ply++)
+	{
+		FMM_SearchMove Move;
+		if (!Search.FindBestMove(LineBoard, Team, ColumnLimits, Settings, Move))
+		{
+			return;
+		}
+
+		// Keyed by what the player knows during a game, which is only their own moved columns
+		const int TeamIndex = Team == ERulesTeam::E_TEAM_A ? 0 : 1;
+		FMM_OpeningBookEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Key = FMM_OpeningBook::GetPositionKey(LineBoard, Team, ColumnLimits.LastMovedColumns[TeamIndex], ColumnLimits.SameMovedColumnCounts[TeamIndex], Settings.SameColumnMax);
+		Entry.Score = Search.GetRootScore();
+		Entry.Column = static_cast<int16>(Move.Column);
+		Entry.bUp = Move.bUp ? 1 : 0;
+		Entry.Depth = static_cast<uint8>(FMath::Clamp(SearchDepth, 0, 255));
+
+		// Follow the line to the other team's reply
+		ColumnLimits.RecordMove(Team, Move.Column);
+		LineBoard.PlayTurn(Team, Move.Column, Move.bUp);
+		Team = Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+	}
+}
@@ -0,0 +1,129 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectBase.h"
+#include "Grid/IntVector2D.h"
+
+/** Compiled out of shipping builds unless defined otherwise by the target */
+#ifndef MM_EVENT_LOG_ENABLED
+#define MM_EVENT_LOG_ENABLED !UE_BUILD_SHIPPING
+#endif
+
+/** Records a grid event, see FMM_EventLog::Record for the parameters */
+#if MM_EVENT_LOG_ENABLED
+#define MM_EVENT(...) FMM_EventLog::Get().Record(__VA_ARGS__)
+#else
+#define MM_EVENT(...)
+#endif
+
+/** Events recorded on the grid hot paths, the param meaning is noted per event */
+enum class EGridEvent : uint8
+{
+	E_NONE,
+
+	/** Slot taken by a block or element, param is the slot type */
+	E_SLOT_TAKEN,
+	/** Slot emptied */
+	E_SLOT_FREED,
+	/** Element moved in the grid object to the coordinates */
+	E_ELEMENT_MOVED,
+	/** Element coordinates updated */
+	E_ELEMENT_POSITION_UPDATED,
+	/** Element attached to a new column */
+	E_ELEMENT_COLUMN_CHANGED,
+	/** Column control spawned, coordinates are the column base */
+	E_COLUMN_ADDED,
+	/** Column moved in the grid object, param is the direction */
+	E_COLUMN_MOVED,
+	/** Last element of a moved column wrapped around, coordinates are its new slot */
+	E_COLUMN_WRAPPED,
+	/** Block removed when populating for sparseness */
+	E_BLOCK_REMOVED,
+	/** Mouse spawned, param is the team */
+	E_MOUSE_SPAWNED,
+	/** Mouse moved to the coordinates, param is the team */
+	E_MOUSE_MOVED,
+	/** Mouse reached its goal, param is the team */
+	E_MOUSE_GOAL,
+	/** Mice processed with the team going first, param is the team and the coordinates are unused */
+	E_TEAM_PROCESSING,
+
+	E_MAX
+};
+
+/** One event, kept small and trivially copyable so recording is a handful of stores */
+struct FMM_EventRecord
+{
+	/** Platform cycles when recorded */
+	uint64 Cycles = 0;
+
+	/** Unique id of the object involved, 0 if none */
+	uint32 ObjectId = 0;
+
+	int32 X = 0;
+
+	int32 Y = 0;
+
+	/** Event specific value, see EGridEvent */
+	int32 Param = 0;
+
+	EGridEvent Event = EGridEvent::E_NONE;
+};
+
+/**
+ * Ring buffer of the most recent grid events, replacing per element logging on hot paths.
+ * Recording only copies a record, formatting is deferred until the log is dumped with MiceMen.EventLog.Dump or MiceMen.EventLog.Save.
+ * Only used from the game thread.
+ */
+class MICEMEN_API FMM_EventLog
+{
+public:
+	/** Must be a power of two, oldest events are overwritten once full */
+	static constexpr uint32 Capacity = 1 << 16;
+
+	static FMM_EventLog& Get();
+
+	/**
+	* Records an event, overwriting the oldest if full.
+	* @param Object the object involved, only its id is stored
+	* @param Param event specific value, see EGridEvent
+	*/
+	FORCEINLINE void Record(EGridEvent Event, const FIntVector2D& Coord, const UObject* Object = nullptr, int32 Param = 0)
+	{
+		FMM_EventRecord& NewRecord = Records[WriteIndex & (Capacity - 1)];
+		NewRecord.Cycles = FPlatformTime::Cycles64();
+		NewRecord.ObjectId = Object ? Object->GetUniqueID() : 0;
+		NewRecord.X = Coord.X;
+		NewRecord.Y = Coord.Y;
+		NewRecord.Param = Param;
+		NewRecord.Event = Event;
+		WriteIndex++;
+	}
+
+	/** Amount of events currently stored */
+	uint32 Num() const { return FMath::Min<uint64>(WriteIndex, Capacity); }
+
+	/** Removes all stored events */
+	void Reset() { WriteIndex = 0; }
+
+	/** Formats the most recent events, oldest first */
+	void Dump(FOutputDevice& Ar, uint32 MaxEvents = Capacity) const;
+
+	/** Formats all stored events to a text file */
+	bool SaveToFile(const FString& FilePath) const;
+
+	static const TCHAR* GetEventName(EGridEvent Event);
+
+protected:
+	FMM_EventLog();
+
+	/** Formats a single record, times are relative to the given cycles */
+	static FString FormatRecord(const FMM_EventRecord& Record, uint64 StartCycles);
+
+	TArray<FMM_EventRecord> Records;
+
+	/** Total events recorded, the next record is written at this index wrapped to the capacity */
+	uint64 WriteIndex = 0;
+};
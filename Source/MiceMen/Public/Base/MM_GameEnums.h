@@ -77,6 +77,19 @@ enum class EAIDifficulty : uint8
 
 	E_BASIC			UMETA(DisplayName = "Basic"),
 	E_ADVANCED		UMETA(DisplayName = "Advanced"),
+	E_EXPERT		UMETA(DisplayName = "Expert"),
 
 	E_MAX			UMETA(DisplayName = "Max"),
-};
\ No newline at end of file
+};
+
+/** File format turn telemetry records are written in */
+UENUM(BlueprintType)
+enum class ETelemetryFormat : uint8
+{
+	/** Comma separated values, with a header row per file */
+	E_CSV			UMETA(DisplayName = "CSV"),
+	/** One JSON object per line */
+	E_JSON			UMETA(DisplayName = "JSON Lines"),
+
+	E_MAX			UMETA(DisplayName = "Max"),
+};
@@ -6,6 +6,9 @@
 #include "GameFramework/GameModeBase.h"
 #include "Grid/IntVector2D.h"
 #include "Base/MM_GameEnums.h"
+#include "Base/MM_TurnTelemetry.h"
+#include "Rules/MM_TranspositionTable.h"
+#include "Rules/MM_OpeningBook.h"
 #include "MM_GameMode.generated.h"
 
 class APlayerController;
@@ -62,6 +65,16 @@ public:
 	UFUNCTION(BlueprintPure)
 	EAIDifficulty GetCurrentAIDifficulty() const { return CurrentAIDifficulty; }
 
+	/** Search results shared by the expert AI players, kept between turns */
+	FMM_TranspositionTable& GetAITranspositionTable() { return AITranspositionTable; }
+
+	/** Searched first moves for the seeded boards, empty if no book was found */
+	const FMM_OpeningBook& GetOpeningBook() const { return OpeningBook; }
+
+	/** Seed the current board was built from, -1 if the board was not seeded */
+	UFUNCTION(BlueprintPure)
+	int GetCurrentBoardSeed() const { return CurrentBoardSeed; }
+
 protected:
 	/** Called when the game is ready and game play mode can be chosen */
 	virtual void GameReady();
@@ -89,6 +102,10 @@ public:
 	UFUNCTION(BlueprintPure)
 	AMM_GridManager* GetGridManager();
 
+	/** The grid size used when no AMM_WorldGrid exists in the level */
+	UFUNCTION(BlueprintPure)
+	FIntVector2D GetDefaultGridSize() const { return DefaultGridSize; }
+
 protected:
 	/** Creates grid and basic setup, uses AMM_WorldGrid to position the grid, returns true if succesful*/
 	bool SetupGridManager();
@@ -118,6 +135,22 @@ protected:
 
 #pragma endregion
 
+#pragma region Telemetry
+
+public:
+	/** Whether turn records are currently being written */
+	UFUNCTION(BlueprintPure)
+	bool IsRecordingTurnTelemetry() const { return TelemetryWriter.IsValid(); }
+
+protected:
+	/** Starts the background writer if telemetry is enabled, through bRecordTurnTelemetry or -TurnTelemetry */
+	void StartTurnTelemetry();
+
+	/** Queues the record for the completed turn to be written */
+	void RecordTurnTelemetry(const AMM_PlayerController* Player);
+
+#pragma endregion
+
 #pragma region Teams
 
 public:
@@ -174,6 +207,33 @@ public:
 
 	void ForceEndNoMoves();
 
+	/** Turns taken since stalemate began, -1 if not in stalemate */
+	int GetStalemateCount() const { return StalemateCount; }
+
+#pragma endregion
+
+#pragma region Simulation Speed
+
+public:
+	/**
+	* Sets the playback speed for column and mouse animations.
+	* Only affects visuals, turns resolve the same regardless of speed or frame rate.
+	* @param NewSimulationSpeed - multiplier clamped between 1 and MaxSimulationSpeed
+	*/
+	UFUNCTION(BlueprintCallable)
+	void SetSimulationSpeed(float NewSimulationSpeed);
+
+	UFUNCTION(BlueprintPure)
+	float GetSimulationSpeed() const { return SimulationSpeed; }
+
+	/** Toggles skipping column and mouse animations, so turns resolve as soon as they are made */
+	UFUNCTION(BlueprintCallable)
+	void SetInstantVisuals(bool bEnabled);
+
+	/** Whether animations should be skipped, either from instant visuals or the test game type */
+	UFUNCTION(BlueprintPure)
+	bool IsInstantVisuals() const;
+
 #pragma endregion
 
 //-------------------------------------------------------
@@ -189,6 +249,26 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	int InitialMiceCount = 12;
 
+	/** Memory for the expert AI's search results, 0 searches without storing results */
+	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0"))
+	int AITranspositionTableMegabytes = 16;
+
+	/** Turns the expert AI searches ahead, counting both teams' turns */
+	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1", ClampMax = "16"))
+	int ExpertSearchDepth = 3;
+
+	/**
+	* When above 0, each board is built from one of this many seeds, so its opening can be found in the opening book.
+	* 0 builds a new random board every game, the default, so the book is opt in: set a seed count and write the book for it
+	* with the MM_OpeningBook commandlet.
+	*/
+	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0"))
+	int BoardSeedCount = 0;
+
+	/** Book of first moves for the seeded boards, written by the MM_OpeningBook commandlet, relative to the content directory */
+	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly)
+	FString OpeningBookFile = TEXT("OpeningBook/MM_OpeningBook.bin");
+
 protected:
 	/** The current game play type */
 	UPROPERTY(BlueprintReadOnly)
@@ -198,6 +278,15 @@ protected:
 	UPROPERTY(BlueprintReadOnly)
 	EAIDifficulty CurrentAIDifficulty = EAIDifficulty::E_NONE;
 
+	/** Sized at the beginning of each game from AITranspositionTableMegabytes */
+	FMM_TranspositionTable AITranspositionTable;
+
+	/** Mapped from OpeningBookFile when play begins */
+	FMM_OpeningBook OpeningBook;
+
+	UPROPERTY(BlueprintReadOnly)
+	int CurrentBoardSeed = -1;
+
 	/** The current team points, Team ID to number of points */
 	UPROPERTY(BlueprintReadOnly)
 	TMap<ETeam, int> TeamPoints;
@@ -208,6 +297,48 @@ protected:
 
 #pragma endregion
 
+#pragma region Simulation Speed Variables
+
+public:
+	/** The highest multiplier allowed for the simulation speed */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	float MaxSimulationSpeed = 100.0f;
+
+protected:
+	/** Multiplier for column and mouse animation playback, 1 being normal speed */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1.0", ClampMax = "100.0"))
+	float SimulationSpeed = 1.0f;
+
+	/** When true column and mouse animations are skipped, elements are placed at their final positions */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bInstantVisuals = false;
+
+#pragma endregion
+
+#pragma region Telemetry Variables
+
+public:
+	/** Writes a record for every completed turn to Saved/Telemetry, can also be enabled with -TurnTelemetry */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	bool bRecordTurnTelemetry = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	ETelemetryFormat TelemetryFormat = ETelemetryFormat::E_CSV;
+
+	/** Records written to a file before the next file is started */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int TelemetryRecordsPerFile = 10000;
+
+protected:
+	/** Background writer for the turn records, only valid while recording */
+	TUniquePtr<FMM_TurnTelemetryWriter> TelemetryWriter;
+
+	/** Turns completed since the game began */
+	UPROPERTY(BlueprintReadOnly)
+	int CurrentTurnIndex = 0;
+
+#pragma endregion
+
 #pragma region Player Variables
 
 protected:
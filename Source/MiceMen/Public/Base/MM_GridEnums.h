@@ -18,4 +18,16 @@ enum class EDirection : uint8
 	E_DOWN			UMETA(DisplayName = "Down"),
 
 	E_MAX			UMETA(DisplayName = "Max"),
-};
\ No newline at end of file
+};
+
+/** What a grid slot is taken up by, stored per slot so the logical board does not need an actor for each element */
+UENUM(BlueprintType)
+enum class EGridSlotType : uint8
+{
+	E_EMPTY			UMETA(DisplayName = "Empty"),
+
+	E_BLOCK			UMETA(DisplayName = "Block"),
+	E_MOUSE			UMETA(DisplayName = "Mouse"),
+
+	E_MAX			UMETA(DisplayName = "Max"),
+};
@@ -0,0 +1,139 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "Base/MM_GameEnums.h"
+#include "Base/MM_GridEnums.h"
+
+class FRunnableThread;
+class FEvent;
+
+/**
+ * Stats for one completed turn, from the column move through to the last mouse settling.
+ * Times are in seconds.
+ */
+struct MICEMEN_API FMM_TurnRecord
+{
+	/** Turn number since the game began, starting at 0 */
+	int TurnIndex = 0;
+
+	ETeam Team = ETeam::E_NONE;
+
+	/** The column moved, -1 if no column was moved */
+	int Column = -1;
+
+	EDirection Direction = EDirection::E_NONE;
+
+	/** How many times all mice were processed before none could move */
+	int CascadePasses = 0;
+
+	/** Mice that moved at least one slot, counted once per move */
+	int MiceMoved = 0;
+
+	/** Mice that reached their goal this turn */
+	int GoalsScored = 0;
+
+	/** Time the AI spent choosing its move, 0 for players */
+	double AIThinkTime = 0.0;
+
+	/** Time resolving the mice after the column locked in, without waiting on visuals */
+	double ResolutionTime = 0.0;
+
+	/** Time spent waiting on the column to settle and mice movement visuals to play */
+	double VisualPlayoutTime = 0.0;
+
+	/** Column names in the same order as ToCSVRow */
+	static FString GetCSVHeader();
+
+	FString ToCSVRow() const;
+
+	/** The record as a single line JSON object */
+	FString ToJsonLine() const;
+};
+
+/**
+ * Writes turn records to rotating files on a background thread, so the game thread only queues them.
+ * Files are created in the given directory, named by session start time and file number.
+ */
+class MICEMEN_API FMM_TurnTelemetryWriter : public FRunnable
+{
+public:
+	/**
+	* Starts the writer thread.
+	* @param InDirectory the directory files are written to
+	* @param InFormat the file format of records
+	* @param InMaxRecordsPerFile once reached, the next record starts a new file
+	*/
+	FMM_TurnTelemetryWriter(const FString& InDirectory, ETelemetryFormat InFormat, int InMaxRecordsPerFile);
+
+	/** Stops the thread after writing all queued records */
+	virtual ~FMM_TurnTelemetryWriter() override;
+
+	/** Queues a record to be written, only to be called from the game thread */
+	void AddRecord(const FMM_TurnRecord& Record);
+
+#pragma region Runnable
+
+public:
+	virtual uint32 Run() override;
+
+	virtual void Stop() override;
+
+#pragma endregion
+
+#pragma region Files
+
+protected:
+	/** Writes all queued records to the current file, rotating as needed */
+	void WritePendingRecords();
+
+	/** Closes the current file and opens the next one */
+	void OpenNextFile();
+
+	/** Writes a line to the current file as UTF-8 */
+	void WriteLine(const FString& Line) const;
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Thread Variables
+
+protected:
+	/** Single producer (game thread), single consumer (writer thread) */
+	TQueue<FMM_TurnRecord, EQueueMode::Spsc> PendingRecords;
+
+	/** Wakes the writer thread when records are queued or stopping */
+	FEvent* WakeEvent = nullptr;
+
+	FRunnableThread* Thread = nullptr;
+
+	FThreadSafeBool bStopping;
+
+#pragma endregion
+
+#pragma region File Variables
+
+protected:
+	FString Directory;
+
+	ETelemetryFormat Format = ETelemetryFormat::E_CSV;
+
+	int MaxRecordsPerFile = 10000;
+
+	/** Session start time, shared by all files written by this writer */
+	FString SessionName;
+
+	/** Only accessed by the writer thread */
+	TUniquePtr<FArchive> CurrentFile;
+
+	int RecordsInCurrentFile = 0;
+
+	int FileIndex = 0;
+
+#pragma endregion
+};
@@ -80,6 +80,9 @@ public:
 	UFUNCTION(BlueprintPure)
 	EDirection GetCurrentDirection() const { return CurrentDirectionChange; }
 
+	/** Seconds the column took to settle into its slot after it was last released */
+	double GetLastSettleTime() const { return LastSettleTime; }
+
 protected:
 	UFUNCTION(BlueprintNativeEvent)
 	void BN_DirectionChanged(EDirection NewDirection);
@@ -148,6 +151,11 @@ protected:
 	UPROPERTY(BlueprintReadOnly)
 	FVector OriginalLocation;
 
+	/** Platform time the column was released, or grabbed until it is released, for the settle time */
+	double ReleaseTime = 0.0;
+
+	double LastSettleTime = 0.0;
+
 #pragma endregion
 
 #pragma region Interaction Variables
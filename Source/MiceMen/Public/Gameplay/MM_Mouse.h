@@ -43,21 +43,40 @@ public:
 	UFUNCTION(BlueprintPure)
 	ETeam GetTeam() const { return CurrentTeam; };
 
+	virtual EGridSlotType GetSlotType() const override { return EGridSlotType::E_MOUSE; }
+
 #pragma endregion
 
 #pragma region Movement
 
 public:
-	/** Attempt to move the mouse, return true is movement successful */
-	bool AttemptPerformMovement();
+	/**
+	* Moves the mouse along a path already walked, such as from the rules board's cascade, instead of walking it again.
+	* @param Path the movement starting at the mouse's current position
+	* @return false if the path doesn't start at the mouse or has no movement
+	*/
+	bool PerformMovementAlongPath(const TArray<FIntVector2D>& Path);
 
 	/** Gets a valid path for this mouse, horizontal direction based on the team to move towards */
 	UFUNCTION(BlueprintCallable)
 	virtual TArray<FIntVector2D> GetMovementPath() const;
 
+	/** Fills the path without allocating when the array has capacity, starting with the current position */
+	void FindMovementPath(TArray<FIntVector2D>& OutPath) const;
+
+	/** Amount of slots the mouse would move, without storing the path */
+	int GetMovementStepCount() const;
+
+	/** Whether the last movement was applied instantly without playing the visual movement */
+	UFUNCTION(BlueprintPure)
+	bool HasMovedInstantly() const { return bMovedInstantly; }
+
+	/** Platform time the current movement visuals started, 0 if the last attempt didn't play visuals */
+	double GetVisualMovementStartTime() const { return VisualMovementStartTime; }
+
 protected:
-	/** Move mouse to next valid position, returns true if mouse moved */
-	virtual bool BeginMove(FIntVector2D& NewPosition);
+	/** Plays the movement visuals along the path, or places the mouse at its end if they are skipped */
+	void StartMovementVisuals(const TArray<FIntVector2D>& Path);
 
 	/**
 	 * Override for visual movement,
@@ -71,6 +90,16 @@ protected:
 	/** Update the grid based on the new position */
 	void ProcessUpdatedPosition(const FIntVector2D& NewPosition);
 
+	/** Whether the movement visuals to the final position should be skipped, placing the mouse straight at its final position */
+	bool ShouldSkipMovementVisuals(const FIntVector2D& FinalPosition) const;
+
+	/**
+	* Walks the movement path from the current position.
+	* @param OutPath if set, stores each position after the current position
+	* @return the final position
+	*/
+	FIntVector2D WalkMovementPath(TArray<FIntVector2D>* OutPath, int& OutStepCount) const;
+
 #pragma endregion
 
 #pragma region Goal
@@ -91,7 +120,7 @@ protected:
 #pragma region Debug
 
 public:
-	/** Displays a path in world space using colored boxes, increasing in size down the path */
+	/** Displays a path in world space as connected lines, through the grid manager's debug visuals */
 	UFUNCTION(BlueprintCallable)
 	void DisplayDebugPath(const TArray<FIntVector2D>& ValidPath) const;
 
@@ -118,6 +147,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bDisplayDebugPath = false;
 
+protected:
+	/** Set when the last movement skipped visuals, as the movement delegate will not be fired */
+	bool bMovedInstantly = false;
+
+	double VisualMovementStartTime = 0.0;
+
+	/** World space positions of the movement path, reused for the movement visuals */
+	TArray<FVector> WorldPathScratch;
+
 #pragma endregion
 
 #pragma region Goal Variables
@@ -0,0 +1,79 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/IntVector2D.h"
+#include "Base/MM_GameEnums.h"
+#include "Base/MM_GridEnums.h"
+#include "MM_CascadePreview.generated.h"
+
+class AMM_Mouse;
+
+/** One mouse movement of a previewed cascade */
+USTRUCT(BlueprintType)
+struct FMM_PreviewMouseMove
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	AMM_Mouse* Mouse = nullptr;
+
+	/** Grid coordinates of the movement, starting where the mouse is before it moves */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FIntVector2D> Path;
+
+	/** The movement ends at the mouse's goal */
+	UPROPERTY(BlueprintReadOnly)
+	bool bScores = false;
+};
+
+/**
+ * The full cascade a column move would cause, simulated on a copy of the board while the column is dragged.
+ * Holds the path of every mouse movement in the order they play, so the cascade can be shown as ghost paths
+ * and played straight away once the move is committed.
+ */
+USTRUCT(BlueprintType)
+struct FMM_CascadePreview
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int Column = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly)
+	EDirection Direction = EDirection::E_NONE;
+
+	/** Team making the move, whose mice go first in each pass */
+	UPROPERTY(BlueprintReadOnly)
+	ETeam Team = ETeam::E_NONE;
+
+	/** Every mouse movement in order, a mouse can move more than once */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FMM_PreviewMouseMove> Moves;
+
+	/** Cascade passes until no mice moved, including the final pass */
+	UPROPERTY(BlueprintReadOnly)
+	int CascadePasses = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int TeamAGoals = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int TeamBGoals = 0;
+
+	/** The move ends the game, by completing all mice, leaving no valid moves or running out the stalemate */
+	UPROPERTY(BlueprintReadOnly)
+	bool bEndsGame = false;
+
+	/** Winning team if the move ends the game, none for a tie */
+	UPROPERTY(BlueprintReadOnly)
+	ETeam Winner = ETeam::E_NONE;
+
+	bool IsValid() const { return Column != INDEX_NONE && Direction != EDirection::E_NONE; }
+
+	bool IsForMove(int InColumn, EDirection InDirection, ETeam InTeam) const
+	{
+		return IsValid() && Column == InColumn && Direction == InDirection && Team == InTeam;
+	}
+};
@@ -0,0 +1,119 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/IntVector2D.h"
+
+/**
+ * Binary indexed (Fenwick) tree of counts, giving prefix sums and updates in O(log n).
+ * Indices are zero based, the internal tree is one based.
+ */
+struct MICEMEN_API FMM_FenwickTree
+{
+public:
+	/** Sizes the tree with every entry set to the initial value, built in O(n) */
+	void Init(int InNum, int InitialValue);
+
+	void Empty();
+
+	/** Adds the delta to the entry at the index */
+	void Add(int Index, int Delta);
+
+	/** Sum of entries [0, Index], 0 if the index is below 0 */
+	int PrefixSum(int Index) const;
+
+	/** Sum of entries [First, Last] inclusive */
+	int RangeSum(int First, int Last) const { return PrefixSum(Last) - PrefixSum(First - 1); }
+
+	/**
+	* Finds the entry holding the given unit when walking the counts in order,
+	* which is the lowest index with a prefix sum greater than Unit.
+	* @return the entry index, INDEX_NONE if Unit is not below the total
+	*/
+	int FindByPrefix(int Unit) const;
+
+	int Num() const { return Tree.Num() - 1; }
+
+	SIZE_T GetAllocatedSize() const { return Tree.GetAllocatedSize(); }
+
+protected:
+	/** One based tree, entry 0 is unused */
+	TArray<int32> Tree;
+
+	/** Highest power of two not above the number of entries, used to descend the tree */
+	int HighestStep = 0;
+};
+
+/**
+ * Index of the free slots in a grid, partitioned by column.
+ * Keeps a tree of free counts per column and a tree of free rows within each column,
+ * so counting or picking the n-th free slot in a column range is O(log n) rather than a walk of all free slots.
+ */
+struct MICEMEN_API FMM_FreeSlotIndex
+{
+#pragma region Setup
+
+public:
+	/** Sizes the index for the grid with every slot free */
+	void Setup(const FIntVector2D& InGridSize);
+
+	void Empty();
+
+	SIZE_T GetAllocatedSize() const;
+
+#pragma endregion
+
+#pragma region Slots
+
+public:
+	/** Marks the slot as free or taken, does nothing if unchanged */
+	void SetFree(const FIntVector2D& Coord, bool bFree);
+
+	bool IsFree(const FIntVector2D& Coord) const { return FreeBits[Coord.X * GridSize.Y + Coord.Y]; }
+
+	/** Total free slots in the grid */
+	int Num() const { return ColumnCounts.Num() > 0 ? ColumnCounts.PrefixSum(GridSize.X - 1) : 0; }
+
+	/** Lists every free slot, column by column */
+	void GetFreeSlots(TArray<FIntVector2D>& OutFreeSlots) const;
+
+#pragma endregion
+
+#pragma region Range Queries
+
+public:
+	/** Counts the free slots within the inclusive range, clamped to the grid */
+	int CountInRange(int MinX, int MaxX, int MinY, int MaxY) const;
+
+	/**
+	* Finds the n-th free slot within the inclusive range, clamped to the grid, ordered column by column then row.
+	* @param SlotNumber zero based, must be below CountInRange for the same range
+	* @return false if there is no such slot
+	*/
+	bool FindInRange(int SlotNumber, int MinX, int MaxX, int MinY, int MaxY, FIntVector2D& OutCoord) const;
+
+protected:
+	/** True if the row range covers the whole column, letting the column counts be used directly */
+	bool IsFullColumnRange(int MinY, int MaxY) const { return MinY <= 0 && MaxY >= GridSize.Y - 1; }
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Index Variables
+
+protected:
+	FIntVector2D GridSize = FIntVector2D(0, 0);
+
+	/** Free state per slot, same layout as the grid array */
+	TBitArray<> FreeBits;
+
+	/** Free slot count for each column */
+	FMM_FenwickTree ColumnCounts;
+
+	/** Free rows of each column */
+	TArray<FMM_FenwickTree> ColumnRows;
+
+#pragma endregion
+};
@@ -0,0 +1,93 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/IntVector2D.h"
+
+/**
+ * Cached conversion between grid coordinates and world space.
+ * Stores the world location of the first slot and the world offset of one column and one row,
+ * so a conversion is a multiply and add rather than a full transform.
+ * Needs to be updated whenever the grid transform, size or element sizes change.
+ */
+struct MICEMEN_API FMM_GridCoordinateMapper
+{
+#pragma region Setup
+
+public:
+	/** Caches the grid basis from the grid transform and element sizes */
+	void Update(const FTransform& InGridTransform, const FIntVector2D& InGridSize, float ElementWidth, float ElementHeight);
+
+	/** Clears the cached basis, conversions will fail until updated */
+	void Invalidate() { bValid = false; }
+
+	bool IsValid() const { return bValid; }
+
+#pragma endregion
+
+#pragma region Coordinates To World
+
+public:
+	/** Converts a coordinate to the world location of the bottom center of the slot */
+	FORCEINLINE FVector CoordToWorld(const FIntVector2D& Coord) const
+	{
+		return Origin + ColumnStep * Coord.X + RowStep * Coord.Y;
+	}
+
+	/** Converts a coordinate to a world transform, with the rotation and scale of the grid */
+	FTransform CoordToWorldTransform(const FIntVector2D& Coord) const;
+
+	/** Converts all coordinates in one pass, OutLocations is resized to match */
+	void CoordsToWorld(TArrayView<const FIntVector2D> Coords, TArray<FVector>& OutLocations) const;
+
+#pragma endregion
+
+#pragma region World To Coordinates
+
+public:
+	/**
+	* Converts a world location to the grid coordinate it falls in.
+	* Columns are centered on their coordinate horizontally, rows start from their coordinate upwards.
+	* @param OutCoord the coordinate, set even when outside the grid
+	* @return true if the location is within the grid
+	*/
+	bool WorldToCoord(const FVector& WorldLocation, FIntVector2D& OutCoord) const;
+
+	/** Intersects a world space ray with the grid plane, returns false if the ray is parallel or facing away */
+	bool IntersectGridPlane(const FVector& RayOrigin, const FVector& RayDirection, FVector& OutHitLocation) const;
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Cached Variables
+
+protected:
+	/** The grid transform, used for rotation and scale of converted transforms */
+	FTransform GridTransform = FTransform::Identity;
+
+	/** World location of coordinate (0, 0) */
+	FVector Origin = FVector::ZeroVector;
+
+	/** World offset for moving one column along */
+	FVector ColumnStep = FVector::ZeroVector;
+
+	/** World offset for moving one row up */
+	FVector RowStep = FVector::ZeroVector;
+
+	/** Column step divided by its squared length, a dot product gives the column from a world offset */
+	FVector InverseColumnStep = FVector::ZeroVector;
+
+	/** Row step divided by its squared length, a dot product gives the row from a world offset */
+	FVector InverseRowStep = FVector::ZeroVector;
+
+	/** The normal of the plane the grid elements sit on */
+	FVector PlaneNormal = FVector::ForwardVector;
+
+	FIntVector2D GridSize = FIntVector2D(0, 0);
+
+	bool bValid = false;
+
+#pragma endregion
+};
@@ -0,0 +1,149 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Components/LineBatchComponent.h"
+#include "IntVector2D.h"
+#include "MM_GridDebugComponent.generated.h"
+
+class AMM_GridManager;
+class UMM_GridObject;
+
+/** A displayed debug path with its own lines, kept until its life time runs out */
+struct FMM_DebugPath
+{
+	TArray<FBatchedLine> Lines;
+	float RemainingLifeTime = 0.0f;
+};
+
+/**
+ * Batched debug visuals for the grid slots and mouse paths.
+ * The grid is built into a single line batch once, then only slots that change are updated,
+ * so the debug views can stay enabled on large grids.
+ */
+UCLASS(ClassGroup=(Debug))
+class MICEMEN_API UMM_GridDebugComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMM_GridDebugComponent();
+
+#pragma region Core
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void OnUnregister() override;
+
+#pragma endregion
+
+#pragma region Grid Display
+
+public:
+	/** Builds the visual for every slot in the grid, then listens for slot changes to update them */
+	void ShowGrid(AMM_GridManager* InGridManager, UMM_GridObject* InGridObject);
+
+	/** Removes the grid visual and stops listening for slot changes */
+	void HideGrid();
+
+	UFUNCTION(BlueprintPure)
+	bool IsGridShown() const { return DisplayedGridObject != nullptr; }
+
+protected:
+	/** Stores the changed slot, to be updated on the next tick */
+	void HandleSlotChanged(const FIntVector2D& Coord);
+
+	/** Adds the lines for one slot marker */
+	void AddSlotLines(TArray<FBatchedLine>& Lines, const FIntVector2D& Coord) const;
+
+	/** Updates the colour of an existing slot marker in the line batch */
+	void UpdateSlotLines(const FIntVector2D& Coord);
+
+	/** The colour representing the element in the slot */
+	FLinearColor GetSlotColour(const FIntVector2D& Coord) const;
+
+#pragma endregion
+
+#pragma region Path Display
+
+public:
+	/** Draws a coordinate path as connected lines, removed after PathLifeTime */
+	void DrawPath(const TArray<FIntVector2D>& Path);
+
+protected:
+	/** Replaces the path lines at the end of the batch with the active paths */
+	void RebuildPathLines();
+
+#pragma endregion
+
+#pragma region Helpers
+
+protected:
+	/** Creates the line batcher on first use */
+	ULineBatchComponent* GetLineBatcher();
+
+	/** The world location of the marker for a slot */
+	FVector GetSlotLocation(const FIntVector2D& Coord) const;
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Display Variables
+
+public:
+	/** Half size of the marker drawn for each slot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SlotMarkerSize = 25.0f;
+
+	/** How long a path stays displayed in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float PathLifeTime = 5.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float LineThickness = 3.0f;
+
+protected:
+	/** Holds all debug lines, grid slot lines first followed by the path lines */
+	UPROPERTY()
+	ULineBatchComponent* LineBatcher;
+
+#pragma endregion
+
+#pragma region Grid Variables
+
+protected:
+	UPROPERTY()
+	AMM_GridManager* GridManager;
+
+	/** The grid object currently displayed, null when the grid is hidden */
+	UPROPERTY()
+	UMM_GridObject* DisplayedGridObject;
+
+	FDelegateHandle SlotChangedHandle;
+
+	/** Slots changed since the last tick */
+	TSet<FIntVector2D> DirtySlots;
+
+	/** Number of lines at the start of the batch belonging to the grid slots */
+	int GridLineCount = 0;
+
+	/** The grid size when the slot lines were built, used to find the lines for a slot */
+	FIntVector2D DisplayedGridSize = FIntVector2D(0, 0);
+
+	static constexpr int LinesPerSlot = 4;
+
+#pragma endregion
+
+#pragma region Path Variables
+
+protected:
+	/** Paths currently displayed */
+	TArray<FMM_DebugPath> ActivePaths;
+
+#pragma endregion
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "IntVector2D.h"
+#include "Base/MM_GridEnums.h"
 #include "MM_GridElement.generated.h"
 
 class AMM_ColumnControl;
@@ -38,6 +39,10 @@ public:
 	UFUNCTION(BlueprintPure)
 	AMM_GridManager* GetGridManager();
 
+	/** What this element takes up its grid slot as, stored in the grid object's logical board */
+	UFUNCTION(BlueprintPure)
+	virtual EGridSlotType GetSlotType() const { return EGridSlotType::E_BLOCK; }
+
 #pragma endregion
 
 #pragma region Cleanup
@@ -5,10 +5,15 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Grid/IntVector2D.h"
+#include "Grid/MM_GridCoordinateMapper.h"
+#include "Grid/MM_PathBatch.h"
+#include "Grid/MM_CascadePreview.h"
+#include "Base/MM_TurnTelemetry.h"
 #include "Base/MM_GameEnums.h"
 #include "Base/MM_GameMode.h"
 #include "Base/MM_GridEnums.h"
 #include "Player/MM_PlayerController.h"
+#include "Rules/MM_RulesBoard.h"
 #include "MM_GridManager.generated.h"
 
 class AMM_ColumnControl;
@@ -16,7 +21,12 @@ class AMM_Mouse;
 class AMM_GridElement;
 class AMM_GridBlock;
 class UMM_GridObject;
+class UMM_GridDebugComponent;
+class UMM_GridVisualsComponent;
 class AMM_GameMode;
+struct FMM_SearchMove;
+enum class EPuzzleResult : uint8;
+template <int32 Width, int32 Height> class TMM_FixedBoard;
 
 /**
  * Handles the main grid operations, such as setup and moving blocks
@@ -29,6 +39,14 @@ class MICEMEN_API AMM_GridManager : public AActor
 public:
 	AMM_GridManager();
 
+	/** Batched debug visuals for the grid and mouse paths */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	UMM_GridDebugComponent* DebugGridComponent;
+
+	/** Pooled block visuals and visibility of the columns in view */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	UMM_GridVisualsComponent* GridVisualsComponent;
+
 #pragma region Core
 
 public:
@@ -37,6 +55,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void PostInitializeComponents() override;
+
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
 #pragma endregion
@@ -44,20 +64,49 @@ protected:
 #pragma region Stalemate
 
 public:
-	/** A check for if only one mouse per team exists */
+	/** A check for if only one mouse per team exists, decided by the rules board */
 	UFUNCTION(BlueprintPure)
 	bool IsStalemate() const;
 
-	/** When a stalemate win condition occurs, get the further ahead mouse as the winning team */
+	/** When a stalemate win condition occurs, get the further ahead mouse as the winning team, decided by the rules board */
 	UFUNCTION(BlueprintPure)
 	ETeam GetWinningStalemateTeam(int& DistanceWonBy) const;
 
-	/** Check if mice have taken up opposite columns resulting in no way to get passed, so no moves to finish the game */
+	/**
+	* Check if no mouse of either team can reach its goal under any sequence of column moves, so no moves can finish the game.
+	* Decided by the rules board.
+	*/
 	UFUNCTION(BlueprintPure)
 	bool CheckNoValidMoves();
 
 #pragma endregion
 
+#pragma region Rules Board
+
+public:
+	/**
+	* Copies the board, mice and game state into a rules board, to simulate from the current state without actors.
+	* @param MicePerTeam mice a team needs to complete to win, only used without a game mode, defaulting to the team's total mice
+	*/
+	void BuildRulesBoard(FMM_RulesBoard& OutBoard, int MicePerTeam = 0) const;
+
+	/** Finds the mouse of each of the rules board's mice by where they are, for a board just built before anything moves */
+	void CollectRulesBoardMice(const FMM_RulesBoard& Board, TArray<AMM_Mouse*>& OutBoardMice) const;
+
+	/** Copies the blocks and mice into a board with its size fixed at compile time, only defined for the sizes the grid manager specializes */
+	template <int32 Width, int32 Height>
+	void BuildFixedBoard(TMM_FixedBoard<Width, Height>& OutBoard) const;
+
+	/**
+	* Finds the fewest moves of the team alone that bring all of its mice to their goal, from the current board.
+	* Only the default board size is solved.
+	* @param MaxMoves longest sequence of moves searched for
+	* @param OutMoves the moves in order when solved
+	*/
+	EPuzzleResult SolvePuzzle(ETeam Team, int MaxMoves, TArray<FMM_SearchMove>& OutMoves) const;
+
+#pragma endregion
+
 #pragma region Grid Setup
 
 public:
@@ -73,6 +122,9 @@ public:
 	UFUNCTION(BlueprintPure)
 	FIntVector2D GetGridSize() const { return GridSize; }
 
+	/** The logical board, null before the grid is created */
+	UMM_GridObject* GetGridObject() const { return GridObject; }
+
 protected:
 	/** Handles grid cleanup, removing and clearing objects */
 	void GridCleanUp();
@@ -83,8 +135,8 @@ protected:
 	/** Center blocks with a set pattern either side of the center gap so mice don't initially cross over */
 	bool IsCoordInCenterGroup(const FIntVector2D& NewCoord) const;
 
-	/** Decides what element to place, either block or empty */
-	void PlaceGridElement(const FIntVector2D& NewCoord, AMM_ColumnControl* ColumnControl);
+	/** Decides what to place in the logical board, either block or empty */
+	void PlaceGridElement(const FIntVector2D& NewCoord);
 
 	/** Places initial mice for each team, based on MicePerTeam */
 	void PopulateTeams(int MicePerTeam);
@@ -94,7 +146,10 @@ protected:
 #pragma region Mouse Processing
 
 public:
-	/** Starts processing all mice, starting with the current players team */
+	/**
+	* Starts processing all mice, starting with the current players team.
+	* The cascade is resolved on the rules board, then each movement is played in order as a previewed cascade would be.
+	*/
 	void BeginProcessMice();
 
 	/** Removes a mouse from the active list and teams */
@@ -106,24 +161,30 @@ public:
 	/** Attempts to move a grid element to a new coordinate, returns true if successful */
 	bool MoveGridElement(AMM_GridElement* GridElement, const FIntVector2D& NewCoord) const;
 
-	TMap<ETeam, TArray<AMM_Mouse*>> GetMiceTeams() { return MiceTeams; }
+	const TMap<ETeam, TArray<AMM_Mouse*>>& GetMiceTeams() const { return MiceTeams; }
 
-protected:
-	/** Find all the mice to process and store them in order of position and team */
-	void StoreOrderedMiceToProcess();
+	/** Stats for the last turn to finish processing mice, the game mode adds the turn and player details */
+	const FMM_TurnRecord& GetLastTurnRecord() const { return LastTurnRecord; }
 
-	/* Add mouse to array based on positioning so lower forward mice go first */
-	void InsertMouseByOrder(AMM_Mouse* TeamMouse, TArray<AMM_Mouse*>& CurrentTeamMiceToProcess);
+	/**
+	* Completes the stats for the current turn as the last turn record, and resets for the next turn.
+	* Called once all mice are processed, or by the game mode when a mouse wins the game part way through the turn.
+	*/
+	void FinishTurnRecord();
+
+	/**
+	* Resolves all mice in one call without visuals or the game mode, repeating passes until no mice move or a team wins.
+	* The cascade is resolved on the rules board and applied to the mice.
+	* Used outside of turns, such as for benchmarks and simulations.
+	* @param FirstTeam the team whose mice are processed first in each pass
+	* @return the amount of passes made, including the final pass with no movement
+	*/
+	int ResolveMiceImmediately(ETeam FirstTeam);
 
+protected:
 	/** Ends the players turn when there are no more mice to process. */
 	void HandleMiceComplete();
 
-	/** Handles moving mouse and updating grid */
-	void ProcessMouse(AMM_Mouse* Mouse);
-
-	/** Checks mouse is valid to process, will continue to next mouse if it is not */
-	bool CheckMouse(AMM_Mouse* Mouse);
-
 	/** Called once a mouse has been processed */
 	UFUNCTION()
 	void HandleCompletedMouseMovement(AMM_Mouse* Mouse);
@@ -136,20 +197,55 @@ protected:
 #pragma region Column Processing
 
 public:
-	/** Moves the specified column in a direction, either up or down (1 or -1) */
-	void AdjustColumn(int Column, EDirection Direction);
+	/**
+	* Moves the specified column in a direction, either up or down (1 or -1)
+	* @return false if the column could not be moved in the grid object
+	*/
+	bool AdjustColumn(int Column, EDirection Direction);
 
 	/** Attempts to adjust the column in the grid object, updating the grid elements */
 	bool AdjustColumnInGridObject(int Column, EDirection Direction, AMM_GridElement*& LastElement) const;
 
+	/**
+	* Tests moving each candidate column up and down, scoring by the total movement of the team's mice.
+	* The grid is returned to its original state after each test.
+	* @param OutColumn the column with the highest score
+	* @param OutDirection the direction to move the column
+	* @return false if no move resulted in any movement
+	*/
+	bool FindBestColumnMove(ETeam Team, TArrayView<const int> CandidateColumns, int& OutColumn, EDirection& OutDirection) const;
+
+	/**
+	* Walks all of the team's mice in one call against the grid as it currently is, in the order they are stored.
+	* Each mouse is walked as if it moved alone, the same as each mouse's own movement path.
+	* @param OutBatch reset and filled with the team's mice, reusing its allocations
+	* @param bStorePaths whether to store each path in the batch
+	*/
+	void ComputeTeamPaths(ETeam Team, FMM_PathBatch& OutBatch, bool bStorePaths = false) const;
+
 	UFUNCTION(BlueprintPure)
 	bool IsTeamInColumn(int Column, ETeam Team) const;
 
 	UFUNCTION(BlueprintPure)
 	TArray<int> GetTeamColumns(ETeam Team) const;
 
+	/** Fills the columns the team can move, see GetTeamColumns, without allocating when the array has capacity */
+	void CollectTeamColumns(ETeam Team, TArray<int>& OutColumns) const;
+
 	UFUNCTION(BlueprintPure)
-	TMap<int, AMM_ColumnControl*> GetColumnControls() const { return ColumnControls; }
+	const TMap<int, AMM_ColumnControl*>& GetColumnControls() const { return ColumnControls; }
+
+	/** Gets the control for a column, null if the column doesn't exist */
+	UFUNCTION(BlueprintPure)
+	AMM_ColumnControl* GetColumnControl(int Column) const { return ColumnControls.FindRef(Column); }
+
+	/** Whether the column is visualized, always true unless the grid is virtualized and the column is out of view */
+	UFUNCTION(BlueprintPure)
+	bool IsColumnVisible(int Column) const;
+
+	/** Whether any column between the two columns (inclusive) is visualized */
+	UFUNCTION(BlueprintPure)
+	bool IsColumnRangeVisible(int FirstColumn, int LastColumn) const;
 
 protected:
 	/** Removes mouse from specified column, updating team/mouse variables */
@@ -158,6 +254,81 @@ protected:
 	/** Adds mouse to a specified column, updating team/mouse variables */
 	void AddMouseToColumn(int Column, AMM_Mouse* Mouse);
 
+	/** FindBestColumnMove on a board with the size fixed at compile time, used when the grid is one of the common sizes */
+	template <int32 Width, int32 Height>
+	bool FindBestColumnMoveOnFixedBoard(ETeam Team, TArrayView<const int> CandidateColumns, int& OutColumn, EDirection& OutDirection) const;
+
+#pragma endregion
+
+#pragma region Cascade Preview
+
+public:
+	/**
+	* Simulates the cascade of a column move on a copy of the board, leaving the grid untouched.
+	* @param OutPreview filled with every mouse movement of the cascade and how the game stands after it
+	* @return false if the column can't be moved
+	*/
+	bool SimulateColumnMove(int Column, EDirection Direction, ETeam Team, FMM_CascadePreview& OutPreview) const;
+
+	/**
+	* Simulates the cascade of the grid as it is on a copy of the board, for mice to process after the column has moved.
+	* @param OutPreview filled with every mouse movement of the cascade, without a column or direction as it is not shown
+	*/
+	void SimulateCascade(ETeam FirstTeam, FMM_CascadePreview& OutPreview) const;
+
+	/** Previews the current player's move of the column while it is dragged, clearing the preview for no direction */
+	void UpdateCascadePreview(int Column, EDirection Direction);
+
+	void ClearCascadePreview();
+
+	UFUNCTION(BlueprintPure)
+	const FMM_CascadePreview& GetCascadePreview() const { return CascadePreview; }
+
+	/**
+	* Plays the previewed cascade for the committed move instead of resolving it again, once the column has been adjusted.
+	* @return false if there is no preview for the move, so the mice should be processed with BeginProcessMice
+	*/
+	bool BeginPreviewedMice(int Column, EDirection Direction);
+
+protected:
+	/** Plays the next previewed movement, completing the turn after the last, or processing the mice again if the grid no longer matches */
+	void PlayNextPreviewMove();
+
+	/** Fills the preview's movements and outcome from a cascade resolved on the rules board */
+	static void FillCascadePreview(const FMM_RulesBoard& Board, TArrayView<AMM_Mouse* const> BoardMice, const FMM_RulesCascadeLog& CascadeLog,
+	                               const FMM_RulesTurnResult& Result, FMM_CascadePreview& OutPreview);
+
+	/** Called when the cascade preview changes, to show its ghost paths and outcome */
+	UFUNCTION(BlueprintImplementableEvent)
+	void BI_OnCascadePreviewUpdated(const FMM_CascadePreview& Preview);
+
+#pragma endregion
+
+#pragma region Simulation Speed
+
+public:
+	/** Scales animation playback of all columns and mice through their time dilation */
+	void ApplySimulationSpeed(float SimulationSpeed);
+
+protected:
+	/** Gets the current simulation speed from the game mode, defaulting to normal speed */
+	float GetSimulationSpeed() const;
+
+#pragma endregion
+
+#pragma region Coordinate Mapping
+
+public:
+	/** Cached mapping between coordinates and world space, kept in sync with the grid transform and size */
+	const FMM_GridCoordinateMapper& GetCoordinateMapper() const { return CoordinateMapper; }
+
+protected:
+	/** Recaches the coordinate mapping from the current grid transform and size */
+	void RefreshCoordinateMapper();
+
+	/** Bound to the root component so the coordinate mapping follows the grid if it moves */
+	void HandleGridTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
 #pragma endregion
 
 #pragma region Helpers
@@ -167,10 +338,35 @@ public:
 	UFUNCTION(BlueprintPure)
 	TArray<FVector> PathCoordToWorld(const TArray<FIntVector2D>& CoordPath) const;
 
+	/** Converts a coordinates path to world space, without allocating when the array has capacity */
+	void ConvertPathToWorld(TArrayView<const FIntVector2D> CoordPath, TArray<FVector>& OutWorldPath) const;
+
 	/** Helper for converting coordinates to world space */
 	UFUNCTION(BlueprintPure)
 	FTransform CoordToWorldTransform(const FIntVector2D& Coords) const;
 
+	/**
+	* Converts a world location to the grid coordinate it falls in.
+	* Columns are centered on their coordinate horizontally, rows start from their coordinate upwards.
+	* @param OutCoord the coordinate, set even when outside the grid
+	* @return true if the location is within the grid
+	*/
+	UFUNCTION(BlueprintPure)
+	bool WorldToCoord(const FVector& WorldLocation, FIntVector2D& OutCoord) const;
+
+	/**
+	* Intersects a world space ray with the grid, such as a deprojected cursor.
+	* @param OutCoord the coordinate hit, set even when outside the grid
+	* @param OutHitLocation the location on the grid plane
+	* @return true if the ray hit the grid plane within the grid
+	*/
+	UFUNCTION(BlueprintPure)
+	bool WorldRayToCoord(const FVector& RayOrigin, const FVector& RayDirection, FIntVector2D& OutCoord, FVector& OutHitLocation) const;
+
+	/** Intersects a world space ray with the plane the grid elements sit on, returns false if the ray is parallel or facing away */
+	UFUNCTION(BlueprintPure)
+	bool IntersectGridPlane(const FVector& RayOrigin, const FVector& RayDirection, FVector& OutHitLocation) const;
+
 	/** Direction along the grid the team goes */
 	UFUNCTION(BlueprintPure)
 	static EDirection GetDirectionFromTeam(ETeam Team);
@@ -200,11 +396,12 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void ToggleDebugVisualGrid();
 
+	/** Displays a coordinate path in world space through the debug component */
+	void DrawDebugPath(const TArray<FIntVector2D>& Path) const;
+
 protected:
-	/** Called on tick when the debug grid is enabled, to draw visuals representing grid elements */
-	void DisplayDebugGrid() const;
 
-	/** Checks all mice are included in the mice that are set to be processed */
+	/** Checks all mice are on the rules board the mice are processed with */
 	bool DebugCheckAllMiceProcessed() const;
 
 #pragma endregion
@@ -251,6 +448,9 @@ protected:
 	UPROPERTY(BlueprintReadOnly)
 	int TeamSize;
 
+	/** Cached coordinate to world mapping, see RefreshCoordinateMapper */
+	FMM_GridCoordinateMapper CoordinateMapper;
+
 	/** How sparse the block placement should be */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	float BlockSparseness = 0.4f;
@@ -276,8 +476,19 @@ protected:
 	UPROPERTY(BlueprintReadOnly)
 	TArray<AMM_Mouse*> CompletedMice;
 
-	/** Current Mice to process movement from a column change. */
-	TArray<AMM_Mouse*> MiceToProcessMovement;
+	/** Reused to resolve mice immediately on the rules board, so resolving doesn't allocate once sized */
+	FMM_RulesBoard ResolveBoardScratch;
+
+	FMM_RulesCascadeLog ResolveLogScratch;
+
+	/** Mouse of each of the scratch board's mice */
+	TArray<AMM_Mouse*> ResolveMiceScratch;
+
+	/** Path of the movement being applied, in grid coordinates */
+	TArray<FIntVector2D> ResolvePathScratch;
+
+	/** Reused by the AI column tests, mutable as the tests are const queries of the grid */
+	mutable FMM_PathBatch AIPathBatchScratch;
 
 	/**
 	* Active list of mice per team.
@@ -286,8 +497,17 @@ protected:
 	*/
 	TMap<ETeam, TArray<AMM_Mouse*>> MiceTeams;
 
-	/* Used to keep track of the moved mice in process, only once none have moved will it complete */
-	int CurrentProcessedMovedMiceCount = 0;
+	/** Stats for the turn being processed, from the column locking in */
+	FMM_TurnRecord CurrentTurnRecord;
+
+	/** Stats for the last completed turn */
+	FMM_TurnRecord LastTurnRecord;
+
+	/** Platform time the current turn's column locked in, 0 if not locked in */
+	double ColumnLockInTime = 0.0;
+
+	/** Time the current turn has waited on mice movement visuals */
+	double MousePlayoutTime = 0.0;
 
 #pragma endregion
 
@@ -319,6 +539,18 @@ protected:
 
 #pragma endregion
 
+#pragma region Cascade Preview Variables
+
+protected:
+	/** The cascade of the move being dragged, played when the move is committed */
+	UPROPERTY(BlueprintReadOnly)
+	FMM_CascadePreview CascadePreview;
+
+	/** Next previewed movement to play, INDEX_NONE when the mice are not playing a preview */
+	int NextPreviewMove = INDEX_NONE;
+
+#pragma endregion
+
 #pragma region References
 
 protected:
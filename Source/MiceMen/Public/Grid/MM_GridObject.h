@@ -6,10 +6,19 @@
 #include "UObject/NoExportTypes.h"
 #include "IntVector2D.h"
 #include "Base/MM_GridEnums.h"
+#include "Grid/MM_FreeSlotIndex.h"
+#include "Grid/MM_PathBatch.h"
+#include "Grid/MM_PathCache.h"
 #include "MM_GridObject.generated.h"
 
 class AMM_GridElement;
 
+/**
+ * Event for when the contents of a grid slot have changed
+ * @FIntVector2D the coordinates of the changed slot
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FGridSlotChangedDelegate, const FIntVector2D&);
+
 /**
  * The main control for the grids array and elements, with some helpers for coordinates and free slots
  */
@@ -27,6 +36,9 @@ public:
 	/** Empties grid objects and elements */
 	void CleanUp();
 
+	/** Memory allocated for the grid, slot types, free slots, landing rows and path cache */
+	SIZE_T GetAllocatedSize() const;
+
 #pragma endregion
 
 #pragma region Elements
@@ -39,6 +51,13 @@ public:
 	/** Sets a grid element in the grid array */
 	bool SetGridElement(const FIntVector2D& Coord, AMM_GridElement* GridElement);
 
+	/** Sets or clears a block in the logical board only, blocks have no actor and are visualized by the grid manager */
+	bool SetGridBlock(const FIntVector2D& Coord, bool bBlocked);
+
+	/** Returns what the slot at the given coordinates is taken up by, empty if not valid */
+	UFUNCTION(BlueprintPure)
+	EGridSlotType GetSlotType(const FIntVector2D& Coord) const;
+
 	bool MoveGridElement(const FIntVector2D& NewCoord, AMM_GridElement* GridElement);
 
 	/** Moves the column up or down by 1 and returns the last element */
@@ -81,6 +100,15 @@ protected:
 	/** Converts a coordinate to the index in the grid array */
 	int CoordToIndex(int X, int Y) const;
 
+	/** Stores the element and slot type at the coordinate, updating free slots */
+	void SetSlot(const FIntVector2D& Coord, AMM_GridElement* GridElement, EGridSlotType SlotType);
+
+	/** Updates the landing rows above a slot after it changed between empty and taken */
+	void UpdateLandingRowsAbove(const FIntVector2D& Coord);
+
+	/** Recalculates the landing rows of a whole column, used after the column rotates */
+	void RebuildColumnLandingRows(int Column);
+
 #pragma endregion
 
 #pragma region Free Slots
@@ -90,7 +118,10 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool FindFreeSlotInDirection(FIntVector2D& CurrentPosition, const FIntVector2D& Direction) const;
 
-	/** Will check for the lowest possible free slot below without passing through a taken element, and return true if its free, setting CurrentPosition */
+	/**
+	* Will check for the lowest possible free slot below without passing through a taken element, and return true if its free, setting CurrentPosition.
+	* Resolved from the landing rows, so the cost doesn't depend on the fall height
+	*/
 	UFUNCTION(BlueprintPure)
 	bool FindFreeSlotBelow(FIntVector2D& CurrentPosition) const;
 
@@ -100,7 +131,39 @@ public:
 
 	/** Lists the active free slots in the grid*/
 	UFUNCTION(BlueprintPure)
-	TArray<FIntVector2D> GetFreeSlots() const { return FreeSlots; }
+	TArray<FIntVector2D> GetFreeSlots() const;
+
+	/** The free slot index, for counting or picking free slots in a range without walking them */
+	const FMM_FreeSlotIndex& GetFreeSlotIndex() const { return FreeSlots; }
+
+#pragma endregion
+
+#pragma region Paths
+
+public:
+	/**
+	* Walks from the start by falling then stepping ahead until neither is possible, the movement rules for mice.
+	* Results are cached until a column the walk depended on changes, the walk is only repeated if the path is needed
+	* @param OutPath optional, each position after the start is added
+	* @param OutStepCount amount of falls and steps ahead
+	* @return the final position, the start if outside the grid
+	*/
+	FIntVector2D WalkPath(const FIntVector2D& Start, EDirection Direction, TArray<FIntVector2D>* OutPath, int& OutStepCount) const;
+
+	/**
+	* Walks every walker in the batch in one call, each against the grid as it currently is.
+	* Reads the slot types and landing rows directly, so there is no per mouse call through the actors.
+	* Without paths, walkers whose columns haven't changed use their cached results.
+	* @param bStorePaths whether to store each path in the batch, including its start
+	*/
+	void WalkPathBatch(FMM_PathBatch& Batch, EDirection Direction, bool bStorePaths = false) const;
+
+protected:
+	/**
+	* The walk shared by single and batch walks, the start is expected to be in the grid.
+	* @return amount of falls and steps ahead
+	*/
+	FORCEINLINE int WalkFrom(int32& X, int32& Y, int HorizontalStep, TArray<FIntVector2D>* OutPath) const;
 
 #pragma endregion
 
@@ -108,12 +171,22 @@ public:
 
 #pragma region Grid Variables
 
+public:
+	/** Called whenever a slot is set or an element moves in or out of a slot */
+	FGridSlotChangedDelegate OnSlotChanged;
+
 protected:
 	/**
 	* One dimensional array for two dimensional grid
 	*/
 	TArray<AMM_GridElement*> Grid;
 
+	/**
+	* What each slot is taken up by, using the same layout as the grid array.
+	* The logical board, includes blocks which have no element in the grid array
+	*/
+	TArray<EGridSlotType> SlotTypes;
+
 	/** The size of the grid */
 	UPROPERTY(BlueprintReadOnly)
 	FIntVector2D GridSize;
@@ -124,10 +197,19 @@ protected:
 
 protected:
 	/**
-	* List of available free slots updated by the grid.
+	* Index of available free slots updated by the grid, partitioned by column.
 	* Removes the need to iterate all slots
 	*/
-	TArray<FIntVector2D> FreeSlots;
+	FMM_FreeSlotIndex FreeSlots;
+
+	/**
+	* For each slot, the row an element falls to from it without passing through a taken slot, using the same layout as the grid array.
+	* Only depends on the slots below, so is kept up to date incrementally as slots change
+	*/
+	TArray<int32> LandingRows;
+
+	/** Walk results, updated by const walks so mutable */
+	mutable FMM_PathCache PathCache;
 
 #pragma endregion
 };
@@ -0,0 +1,156 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "IntVector2D.h"
+#include "MM_GridVisualsComponent.generated.h"
+
+class AMM_GridManager;
+class AMM_GridElement;
+class AMM_GridBlock;
+class UMM_GridObject;
+
+/** The block visuals currently representing one column */
+USTRUCT()
+struct FMM_ColumnVisuals
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AMM_GridBlock*> Blocks;
+};
+
+/**
+ * Visual representation of the logical board.
+ * Blocks only exist in the grid object, and are shown using pooled block actors for the columns in view.
+ * On large grids only the columns inside the camera view are visualized, mice outside the view are hidden and stop ticking.
+ */
+UCLASS(ClassGroup=(Grid))
+class MICEMEN_API UMM_GridVisualsComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMM_GridVisualsComponent();
+
+#pragma region Core
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+#pragma endregion
+
+#pragma region Grid Display
+
+public:
+	/** Visualizes the grid, only columns in view if the grid is wide enough to be virtualized */
+	void ShowGrid(AMM_GridManager* InGridManager, UMM_GridObject* InGridObject);
+
+	/** Returns all block visuals to the pool */
+	void HideGrid();
+
+	/** Lays out the block visuals for a column again, such as after its elements have moved */
+	void RefreshColumn(int Column);
+
+	/** Shows or hides an element based on whether its column is in view */
+	void RefreshElementVisibility(AMM_GridElement* GridElement) const;
+
+	/** Whether the column currently has a visual representation */
+	UFUNCTION(BlueprintPure)
+	bool IsColumnVisible(int Column) const { return Column >= VisibleColumnMin && Column <= VisibleColumnMax; }
+
+	/** Whether any column between the two columns (inclusive) currently has a visual representation */
+	UFUNCTION(BlueprintPure)
+	bool IsColumnRangeVisible(int FirstColumn, int LastColumn) const;
+
+	UFUNCTION(BlueprintPure)
+	bool IsVirtualized() const { return bVirtualized; }
+
+protected:
+	/**
+	* Finds the columns in view by intersecting the corners of the viewport with the grid plane.
+	* @return false if the view could not be bounded, such as a corner looking past the grid plane
+	*/
+	bool CalculateVisibleColumns(int& OutMinColumn, int& OutMaxColumn) const;
+
+	/** Shows the columns that have come into view and hides the ones that have left */
+	void UpdateVisibleColumns(int NewMinColumn, int NewMaxColumn);
+
+	/** Adds or removes the visual representation for all elements in a column */
+	void SetColumnVisible(int Column, bool bVisible);
+
+#pragma endregion
+
+#pragma region Pooling
+
+public:
+	/** Destroys every pooled block visual, such as when the grid is cleaned up and its size may change */
+	void EmptyBlockPool();
+
+protected:
+	/** Gets a block visual from the pool, spawning one if the pool is empty */
+	AMM_GridBlock* AcquireBlock(const FIntVector2D& Coord);
+
+	/** Hides a block visual and returns it to the pool */
+	void ReleaseBlock(AMM_GridBlock* Block);
+
+	/** Shows or hides an actor, disabling its tick while hidden */
+	static void SetActorVisualActive(AActor* Actor, bool bActive);
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Virtualization Variables
+
+public:
+	/** Grids with more columns than this only visualize the columns in view */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int VirtualizeAboveColumns = 40;
+
+	/** Extra columns visualized either side of the view, so elements are ready before they scroll in */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int VisibleColumnMargin = 2;
+
+protected:
+	/** Whether only the columns in view are visualized */
+	UPROPERTY(BlueprintReadOnly)
+	bool bVirtualized = false;
+
+	/** First column in view, inclusive */
+	UPROPERTY(BlueprintReadOnly)
+	int VisibleColumnMin = 0;
+
+	/** Last column in view, inclusive, less than the min when no columns are in view */
+	UPROPERTY(BlueprintReadOnly)
+	int VisibleColumnMax = -1;
+
+#pragma endregion
+
+#pragma region Pool Variables
+
+protected:
+	/** Block visuals per column, indexed by the column */
+	UPROPERTY()
+	TArray<FMM_ColumnVisuals> ColumnVisuals;
+
+	/** Hidden block visuals ready to be reused */
+	UPROPERTY()
+	TArray<AMM_GridBlock*> BlockPool;
+
+#pragma endregion
+
+#pragma region Grid Variables
+
+protected:
+	UPROPERTY()
+	AMM_GridManager* GridManager;
+
+	/** The grid object currently visualized, null when the grid is hidden */
+	UPROPERTY()
+	UMM_GridObject* DisplayedGridObject;
+
+#pragma endregion
+};
@@ -0,0 +1,103 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/IntVector2D.h"
+
+/**
+ * Start and result coordinates for walking many mice through the grid in one call.
+ * Stored as separate arrays per component so the walk loop reads and writes contiguous memory,
+ * and kept between calls so repeated walks reuse the allocations.
+ */
+struct FMM_PathBatch
+{
+#pragma region Setup
+
+public:
+	/** Removes all walkers, keeping the allocations */
+	void Reset()
+	{
+		StartX.Reset();
+		StartY.Reset();
+		FinalX.Reset();
+		FinalY.Reset();
+		StepCounts.Reset();
+		Paths.Reset();
+		PathOffsets.Reset();
+	}
+
+	/** Reserves room for the given amount of walkers, and path coordinates if paths are stored */
+	void Reserve(int WalkerCount, int PathCoordCount = 0)
+	{
+		StartX.Reserve(WalkerCount);
+		StartY.Reserve(WalkerCount);
+		FinalX.Reserve(WalkerCount);
+		FinalY.Reserve(WalkerCount);
+		StepCounts.Reserve(WalkerCount);
+		PathOffsets.Reserve(WalkerCount + 1);
+		Paths.Reserve(PathCoordCount);
+	}
+
+	/** Adds a walker starting at the coordinates, returning its index */
+	int AddWalker(const FIntVector2D& Start)
+	{
+		StartY.Add(Start.Y);
+		return StartX.Add(Start.X);
+	}
+
+	int Num() const { return StartX.Num(); }
+
+#pragma endregion
+
+#pragma region Results
+
+public:
+	FIntVector2D GetFinalPosition(int Index) const { return FIntVector2D(FinalX[Index], FinalY[Index]); }
+
+	/** Sum of all walkers' steps */
+	int GetTotalStepCount() const
+	{
+		int TotalStepCount = 0;
+		for (const int32 StepCount : StepCounts)
+		{
+			TotalStepCount += StepCount;
+		}
+		return TotalStepCount;
+	}
+
+	/** The walker's path including its start, empty if paths were not stored */
+	TArrayView<const FIntVector2D> GetPath(int Index) const
+	{
+		if (!PathOffsets.IsValidIndex(Index + 1))
+		{
+			return TArrayView<const FIntVector2D>();
+		}
+		return TArrayView<const FIntVector2D>(Paths.GetData() + PathOffsets[Index], PathOffsets[Index + 1] - PathOffsets[Index]);
+	}
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Batch Variables
+
+public:
+	TArray<int32> StartX;
+	TArray<int32> StartY;
+
+	/** Set by the walk, the final coordinates of each walker */
+	TArray<int32> FinalX;
+	TArray<int32> FinalY;
+
+	/** Set by the walk, the amount of falls and steps ahead of each walker */
+	TArray<int32> StepCounts;
+
+	/** Set by the walk if paths are stored, every walker's path one after another */
+	TArray<FIntVector2D> Paths;
+
+	/** Where each walker's path starts in Paths, with an extra entry for the end of the last path */
+	TArray<int32> PathOffsets;
+
+#pragma endregion
+};
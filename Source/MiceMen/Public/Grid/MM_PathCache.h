@@ -0,0 +1,100 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/IntVector2D.h"
+#include "Base/MM_GridEnums.h"
+
+/**
+ * Cache of walk results, keyed by start slot and direction.
+ * A walk only depends on which slots are taken in the columns it passes through and the column that stopped it,
+ * so each result stores the hash of those columns and is only reused while the hash is unchanged.
+ * Column hashes are combined through a tree, so checking a result is O(log n) in the columns rather than a new walk.
+ */
+struct MICEMEN_API FMM_PathCache
+{
+#pragma region Setup
+
+public:
+	/** Sizes the cache for the grid with every slot free and no stored results */
+	void Setup(const FIntVector2D& InGridSize);
+
+	void Empty();
+
+	SIZE_T GetAllocatedSize() const;
+
+#pragma endregion
+
+#pragma region Column Hashes
+
+public:
+	/** Updates the column hash for a slot changing between empty and taken */
+	void ToggleSlot(const FIntVector2D& Coord);
+
+	/** Recalculates a column's hash from its slot types, bottom first, used after the column rotates */
+	void RehashColumn(int Column, TArrayView<const EGridSlotType> ColumnSlotTypes);
+
+	/** Combined hash of the columns [FirstColumn, LastColumn] */
+	uint64 GetColumnRangeHash(int FirstColumn, int LastColumn) const;
+
+protected:
+	/** Unique hash for a slot being taken */
+	uint64 GetSlotKey(int Column, int Row) const;
+
+	/** Combines the change into the column's hash */
+	void ApplyColumnChange(int Column, uint64 Change);
+
+#pragma endregion
+
+#pragma region Results
+
+public:
+	/**
+	* Finds a stored result for the walk that is still valid for the grid.
+	* @return false if there is no result or a column it depended on changed
+	*/
+	bool Find(const FIntVector2D& Start, EDirection Direction, FIntVector2D& OutFinal, int& OutStepCount) const;
+
+	/** Stores the result of a walk from the start to the final position */
+	void Store(const FIntVector2D& Start, EDirection Direction, const FIntVector2D& Final, int StepCount);
+
+protected:
+	int GetEntryIndex(const FIntVector2D& Start, EDirection Direction) const;
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Cache Variables
+
+protected:
+	/** A stored walk result, small so the cache stays compact for large grids, grids are far below the 16 bit coordinate limit */
+	struct FEntry
+	{
+		/** Combined hash of the depended on columns when stored */
+		uint64 RangeHash = 0;
+
+		/** Depended on columns, invalid entry if the first column is INDEX_NONE */
+		int16 FirstColumn = INDEX_NONE;
+		int16 LastColumn = INDEX_NONE;
+
+		int16 FinalX = 0;
+		int16 FinalY = 0;
+
+		int32 StepCount = 0;
+	};
+
+	FIntVector2D GridSize = FIntVector2D(0, 0);
+
+	/** One entry per slot and direction */
+	TArray<FEntry> Entries;
+
+	/** Hash of the taken slots of each column */
+	TArray<uint64> ColumnHashes;
+
+	/** One based tree of column hashes combined with exclusive or, giving the hash of a column range from two prefixes */
+	TArray<uint64> ColumnHashTree;
+
+#pragma endregion
+};
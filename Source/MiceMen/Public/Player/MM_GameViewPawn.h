@@ -75,7 +75,12 @@ public:
 
 	/** Gets the current interactable columns for this player */
 	UFUNCTION(BlueprintPure)
-	virtual TArray<AMM_ColumnControl*> GetCurrentColumnControls() const { return CurrentColumnControls; };
+	virtual const TArray<AMM_ColumnControl*>& GetCurrentColumnControls() const { return CurrentColumnControls; };
+
+	/** The last column moved by this player, -1 before their first move */
+	int GetLastMovedColumn() const { return LastMovedColumn; }
+
+	int GetSameMovedColumnCount() const { return SameMovedColumnCount; }
 
 protected:
 	/** Updates column interaction count, and last interacted column */
@@ -125,7 +130,7 @@ protected:
 #pragma region Interaction Variables
 
 public:
-	/** The distance the player can interact when grabbing */
+	/** The distance from the camera the player can interact when grabbing */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 	float InteractTraceDistance = 100000.0f;
 
@@ -155,6 +160,9 @@ protected:
 	UPROPERTY(BlueprintReadOnly)
 	TArray<AMM_ColumnControl*> CurrentColumnControls;
 
+	/** Reused each turn for the team's column indexes */
+	TArray<int> AvailableColumnsScratch;
+
 	/** Linked to the current column on release, for when the column slots into place */
 	FDelegateHandle CurrentColumnDelegateHandle;
 
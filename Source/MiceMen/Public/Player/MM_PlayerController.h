@@ -69,6 +69,13 @@ protected:
 	/** Perform AI turn by looking for the next opening a mouse can go to and move a column towards that */
 	bool TakeAdvancedAITurn() const;
 
+	/**
+	* Perform AI turn by searching turns ahead for both teams, reusing the game's transposition table between turns.
+	* Openings in the game's opening book are played without searching,
+	* and in a stalemate every turn left is searched, playing it perfectly.
+	*/
+	bool TakeExpertAITurn() const;
+
 #pragma endregion
 
 #pragma region Gameloop
@@ -80,6 +87,9 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsAI() const { return bIsAI; }
 
+	/** Seconds the AI spent choosing its move this turn, 0 if the player is not an AI */
+	double GetLastAIThinkTime() const { return LastAIThinkTime; }
+
 #pragma endregion
 
 //-------------------------------------------------------
@@ -111,5 +121,7 @@ protected:
 	UPROPERTY(BlueprintReadOnly)
 	bool bIsAI = false;
 
+	double LastAIThinkTime = 0.0;
+
 #pragma endregion
 };
@@ -0,0 +1,63 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+
+/**
+ * Counts heap allocations made on the game thread while in scope, by wrapping the global allocator.
+ * Only meant for tools and automation tests, where nothing else swaps the allocator while counting.
+ */
+class MICEMEN_API FMM_ScopedAllocationCounter : public FMalloc
+{
+public:
+	FMM_ScopedAllocationCounter();
+
+	/** Restores the wrapped allocator */
+	virtual ~FMM_ScopedAllocationCounter() override;
+
+	/** Allocations and reallocations made on the game thread since the counter was created */
+	uint64 GetAllocationCount() const { return AllocationCount; }
+
+#pragma region Malloc
+
+public:
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override;
+
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override;
+
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+
+	virtual void Free(void* Original) override;
+
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return WrappedMalloc->QuantizeSize(Count, Alignment); }
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return WrappedMalloc->GetAllocationSize(Original, SizeOut); }
+
+	virtual void Trim(bool bTrimThreadCaches) override { WrappedMalloc->Trim(bTrimThreadCaches); }
+
+	virtual bool IsInternallyThreadSafe() const override { return WrappedMalloc->IsInternallyThreadSafe(); }
+
+	virtual const TCHAR* GetDescriptiveName() override { return WrappedMalloc->GetDescriptiveName(); }
+
+protected:
+	/** Counts the allocation if made on the game thread */
+	void CountAllocation();
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Counter Variables
+
+protected:
+	FMalloc* WrappedMalloc = nullptr;
+
+	/** Only written from the game thread */
+	uint64 AllocationCount = 0;
+
+#pragma endregion
+};
@@ -0,0 +1,137 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Grid/IntVector2D.h"
+#include "MM_BenchmarkCommandlet.generated.h"
+
+class AMM_GridManager;
+struct FMM_RulesBoard;
+
+/** Timings for one operation on one board */
+struct FMM_BenchmarkResult
+{
+	/** Operation and board, such as MoveColumnElements/64x32/10% */
+	FString Name;
+
+	int SampleCount = 0;
+
+	double MedianMicroseconds = 0.0;
+
+	double P99Microseconds = 0.0;
+};
+
+/**
+ * Times the grid and rules hot paths on several board sizes and mouse densities, using fixed seeds so every run uses the same boards.
+ * Reports the median and p99 of each operation, and fails if they have regressed against the baseline committed with the project.
+ * Operations missing from the baseline are added to it with their first timings and checked from the next run,
+ * -updatebaseline rewrites every operation and should be run on the reference machine whenever operations are sped up.
+ * Only timings are checked, the behaviour of the operations is covered by the MiceMen automation tests.
+ *
+ * Runs headless from the editor executable:
+ * UnrealEditor-Cmd MiceMen.uproject -run=MM_Benchmark -nullrhi -unattended
+ *
+ * Options:
+ * -samples=N		timed calls per operation and board, 200 by default
+ * -seed=N			seed for board generation and inputs
+ * -baseline=Path	baseline file to compare against, Build/Benchmarks/MM_BenchmarkBaseline.csv by default
+ * -tolerance=F		allowed increase over the baseline as a fraction, 0.25 by default
+ * -updatebaseline	stores the results as the new baseline instead of comparing
+ *
+ * Returns 0 on success, 1 if any operation regressed, and 2 if the benchmark could not run or the baseline file is missing.
+ */
+UCLASS()
+class MICEMEN_API UMM_BenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMM_BenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#pragma region Benchmarks
+
+protected:
+	/** Runs every benchmark for one board size and mouse density */
+	void RunBoardBenchmarks(UWorld* World, const FIntVector2D& BoardSize, float MouseDensity);
+
+	/**
+	* Plays a full set of games in lockstep from the same board with random moves, timing each lockstep turn
+	* against playing the same turn on a rules board per game.
+	*/
+	template <int32 Width, int32 Height>
+	void RunLockstepBenchmarks(UWorld* World, float MouseDensity, const FString& BoardName);
+
+	/**
+	* Spawns a grid manager with a populated board.
+	* @param MouseDensity fraction of each team's side of the board to fill with mice
+	* @param BoardSeed the board is the same every time for the same seed
+	*/
+	AMM_GridManager* CreateBoard(UWorld* World, const FIntVector2D& BoardSize, float MouseDensity, int BoardSeed) const;
+
+	/** Makes stalemates from pairs of mice on the board, timing the search solving them for each team */
+	void TimeStalemateSolver(const FMM_RulesBoard& Board, const FString& BoardName);
+
+	/** Makes puzzles of single mice on the board's blocks, timing the solver on each */
+	void TimePuzzleSolver(const FMM_RulesBoard& Board, const FString& BoardName);
+
+	/** Sorts the sample times in seconds and stores the median and p99 */
+	void AddResult(const FString& Name, TArray<double>& SampleTimes);
+
+	/** Times a single call in seconds */
+	static double TimeCall(TFunctionRef<void()> Call);
+
+#pragma endregion
+
+#pragma region Baseline
+
+protected:
+	/** Writes results as CSV, used for both the run results and the baseline */
+	static bool WriteResults(const FString& FilePath, const TArray<FMM_BenchmarkResult>& InResults);
+
+	/** Reads a results file written by WriteResults */
+	static bool ReadResults(const FString& FilePath, TMap<FString, FMM_BenchmarkResult>& OutResults);
+
+	/**
+	* Compares the results against the baseline, logging each regression.
+	* @param OutMissingResults results of operations missing from the baseline, which aren't counted as regressions
+	*/
+	int CountRegressions(const TMap<FString, FMM_BenchmarkResult>& Baseline, TArray<FMM_BenchmarkResult>& OutMissingResults) const;
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Settings Variables
+
+protected:
+	/** Boards benchmarked, from the default size to large boards */
+	TArray<FIntVector2D> BoardSizes;
+
+	/** Fractions of each team's side filled with mice, benchmarked for every board size */
+	TArray<float> MouseDensities;
+
+	/** Cascades run on a board before it is rebuilt, so the board doesn't empty as mice reach their goals */
+	int CascadesPerBoard = 20;
+
+	int SampleCount = 200;
+
+	int Seed = 1337;
+
+	float Tolerance = 0.25f;
+
+	/** Increases smaller than this are timer noise and never count as a regression */
+	double MinRegressionMicroseconds = 0.5;
+
+#pragma endregion
+
+#pragma region Result Variables
+
+protected:
+	TArray<FMM_BenchmarkResult> Results;
+
+#pragma endregion
+};
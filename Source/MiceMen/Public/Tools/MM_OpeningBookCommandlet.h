@@ -0,0 +1,78 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Grid/IntVector2D.h"
+#include "MM_OpeningBookCommandlet.generated.h"
+
+struct FMM_RulesBoard;
+struct FMM_OpeningBookEntry;
+class FMM_TranspositionTable;
+enum class ERulesTeam : uint8;
+
+/**
+ * Writes the opening book for the game mode's seeded boards, searching the openings of every board on all cores.
+ * Each seed's board is built the way the game mode builds it. Then, for either team moving first, the best line is searched
+ * deeper than the AI searches during a game, and the best move of each of its first positions is stored.
+ *
+ * The book is opt in, no seeds are set by default and no book is shipped. To use one, set BoardSeedCount on the game mode
+ * in DefaultGame.ini and run the commandlet, which writes it to OpeningBookFile under the content directory.
+ * Rewrite the book whenever the seed count, board size or rules change, as positions it doesn't have are searched as usual.
+ *
+ * Runs headless from the editor executable:
+ * UnrealEditor-Cmd MiceMen.uproject -run=MM_OpeningBook -nullrhi -unattended
+ *
+ * Options:
+ * -seeds=N		boards to search, the game mode's BoardSeedCount by default
+ * -depth=N		turns searched ahead for each move, 6 by default
+ * -plies=N		moves stored from each line, 2 by default
+ * -tablemb=N		size of the transposition table shared by all searches, 1024 by default
+ * -width=N -height=N	board size, the game mode's default grid size by default
+ * -out=Path		book file to write, the game mode's OpeningBookFile by default
+ *
+ * Returns 0 on success, 1 if the book could not be written, and 2 if the boards could not be built.
+ */
+UCLASS()
+class MICEMEN_API UMM_OpeningBookCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMM_OpeningBookCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#pragma region Book
+
+protected:
+	/** Builds the board for the seed the same way the game mode builds a seeded board */
+	bool BuildSeededBoard(UWorld* World, int BoardSeed, FMM_RulesBoard& OutBoard) const;
+
+	/** Searches the best line from the board for the team moving first, adding the best move of each of its first positions */
+	void SearchOpening(const FMM_RulesBoard& Board, ERulesTeam FirstTeam, FMM_TranspositionTable& Table, TArray<FMM_OpeningBookEntry>& OutEntries) const;
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Settings Variables
+
+protected:
+	int SeedCount = 0;
+
+	int SearchDepth = 6;
+
+	int BookPlies = 2;
+
+	int TableMegabytes = 1024;
+
+	/** Board size from the game mode */
+	FIntVector2D GridSize = FIntVector2D(0, 0);
+
+	/** Mice per team from the game mode */
+	int InitialMiceCount = 12;
+
+#pragma endregion
+};
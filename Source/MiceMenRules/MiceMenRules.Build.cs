@@ -0,0 +1,16 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+using UnrealBuildTool;
+
+public class MiceMenRules : ModuleRules
+{
+	public MiceMenRules(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Core only, so the rules can be linked into programs and tools without the engine
+		PublicDependencyModuleNames.AddRange(new[] { "Core" });
+
+		PublicIncludePaths.AddRange(new[] { "MiceMenRules" });
+	}
+}
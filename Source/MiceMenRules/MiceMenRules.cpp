@@ -0,0 +1,8 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "MiceMenRules.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, MiceMenRules);
+
+DEFINE_LOG_CATEGORY(MiceMenRulesLog);
@@ -0,0 +1,118 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Rules/MM_OpeningBook.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Algo/BinarySearch.h"
+
+#include "MiceMenRules.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_RulesSearch.h"
+
+FMM_OpeningBook::FMM_OpeningBook() = default;
+
+FMM_OpeningBook::~FMM_OpeningBook()
+{
+	Close();
+}
+
+// ################################ File ################################
+
+bool FMM_OpeningBook::Open(const FString& FilePath)
+{
+	Close();
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!MappedFile)
+	{
+		return false;
+	}
+	MappedRegion.Reset(MappedFile->MapRegion());
+
+	// Check the file is a book of this version with all its entries
+	const int64 MappedSize = MappedRegion ? MappedRegion->GetMappedSize() : 0;
+	const FHeader* Header = MappedSize >= static_cast<int64>(sizeof(FHeader)) ? reinterpret_cast<const FHeader*>(MappedRegion->GetMappedPtr()) : nullptr;
+	if (!Header || Header->Magic != BookMagic || Header->Version != BookVersion
+		|| Header->EntryCount > static_cast<uint64>(MAX_int32)
+		|| static_cast<uint64>(MappedSize) < sizeof(FHeader) + Header->EntryCount * sizeof(FMM_OpeningBookEntry))
+	{
+		UE_LOG(MiceMenRulesLog, Warning, TEXT("FMM_OpeningBook::Open | %s is not a version %u opening book"), *FilePath, BookVersion);
+		Close();
+		return false;
+	}
+
+	Entries = TArrayView<const FMM_OpeningBookEntry>(reinterpret_cast<const FMM_OpeningBookEntry*>(Header + 1), static_cast<int32>(Header->EntryCount));
+
+	UE_LOG(MiceMenRulesLog, Log, TEXT("FMM_OpeningBook::Open | %i positions from %s"), Entries.Num(), *FilePath);
+	return true;
+}
+
+void FMM_OpeningBook::Close()
+{
+	Entries = TArrayView<const FMM_OpeningBookEntry>();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FMM_OpeningBook::Write(const FString& FilePath, TArray<FMM_OpeningBookEntry>& InEntries)
+{
+	// Deepest first within a key, so the first of each key is kept
+	InEntries.Sort([](const FMM_OpeningBookEntry& EntryA, const FMM_OpeningBookEntry& EntryB)
+	{
+		return EntryA.Key != EntryB.Key ? EntryA.Key < EntryB.Key : EntryA.Depth > EntryB.Depth;
+	});
+	int32 UniqueCount = 0;
+	for (int32 i = 0; i < InEntries.Num(); i++)
+	{
+		if (UniqueCount == 0 || InEntries[UniqueCount - 1].Key != InEntries[i].Key)
+		{
+			InEntries[UniqueCount++] = InEntries[i];
+		}
+	}
+	InEntries.SetNum(UniqueCount, false);
+
+	FHeader Header;
+	Header.Magic = BookMagic;
+	Header.Version = BookVersion;
+	Header.EntryCount = InEntries.Num();
+
+	TArray<uint8> FileData;
+	FileData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FHeader));
+	FileData.Append(reinterpret_cast<const uint8*>(InEntries.GetData()), InEntries.Num() * sizeof(FMM_OpeningBookEntry));
+	if (!FFileHelper::SaveArrayToFile(FileData, *FilePath))
+	{
+		UE_LOG(MiceMenRulesLog, Error, TEXT("FMM_OpeningBook::Write | Failed to write %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(MiceMenRulesLog, Log, TEXT("FMM_OpeningBook::Write | %i positions to %s"), InEntries.Num(), *FilePath);
+	return true;
+}
+
+// ################################ Moves ################################
+
+bool FMM_OpeningBook::FindMove(uint64 Key, FMM_SearchMove& OutMove) const
+{
+	const int32 Index = Algo::LowerBoundBy(Entries, Key, &FMM_OpeningBookEntry::Key);
+	if (!Entries.IsValidIndex(Index) || Entries[Index].Key != Key)
+	{
+		return false;
+	}
+
+	OutMove.Column = Entries[Index].Column;
+	OutMove.bUp = Entries[Index].bUp != 0;
+	return true;
+}
+
+uint64 FMM_OpeningBook::GetPositionKey(const FMM_RulesBoard& Board, ERulesTeam Team, int32 LastMovedColumn, int32 SameMovedColumnCount, int32 SameColumnMax)
+{
+	FMM_SameColumnLimits ColumnLimits;
+	ColumnLimits.LastMovedColumns[Team == ERulesTeam::E_TEAM_A ? 0 : 1] = LastMovedColumn;
+	ColumnLimits.SameMovedColumnCounts[Team == ERulesTeam::E_TEAM_A ? 0 : 1] = SameMovedColumnCount;
+
+	FMM_PackedPosition Position;
+	Position.Pack(Board, Team, ColumnLimits, SameColumnMax);
+	return Position.GetKey();
+}
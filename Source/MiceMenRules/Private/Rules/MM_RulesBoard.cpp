@@ -0,0 +1,554 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Rules/MM_RulesBoard.h"
+
+#include "MiceMenRules.h"
+#include "Rules/MM_ScoringReachability.h"
+
+// ################################ Setup ################################
+
+void FMM_RulesBoard::Setup(int InWidth, int InHeight, int InMicePerTeam, int InStalemateTurns /*= 8*/)
+{
+	Width = FMath::Max(InWidth, 0);
+	Height = FMath::Max(InHeight, 0);
+	MicePerTeam = InMicePerTeam;
+	StalemateTurns = InStalemateTurns;
+
+	Slots.Init(ERulesSlot::E_EMPTY, Width * Height);
+	SlotMice.Init(INDEX_NONE, Width * Height);
+
+	// Empty columns fall all the way to the bottom
+	LandingRows.Init(0, Width * Height);
+
+	Mice.Reset();
+	PassOrder.Reset();
+	CellsKey = 0;
+
+	SetGameState(0, 0, INDEX_NONE, -1);
+}
+
+bool FMM_RulesBoard::AddBlock(const FIntPoint& Coord)
+{
+	// Only empty slots can be filled
+	if (!IsInBoard(Coord) || GetSlot(Coord) != ERulesSlot::E_EMPTY)
+	{
+		UE_LOG(MiceMenRulesLog, Warning, TEXT("FMM_RulesBoard::AddBlock | %s is not an empty slot"), *Coord.ToString());
+		return false;
+	}
+
+	SetSlot(Coord, ERulesSlot::E_BLOCK, INDEX_NONE);
+	return true;
+}
+
+bool FMM_RulesBoard::AddMouse(const FIntPoint& Coord, ERulesTeam Team)
+{
+	// Only empty slots can be filled
+	if (!IsInBoard(Coord) || GetSlot(Coord) != ERulesSlot::E_EMPTY)
+	{
+		UE_LOG(MiceMenRulesLog, Warning, TEXT("FMM_RulesBoard::AddMouse | %s is not an empty slot"), *Coord.ToString());
+		return false;
+	}
+
+	// Mice can only be on a team
+	if (Team != ERulesTeam::E_TEAM_A && Team != ERulesTeam::E_TEAM_B)
+	{
+		UE_LOG(MiceMenRulesLog, Warning, TEXT("FMM_RulesBoard::AddMouse | Invalid team %i"), static_cast<int>(Team));
+		return false;
+	}
+
+	FMM_RulesMouse NewMouse;
+	NewMouse.Coord = Coord;
+	NewMouse.Team = Team;
+	const int32 MouseIndex = Mice.Add(NewMouse);
+
+	SetSlot(Coord, ERulesSlot::E_MOUSE, MouseIndex);
+	return true;
+}
+
+void FMM_RulesBoard::SetGameState(int TeamAScore, int TeamBScore, int InLastMovedColumn, int InStalemateCount)
+{
+	Scores[TeamIndex(ERulesTeam::E_TEAM_A)] = TeamAScore;
+	Scores[TeamIndex(ERulesTeam::E_TEAM_B)] = TeamBScore;
+	LastMovedColumn = InLastMovedColumn;
+	StalemateCount = InStalemateCount;
+	bGameOver = false;
+}
+
+// ################################ Slots ################################
+
+int FMM_RulesBoard::GetTeamMiceCount(ERulesTeam Team) const
+{
+	int MiceCount = 0;
+	for (const FMM_RulesMouse& Mouse : Mice)
+	{
+		if (Mouse.bActive && Mouse.Team == Team)
+		{
+			MiceCount++;
+		}
+	}
+	return MiceCount;
+}
+
+uint64 FMM_RulesBoard::GetSlotKey(int32 Index) const
+{
+	switch (Slots[Index])
+	{
+	case ERulesSlot::E_BLOCK:
+		return GetCellKey(Index, 1);
+	case ERulesSlot::E_MOUSE:
+		return GetCellKey(Index, Mice[SlotMice[Index]].Team == ERulesTeam::E_TEAM_A ? 2 : 3);
+	default:
+		return 0;
+	}
+}
+
+void FMM_RulesBoard::SetSlot(const FIntPoint& Coord, ERulesSlot Slot, int32 MouseIndex)
+{
+	const int Index = CoordToIndex(Coord);
+	const bool bWasEmpty = Slots[Index] == ERulesSlot::E_EMPTY;
+
+	// Swap the key of what was in the slot for the key of what is now
+	CellsKey ^= GetSlotKey(Index);
+	Slots[Index] = Slot;
+	SlotMice[Index] = MouseIndex;
+	CellsKey ^= GetSlotKey(Index);
+
+	// Only a change between empty and taken affects falling
+	if (bWasEmpty != (Slot == ERulesSlot::E_EMPTY))
+	{
+		UpdateLandingRowsAbove(Coord);
+	}
+}
+
+// ################################ Movement ################################
+
+bool FMM_RulesBoard::IsGoal(const FIntPoint& Coord, ERulesTeam Team) const
+{
+	// Team A reach the right side, team B the left
+	if (Team == ERulesTeam::E_TEAM_A)
+	{
+		return Coord.X >= Width - 1;
+	}
+	return Coord.X <= 0;
+}
+
+FIntPoint FMM_RulesBoard::Walk(const FIntPoint& Start, ERulesTeam Team, int& OutStepCount, TArray<FIntPoint>* OutPath /*= nullptr*/) const
+{
+	OutStepCount = 0;
+
+	// Outside the board never moves
+	if (!IsInBoard(Start))
+	{
+		return Start;
+	}
+
+	const int HorizontalStep = GetHorizontalStep(Team);
+	FIntPoint Position = Start;
+	while (true)
+	{
+		// Fall to the landing row if there is a free slot below
+		const int LandingRow = LandingRows[CoordToIndex(Position)];
+		if (LandingRow != Position.Y)
+		{
+			Position.Y = LandingRow;
+			OutStepCount++;
+			if (OutPath)
+			{
+				OutPath->Add(Position);
+			}
+		}
+
+		// Step ahead if free, otherwise the walk is complete as falling was already resolved
+		const int NextX = Position.X + HorizontalStep;
+		if (NextX < 0 || NextX >= Width || Slots[NextX * Height + Position.Y] != ERulesSlot::E_EMPTY)
+		{
+			break;
+		}
+
+		Position.X = NextX;
+		OutStepCount++;
+		if (OutPath)
+		{
+			OutPath->Add(Position);
+		}
+	}
+	return Position;
+}
+
+bool FMM_RulesBoard::MoveColumn(int Column, bool bUp)
+{
+	if (Column < 0 || Column >= Width || Height <= 0)
+	{
+		UE_LOG(MiceMenRulesLog, Warning, TEXT("FMM_RulesBoard::MoveColumn | Column %i not in board"), Column);
+		return false;
+	}
+
+	const int Bottom = Column * Height;
+	const int Top = Bottom + Height - 1;
+
+	// Every slot of the column moves, so its keys are removed here and added back where they end up
+	for (int i = Bottom; i <= Top; i++)
+	{
+		CellsKey ^= GetSlotKey(i);
+	}
+
+	// Upwards means the top slot wrapping to the bottom
+	if (bUp)
+	{
+		const ERulesSlot WrappingSlot = Slots[Top];
+		const int32 WrappingMouse = SlotMice[Top];
+		for (int i = Top; i > Bottom; i--)
+		{
+			Slots[i] = Slots[i - 1];
+			SlotMice[i] = SlotMice[i - 1];
+		}
+		Slots[Bottom] = WrappingSlot;
+		SlotMice[Bottom] = WrappingMouse;
+	}
+	// Downwards means the bottom slot wrapping to the top
+	else
+	{
+		const ERulesSlot WrappingSlot = Slots[Bottom];
+		const int32 WrappingMouse = SlotMice[Bottom];
+		for (int i = Bottom; i < Top; i++)
+		{
+			Slots[i] = Slots[i + 1];
+			SlotMice[i] = SlotMice[i + 1];
+		}
+		Slots[Top] = WrappingSlot;
+		SlotMice[Top] = WrappingMouse;
+	}
+
+	// Update the mice that moved with the column, the keys of its slots, and every landing row in it
+	LandingRows[Bottom] = 0;
+	for (int y = 0; y < Height; y++)
+	{
+		const int Index = Bottom + y;
+		if (SlotMice[Index] != INDEX_NONE)
+		{
+			Mice[SlotMice[Index]].Coord.Y = y;
+		}
+		CellsKey ^= GetSlotKey(Index);
+		if (y > 0)
+		{
+			LandingRows[Index] = Slots[Index - 1] == ERulesSlot::E_EMPTY ? LandingRows[Index - 1] : y;
+		}
+	}
+
+	return true;
+}
+
+FMM_RulesTurnResult FMM_RulesBoard::ResolveCascade(ERulesTeam FirstTeam, FMM_RulesCascadeLog* OutLog /*= nullptr*/)
+{
+	FMM_RulesTurnResult Result;
+	if (OutLog)
+	{
+		OutLog->Reset();
+	}
+
+	bool bAnyMiceMoved = true;
+	while (bAnyMiceMoved)
+	{
+		bAnyMiceMoved = false;
+		Result.CascadePasses++;
+
+		// Without a valid first team there is no order to process mice in, matching the grid manager
+		PassOrder.Reset();
+		if (FirstTeam == ERulesTeam::E_TEAM_A || FirstTeam == ERulesTeam::E_TEAM_B)
+		{
+			AddTeamToPassOrder(FirstTeam);
+			AddTeamToPassOrder(FirstTeam == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A);
+		}
+
+		for (const int32 MouseIndex : PassOrder)
+		{
+			FMM_RulesMouse& Mouse = Mice[MouseIndex];
+
+			// Check mouse is still active, as it may have already reached its goal
+			if (!Mouse.bActive)
+			{
+				continue;
+			}
+
+			// Paths are logged from where the mouse starts, and dropped again if it doesn't move
+			const int32 PathStart = OutLog ? OutLog->Paths.Add(Mouse.Coord) : 0;
+
+			int StepCount;
+			const FIntPoint FinalPosition = Walk(Mouse.Coord, Mouse.Team, StepCount, OutLog ? &OutLog->Paths : nullptr);
+			if (StepCount <= 0)
+			{
+				if (OutLog)
+				{
+					OutLog->Paths.SetNum(PathStart, false);
+				}
+				continue;
+			}
+			bAnyMiceMoved = true;
+			Result.MiceMoved++;
+
+			if (OutLog)
+			{
+				FMM_RulesCascadeLog::FMove& Move = OutLog->Moves.AddDefaulted_GetRef();
+				Move.MouseIndex = MouseIndex;
+				Move.PathStart = PathStart;
+				Move.PathNum = OutLog->Paths.Num() - PathStart;
+				Move.bScored = IsGoal(FinalPosition, Mouse.Team);
+			}
+
+			// Not at the end, move the mouse to its final position
+			if (!IsGoal(FinalPosition, Mouse.Team))
+			{
+				SetSlot(Mouse.Coord, ERulesSlot::E_EMPTY, INDEX_NONE);
+				SetSlot(FinalPosition, ERulesSlot::E_MOUSE, MouseIndex);
+				Mouse.Coord = FinalPosition;
+				continue;
+			}
+
+			// Score a point and clear the mouse
+			SetSlot(Mouse.Coord, ERulesSlot::E_EMPTY, INDEX_NONE);
+			Mouse.bActive = false;
+			Scores[TeamIndex(Mouse.Team)]++;
+			Result.GoalsScored++;
+			CheckForStalemate();
+
+			// Mouse was the winning mouse, stop processing mice
+			if (HasTeamWon(Mouse.Team))
+			{
+				Result.Outcome = ERulesOutcome::E_ALL_MICE_COMPLETED;
+				Result.Winner = Mouse.Team;
+				bGameOver = true;
+				return Result;
+			}
+		}
+	}
+
+	return Result;
+}
+
+void FMM_RulesBoard::UpdateLandingRowsAbove(const FIntPoint& Coord)
+{
+	// Only the run of empty slots directly above the change can be affected
+	const int ColumnStart = Coord.X * Height;
+	for (int y = Coord.Y + 1; y < Height; y++)
+	{
+		LandingRows[ColumnStart + y] = Slots[ColumnStart + y - 1] == ERulesSlot::E_EMPTY ? LandingRows[ColumnStart + y - 1] : y;
+
+		// Rows above a taken slot are unaffected by anything further down
+		if (Slots[ColumnStart + y] != ERulesSlot::E_EMPTY)
+		{
+			break;
+		}
+	}
+}
+
+void FMM_RulesBoard::AddTeamToPassOrder(ERulesTeam Team)
+{
+	const int FirstIndex = PassOrder.Num();
+	for (int32 i = 0; i < Mice.Num(); i++)
+	{
+		if (Mice[i].bActive && Mice[i].Team == Team)
+		{
+			PassOrder.Add(i);
+		}
+	}
+
+	// Lower mice go first so higher mice can fall after, then the most forward so they don't block the others
+	const bool bForwardIsRight = Team == ERulesTeam::E_TEAM_A;
+	Sort(PassOrder.GetData() + FirstIndex, PassOrder.Num() - FirstIndex, [this, bForwardIsRight](const int32 A, const int32 B)
+	{
+		const FIntPoint& CoordA = Mice[A].Coord;
+		const FIntPoint& CoordB = Mice[B].Coord;
+		if (CoordA.Y != CoordB.Y)
+		{
+			return CoordA.Y < CoordB.Y;
+		}
+		return bForwardIsRight ? CoordA.X > CoordB.X : CoordA.X < CoordB.X;
+	});
+}
+
+// ################################ Turns ################################
+
+void FMM_RulesBoard::CollectMovableColumns(ERulesTeam Team, TArray<int>& OutColumns) const
+{
+	OutColumns.Reset();
+
+	TArray<bool, TInlineAllocator<256>> TeamInColumn;
+	TeamInColumn.SetNumZeroed(Width);
+	for (const FMM_RulesMouse& Mouse : Mice)
+	{
+		if (Mouse.bActive && Mouse.Team == Team)
+		{
+			TeamInColumn[Mouse.Coord.X] = true;
+		}
+	}
+
+	int FailsafeColumn = INDEX_NONE;
+	for (int x = 0; x < Width; x++)
+	{
+		if (!TeamInColumn[x])
+		{
+			continue;
+		}
+
+		// Store failsafe column, in case all are removed
+		FailsafeColumn = x;
+
+		// Cannot move the last moved column
+		if (x != LastMovedColumn)
+		{
+			OutColumns.Add(x);
+		}
+	}
+
+	// Use failsafe column if it was the only one
+	if (OutColumns.Num() <= 0 && FailsafeColumn != INDEX_NONE)
+	{
+		OutColumns.Add(FailsafeColumn);
+	}
+}
+
+FMM_RulesTurnResult FMM_RulesBoard::PlayTurn(ERulesTeam Team, int Column, bool bUp, FMM_RulesCascadeLog* OutLog /*= nullptr*/)
+{
+	FMM_RulesTurnResult Result;
+	if (OutLog)
+	{
+		OutLog->Reset();
+	}
+
+	if (bGameOver)
+	{
+		UE_LOG(MiceMenRulesLog, Warning, TEXT("FMM_RulesBoard::PlayTurn | Game is already over"));
+		return Result;
+	}
+
+	if (!MoveColumn(Column, bUp))
+	{
+		return Result;
+	}
+	LastMovedColumn = Column;
+
+	Result = ResolveCascade(Team, OutLog);
+	if (bGameOver)
+	{
+		return Result;
+	}
+
+	// No more mice can complete, decided on score, a stalemate plays out its turns and is decided on distance instead
+	if (StalemateCount < 0 && HasNoValidMoves())
+	{
+		const int TeamAScore = GetScore(ERulesTeam::E_TEAM_A);
+		const int TeamBScore = GetScore(ERulesTeam::E_TEAM_B);
+		Result.Outcome = ERulesOutcome::E_NO_VALID_MOVES;
+		Result.Winner = TeamAScore == TeamBScore ? ERulesTeam::E_NONE : TeamAScore > TeamBScore ? ERulesTeam::E_TEAM_A : ERulesTeam::E_TEAM_B;
+		bGameOver = true;
+		return Result;
+	}
+
+	// If stalemate is active, count the turn taken
+	if (StalemateCount >= 0)
+	{
+		StalemateCount++;
+		if (StalemateCount >= StalemateTurns)
+		{
+			int DistanceWonBy;
+			Result.Outcome = ERulesOutcome::E_STALEMATE;
+			Result.Winner = GetWinningStalemateTeam(DistanceWonBy);
+			bGameOver = true;
+		}
+	}
+
+	return Result;
+}
+
+int FMM_RulesBoard::GetScore(ERulesTeam Team) const
+{
+	if (Team != ERulesTeam::E_TEAM_A && Team != ERulesTeam::E_TEAM_B)
+	{
+		return 0;
+	}
+	return Scores[TeamIndex(Team)];
+}
+
+bool FMM_RulesBoard::HasNoValidMoves() const
+{
+	// Summaries of each column as single lane masks, without allocating for common board sizes
+	TArray<uint64, TInlineAllocator<256>> FullColumns;
+	TArray<uint64, TInlineAllocator<256>> TeamColumns[2];
+	TArray<uint64, TInlineAllocator<256>> CanEmptyColumns;
+	FullColumns.Init(1, Width);
+	TeamColumns[0].SetNumZeroed(Width);
+	TeamColumns[1].SetNumZeroed(Width);
+	CanEmptyColumns.SetNumUninitialized(Width);
+
+	for (int x = 0; x < Width; x++)
+	{
+		for (int y = 0; y < Height; y++)
+		{
+			if (Slots[x * Height + y] == ERulesSlot::E_EMPTY)
+			{
+				FullColumns[x] = 0;
+				break;
+			}
+		}
+	}
+	for (const FMM_RulesMouse& Mouse : Mice)
+	{
+		if (Mouse.bActive)
+		{
+			TeamColumns[TeamIndex(Mouse.Team)][Mouse.Coord.X] = 1;
+		}
+	}
+
+	return FMM_ScoringReachability::GetScorableLanes(FullColumns, TeamColumns[0], TeamColumns[1], 1, CanEmptyColumns) == 0;
+}
+
+bool FMM_RulesBoard::IsStalemate() const
+{
+	return GetTeamMiceCount(ERulesTeam::E_TEAM_A) == 1 && GetTeamMiceCount(ERulesTeam::E_TEAM_B) == 1;
+}
+
+ERulesTeam FMM_RulesBoard::GetWinningStalemateTeam(int& OutDistanceWonBy) const
+{
+	OutDistanceWonBy = 0;
+
+	// Distance of each team's first remaining mouse from their starting side
+	int TeamDistances[2] = {0, 0};
+	bool bTeamFound[2] = {false, false};
+	for (const FMM_RulesMouse& Mouse : Mice)
+	{
+		if (!Mouse.bActive || bTeamFound[TeamIndex(Mouse.Team)])
+		{
+			continue;
+		}
+
+		const int StartX = Mouse.Team == ERulesTeam::E_TEAM_A ? 0 : Width - 1;
+		TeamDistances[TeamIndex(Mouse.Team)] = FMath::Abs(StartX - Mouse.Coord.X);
+		bTeamFound[TeamIndex(Mouse.Team)] = true;
+	}
+
+	const int TeamADistance = TeamDistances[TeamIndex(ERulesTeam::E_TEAM_A)];
+	const int TeamBDistance = TeamDistances[TeamIndex(ERulesTeam::E_TEAM_B)];
+
+	// Same distance, no winner
+	if (TeamADistance == TeamBDistance)
+	{
+		return ERulesTeam::E_NONE;
+	}
+
+	OutDistanceWonBy = FMath::Abs(TeamADistance - TeamBDistance);
+	return TeamADistance > TeamBDistance ? ERulesTeam::E_TEAM_A : ERulesTeam::E_TEAM_B;
+}
+
+void FMM_RulesBoard::CheckForStalemate()
+{
+	// Already counting stalemate turns
+	if (StalemateCount >= 0)
+	{
+		return;
+	}
+
+	if (IsStalemate())
+	{
+		StalemateCount = 0;
+	}
+}
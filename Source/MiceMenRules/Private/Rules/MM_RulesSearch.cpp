@@ -0,0 +1,309 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Rules/MM_RulesSearch.h"
+
+#include "MiceMenRules.h"
+
+// ################################ Packed Position ################################
+
+void FMM_PackedPosition::Pack(const FMM_RulesBoard& Board, ERulesTeam InSideToMove, const FMM_SameColumnLimits& ColumnLimits, int32 SameColumnMax)
+{
+	LastMovedColumn = static_cast<int16>(Board.GetLastMovedColumn());
+	StalemateCount = static_cast<int8>(FMath::Clamp(Board.GetStalemateCount(), -1, 127));
+	SideToMove = InSideToMove;
+	for (int32 i = 0; i < 2; i++)
+	{
+		LimitedColumns[i] = static_cast<int16>(ColumnLimits.GetLimitedColumn(i, SameColumnMax));
+	}
+	Scores[0] = static_cast<int16>(Board.GetScore(ERulesTeam::E_TEAM_A));
+	Scores[1] = static_cast<int16>(Board.GetScore(ERulesTeam::E_TEAM_B));
+
+	Key = Board.GetCellsKey() ^ GetSideKey(1, LastMovedColumn) ^ GetSideKey(2, StalemateCount) ^ GetSideKey(3, static_cast<int32>(SideToMove))
+		^ GetSideKey(4, LimitedColumns[0]) ^ GetSideKey(5, LimitedColumns[1])
+		^ GetSideKey(6, Scores[0]) ^ GetSideKey(7, Scores[1]);
+}
+
+bool FMM_PackedPosition::operator==(const FMM_PackedPosition& Other) const
+{
+	return Key == Other.Key && LastMovedColumn == Other.LastMovedColumn && StalemateCount == Other.StalemateCount
+		&& SideToMove == Other.SideToMove && LimitedColumns[0] == Other.LimitedColumns[0] && LimitedColumns[1] == Other.LimitedColumns[1]
+		&& Scores[0] == Other.Scores[0] && Scores[1] == Other.Scores[1];
+}
+
+uint64 FMM_PackedPosition::GetSideKey(uint64 Salt, int32 Value)
+{
+	// Salt in the high bits keeps side keys apart from cell keys
+	return MM_MixKey(Salt << 40 | static_cast<uint32>(Value));
+}
+
+// ################################ Search ################################
+
+FMM_RulesSearch::FMM_RulesSearch(FMM_TranspositionTable& InTable, FMM_SearchArena& InArena /*= FMM_SearchArena::Get()*/)
+	: Table(InTable)
+	, Arena(InArena)
+{
+}
+
+bool FMM_RulesSearch::FindBestMove(const FMM_RulesBoard& Board, ERulesTeam Team, const FMM_SameColumnLimits& ColumnLimits, const FMM_SearchSettings& Settings, FMM_SearchMove& OutMove)
+{
+	OutMove = FMM_SearchMove();
+
+	// No moves in a finished game or for no team
+	if (Board.IsGameOver() || (Team != ERulesTeam::E_TEAM_A && Team != ERulesTeam::E_TEAM_B))
+	{
+		return false;
+	}
+
+	const int32 MaxDepth = FMath::Clamp(Settings.MaxDepth, 1, MaxSearchDepth);
+	SameColumnMax = Settings.SameColumnMax;
+	NodeCount = 0;
+	TableHitCount = 0;
+	Table.NewSearch();
+
+	// A node for every ply, kept between searches so their boards are reused
+	ThreadNodes = &FThreadNodes::Get();
+	if (ThreadNodes->Nodes.Num() < MaxDepth + 1)
+	{
+		ThreadNodes->Nodes.SetNum(MaxDepth + 1);
+	}
+
+	FNode& Root = ThreadNodes->Nodes[0];
+	Root.Board = Board;
+	Root.ColumnLimits = ColumnLimits;
+	Root.Team = Team;
+	Root.Winner = ERulesTeam::E_NONE;
+	Root.Position.Pack(Board, Team, ColumnLimits, SameColumnMax);
+
+	// Everything the search allocates is released together once the move is chosen
+	const FMM_SearchArena::FMark SearchMark = Arena.GetMark();
+	const TArrayView<FMM_SearchMove> RootMoves = CollectMoves(0, FMM_SearchMove());
+	if (RootMoves.Num() > 0)
+	{
+		OutMove = RootMoves[0];
+	}
+
+	// Each depth orders the next by the best moves stored in the table
+	for (int32 Depth = 1; Depth <= MaxDepth && RootMoves.Num() > 0; Depth++)
+	{
+		RootBestMove = FMM_SearchMove();
+		RootScore = Search(0, Depth, -WinScore - 1, WinScore + 1);
+
+		if (RootBestMove.IsValid() && RootMoves.Contains(RootBestMove))
+		{
+			OutMove = RootBestMove;
+		}
+	}
+
+	Arena.PopMark(SearchMark);
+	ThreadNodes = nullptr;
+
+	if (!OutMove.IsValid())
+	{
+		return false;
+	}
+
+	UE_LOG(MiceMenRulesLog, Verbose, TEXT("FMM_RulesSearch::FindBestMove | Column %i %s after %i nodes, %i table hits"),
+	       OutMove.Column, OutMove.bUp ? TEXT("up") : TEXT("down"), NodeCount, TableHitCount);
+	return true;
+}
+
+bool FMM_RulesSearch::SolveStalemate(const FMM_RulesBoard& Board, ERulesTeam Team, const FMM_SameColumnLimits& ColumnLimits, const FMM_SearchSettings& Settings, FMM_SearchMove& OutMove, int32& OutScore)
+{
+	OutScore = 0;
+
+	// Only a stalemate has a known number of turns left
+	if (Board.GetStalemateCount() < 0 || Board.IsGameOver())
+	{
+		OutMove = FMM_SearchMove();
+		return false;
+	}
+
+	// Every line ends within the turns left, so searching them all only scores finished games
+	FMM_SearchSettings StalemateSettings = Settings;
+	StalemateSettings.MaxDepth = FMath::Max(Board.GetStalemateTurns() - Board.GetStalemateCount(), 1);
+	if (!FindBestMove(Board, Team, ColumnLimits, StalemateSettings, OutMove))
+	{
+		return false;
+	}
+
+	OutScore = RootScore;
+	return true;
+}
+
+int32 FMM_RulesSearch::Evaluate(const FMM_RulesBoard& Board, ERulesTeam Team)
+{
+	// Distance of every remaining mouse from their start
+	int32 Progress[2] = {0, 0};
+	for (const FMM_RulesMouse& Mouse : Board.GetMice())
+	{
+		if (Mouse.bActive)
+		{
+			Progress[Mouse.Team == ERulesTeam::E_TEAM_A ? 0 : 1] += Mouse.Team == ERulesTeam::E_TEAM_A ? Mouse.Coord.X : Board.GetWidth() - 1 - Mouse.Coord.X;
+		}
+	}
+
+	// A completed mouse is worth more than any mouse still on the board, so scoring never lowers the evaluation
+	const int32 ScoreWorth = Board.GetWidth() * 2;
+	const int32 TeamAScore = (Board.GetScore(ERulesTeam::E_TEAM_A) - Board.GetScore(ERulesTeam::E_TEAM_B)) * ScoreWorth + Progress[0] - Progress[1];
+	return Team == ERulesTeam::E_TEAM_A ? TeamAScore : -TeamAScore;
+}
+
+int32 FMM_RulesSearch::Search(int32 Ply, int32 Depth, int32 Alpha, int32 Beta)
+{
+	NodeCount++;
+	FNode& Node = ThreadNodes->Nodes[Ply];
+
+	// Finished games score the winner, sooner wins and later losses scoring higher
+	if (Node.Board.IsGameOver())
+	{
+		return Node.Winner == Node.Team ? WinScore - Ply : Node.Winner == ERulesTeam::E_NONE ? 0 : -WinScore + Ply;
+	}
+	if (Depth <= 0)
+	{
+		return Evaluate(Node.Board, Node.Team);
+	}
+
+	// Stored results deep enough for this search can be used instead of searching
+	const uint64 Key = Node.Position.GetKey();
+	const int32 OriginalAlpha = Alpha;
+	FMM_SearchMove TableMove;
+	FMM_TranspositionEntry Entry;
+	if (Table.Probe(Key, Entry))
+	{
+		TableHitCount++;
+		TableMove = Entry.BestMove;
+		Entry.Score = ScoreFromTable(Entry.Score, Ply);
+
+		const bool bScoreUsable = Entry.Bound == ESearchBound::E_EXACT
+			|| (Entry.Bound == ESearchBound::E_LOWER && Entry.Score >= Beta)
+			|| (Entry.Bound == ESearchBound::E_UPPER && Entry.Score <= Alpha);
+		if (Entry.Depth >= Depth && bScoreUsable)
+		{
+			if (Ply == 0)
+			{
+				RootBestMove = Entry.BestMove;
+			}
+			return Entry.Score;
+		}
+	}
+
+	// Moves are released when the position is done, so every ply reuses the same arena memory
+	const FMM_SearchArena::FMark MovesMark = Arena.GetMark();
+	const TArrayView<FMM_SearchMove> Moves = CollectMoves(Ply, TableMove);
+	if (Moves.Num() <= 0)
+	{
+		Arena.PopMark(MovesMark);
+		return Evaluate(Node.Board, Node.Team);
+	}
+
+	int32 BestScore = -WinScore - 1;
+	FMM_SearchMove BestMove;
+	const ERulesTeam OtherTeam = Node.Team == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+	for (const FMM_SearchMove& Move : Moves)
+	{
+		// Play the move on the next ply's node
+		FNode& Child = ThreadNodes->Nodes[Ply + 1];
+		Child.Board = Node.Board;
+		Child.ColumnLimits = Node.ColumnLimits;
+		Child.ColumnLimits.RecordMove(Node.Team, Move.Column);
+		Child.Team = OtherTeam;
+		Child.Winner = Child.Board.PlayTurn(Node.Team, Move.Column, Move.bUp).Winner;
+		Child.Position.Pack(Child.Board, Child.Team, Child.ColumnLimits, SameColumnMax);
+
+		const int32 Score = -Search(Ply + 1, Depth - 1, -Beta, -Alpha);
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestMove = Move;
+		}
+
+		// The other team would never allow this line
+		Alpha = FMath::Max(Alpha, Score);
+		if (Alpha >= Beta)
+		{
+			break;
+		}
+	}
+
+	Arena.PopMark(MovesMark);
+
+	if (Ply == 0)
+	{
+		RootBestMove = BestMove;
+	}
+
+	FMM_TranspositionEntry NewEntry;
+	NewEntry.Score = ScoreToTable(BestScore, Ply);
+	NewEntry.Depth = Depth;
+	NewEntry.Bound = BestScore <= OriginalAlpha ? ESearchBound::E_UPPER : BestScore >= Beta ? ESearchBound::E_LOWER : ESearchBound::E_EXACT;
+	NewEntry.BestMove = BestMove;
+	Table.Store(Key, NewEntry);
+
+	return BestScore;
+}
+
+int32 FMM_RulesSearch::ScoreToTable(int32 Score, int32 Ply)
+{
+	if (!IsWinScore(Score))
+	{
+		return Score;
+	}
+	return Score > 0 ? Score + Ply : Score - Ply;
+}
+
+int32 FMM_RulesSearch::ScoreFromTable(int32 Score, int32 Ply)
+{
+	if (!IsWinScore(Score))
+	{
+		return Score;
+	}
+	return Score > 0 ? Score - Ply : Score + Ply;
+}
+
+TArrayView<FMM_SearchMove> FMM_RulesSearch::CollectMoves(int32 Ply, const FMM_SearchMove& TableMove)
+{
+	FNode& Node = ThreadNodes->Nodes[Ply];
+	TArray<int>& Columns = ThreadNodes->Columns;
+	Node.Board.CollectMovableColumns(Node.Team, Columns);
+
+	// Both directions of every column at most
+	const TArrayView<FMM_SearchMove> Moves = Arena.AllocateArray<FMM_SearchMove>(Columns.Num() * 2);
+	int32 MoveCount = 0;
+
+	const int32 LimitedColumn = Node.ColumnLimits.GetLimitedColumn(Node.Team == ERulesTeam::E_TEAM_A ? 0 : 1, SameColumnMax);
+	int32 FallbackColumn = INDEX_NONE;
+	for (const int Column : Columns)
+	{
+		FallbackColumn = Column;
+
+		// Check if this column was already moved a specific amount of times in a row
+		if (Column == LimitedColumn)
+		{
+			continue;
+		}
+
+		Moves[MoveCount++] = {Column, true};
+		Moves[MoveCount++] = {Column, false};
+	}
+
+	// Fallback when the only column was moved more than the max, as the pawn does
+	if (MoveCount <= 0 && FallbackColumn != INDEX_NONE)
+	{
+		Moves[MoveCount++] = {FallbackColumn, true};
+		Moves[MoveCount++] = {FallbackColumn, false};
+	}
+
+	// The best move from an earlier search is likely still best, searching it first cuts off the most
+	const TArrayView<FMM_SearchMove> CollectedMoves = Moves.Slice(0, MoveCount);
+	const int32 TableMoveIndex = CollectedMoves.Find(TableMove);
+	for (int32 i = TableMoveIndex; i > 0; i--)
+	{
+		CollectedMoves[i] = CollectedMoves[i - 1];
+	}
+	if (TableMoveIndex > 0)
+	{
+		CollectedMoves[0] = TableMove;
+	}
+
+	return CollectedMoves;
+}
@@ -0,0 +1,66 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Rules/MM_SearchArena.h"
+
+#include "MiceMenRules.h"
+
+FMM_SearchArena::FMM_SearchArena(SIZE_T InBlockSize /*= 256 * 1024*/)
+	: BlockSize(FMath::Max<SIZE_T>(InBlockSize, 1024))
+{
+}
+
+FMM_SearchArena::~FMM_SearchArena()
+{
+	for (const FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Memory);
+	}
+}
+
+// ################################ Allocation ################################
+
+void* FMM_SearchArena::Allocate(SIZE_T Size, SIZE_T Alignment)
+{
+	// Use the first block from the current one with enough space, skipped space is released on the next pop
+	while (Blocks.IsValidIndex(CurrentBlock))
+	{
+		const FBlock& Block = Blocks[CurrentBlock];
+		const SIZE_T AlignedOffset = Align(Offset, Alignment);
+		if (AlignedOffset + Size <= Block.Size)
+		{
+			Offset = AlignedOffset + Size;
+			return Block.Memory + AlignedOffset;
+		}
+
+		CurrentBlock++;
+		Offset = 0;
+	}
+
+	// Still warming up, add a block large enough for the allocation
+	FBlock& NewBlock = Blocks.AddDefaulted_GetRef();
+	NewBlock.Size = FMath::Max(BlockSize, Align(Size, Alignment));
+	NewBlock.Memory = static_cast<uint8*>(FMemory::Malloc(NewBlock.Size, FMath::Max<SIZE_T>(Alignment, 16)));
+	CurrentBlock = Blocks.Num() - 1;
+	Offset = Size;
+
+	UE_LOG(MiceMenRulesLog, Verbose, TEXT("FMM_SearchArena::Allocate | Added block %i of %llu bytes"), CurrentBlock, static_cast<uint64>(NewBlock.Size));
+	return NewBlock.Memory;
+}
+
+void FMM_SearchArena::PopMark(const FMark& Mark)
+{
+	CurrentBlock = Mark.Block;
+	Offset = Mark.Offset;
+}
+
+// ################################ Stats ################################
+
+SIZE_T FMM_SearchArena::GetAllocatedSize() const
+{
+	SIZE_T AllocatedSize = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		AllocatedSize += Block.Size;
+	}
+	return AllocatedSize;
+}
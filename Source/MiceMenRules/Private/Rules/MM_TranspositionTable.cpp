@@ -0,0 +1,125 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#include "Rules/MM_TranspositionTable.h"
+
+#include "MiceMenRules.h"
+
+// Bit layout of a packed entry
+static constexpr int32 ScoreShift = 0;
+static constexpr int32 DepthShift = 32;
+static constexpr int32 BoundShift = 40;
+static constexpr int32 ColumnShift = 42;
+static constexpr int32 UpShift = 54;
+static constexpr int32 GenerationShift = 55;
+static constexpr uint64 ColumnMask = (1ull << 12) - 1;
+
+// ################################ Setup ################################
+
+void FMM_TranspositionTable::Resize(int32 SizeInMegabytes)
+{
+	const uint64 MaxEntryCount = static_cast<uint64>(FMath::Max(SizeInMegabytes, 0)) * 1024 * 1024 / sizeof(FSlot);
+	const int64 NewEntryCount = MaxEntryCount > 0 ? static_cast<int64>(1ull << FMath::FloorLog2_64(MaxEntryCount)) : 0;
+
+	// Same size only needs clearing
+	if (NewEntryCount == EntryCount)
+	{
+		Clear();
+		return;
+	}
+
+	EntryCount = NewEntryCount;
+	IndexMask = EntryCount > 0 ? static_cast<uint64>(EntryCount - 1) : 0;
+	Slots = EntryCount > 0 ? MakeUnique<FSlot[]>(EntryCount) : nullptr;
+	Clear();
+
+	UE_LOG(MiceMenRulesLog, Log, TEXT("FMM_TranspositionTable::Resize | %lld entries in %i MB"), EntryCount, SizeInMegabytes);
+}
+
+void FMM_TranspositionTable::Clear()
+{
+	for (int64 i = 0; i < EntryCount; i++)
+	{
+		Slots[i].KeyXorData.store(0, std::memory_order_relaxed);
+		Slots[i].Data.store(0, std::memory_order_relaxed);
+	}
+	Generation.store(0, std::memory_order_relaxed);
+}
+
+void FMM_TranspositionTable::NewSearch()
+{
+	Generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ################################ Entries ################################
+
+bool FMM_TranspositionTable::Probe(uint64 Key, FMM_TranspositionEntry& OutEntry) const
+{
+	if (EntryCount <= 0)
+	{
+		return false;
+	}
+
+	const FSlot& Slot = Slots[Key & IndexMask];
+	const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+	const uint64 KeyXorData = Slot.KeyXorData.load(std::memory_order_relaxed);
+
+	// Another position, or a slot torn by writes from another thread
+	if ((KeyXorData ^ Data) != Key || Data == 0)
+	{
+		return false;
+	}
+
+	uint8 EntryGeneration;
+	UnpackEntry(Data, OutEntry, EntryGeneration);
+	return OutEntry.Bound != ESearchBound::E_NONE;
+}
+
+void FMM_TranspositionTable::Store(uint64 Key, const FMM_TranspositionEntry& Entry)
+{
+	if (EntryCount <= 0)
+	{
+		return;
+	}
+
+	FSlot& Slot = Slots[Key & IndexMask];
+	const uint8 CurrentGeneration = Generation.load(std::memory_order_relaxed);
+
+	// Keep deeper results for other positions from this search
+	const uint64 OldData = Slot.Data.load(std::memory_order_relaxed);
+	if (OldData != 0 && (Slot.KeyXorData.load(std::memory_order_relaxed) ^ OldData) != Key)
+	{
+		FMM_TranspositionEntry OldEntry;
+		uint8 OldGeneration;
+		UnpackEntry(OldData, OldEntry, OldGeneration);
+		if (OldGeneration == CurrentGeneration && OldEntry.Depth > Entry.Depth)
+		{
+			return;
+		}
+	}
+
+	const uint64 Data = PackEntry(Entry, CurrentGeneration);
+	Slot.KeyXorData.store(Key ^ Data, std::memory_order_relaxed);
+	Slot.Data.store(Data, std::memory_order_relaxed);
+}
+
+uint64 FMM_TranspositionTable::PackEntry(const FMM_TranspositionEntry& Entry, uint8 EntryGeneration)
+{
+	// Columns past the packed range are stored without a move
+	const uint64 PackedColumn = static_cast<uint64>(FMath::Max(Entry.BestMove.Column + 1, 0));
+	return static_cast<uint64>(static_cast<uint32>(Entry.Score)) << ScoreShift
+		| static_cast<uint64>(FMath::Clamp(Entry.Depth, 0, 255)) << DepthShift
+		| static_cast<uint64>(Entry.Bound) << BoundShift
+		| (PackedColumn <= ColumnMask ? PackedColumn : 0) << ColumnShift
+		| static_cast<uint64>(Entry.BestMove.bUp) << UpShift
+		| static_cast<uint64>(EntryGeneration) << GenerationShift;
+}
+
+void FMM_TranspositionTable::UnpackEntry(uint64 Data, FMM_TranspositionEntry& OutEntry, uint8& OutGeneration)
+{
+	OutEntry.Score = static_cast<int32>(static_cast<uint32>(Data >> ScoreShift));
+	OutEntry.Depth = static_cast<int32>((Data >> DepthShift) & 0xFF);
+	OutEntry.Bound = static_cast<ESearchBound>((Data >> BoundShift) & 0x3);
+	OutEntry.BestMove.Column = static_cast<int32>((Data >> ColumnShift) & ColumnMask) - 1;
+	OutEntry.BestMove.bUp = ((Data >> UpShift) & 1) != 0;
+	OutGeneration = static_cast<uint8>(Data >> GenerationShift);
+}
@@ -0,0 +1,245 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rules/MM_RulesTypes.h"
+
+/**
+ * Layout of a board by its size, the center group and team ranges the grid manager builds the board with.
+ * Constexpr so fixed size boards resolve it at compile time.
+ */
+struct FMM_BoardLayout
+{
+	/** 1 for odd widths, leaving a single center column between the teams */
+	static constexpr int32 GetGapSize(int32 Width) { return Width % 2; }
+
+	/** Columns each team starts in */
+	static constexpr int32 GetTeamSize(int32 Width) { return (Width - GetGapSize(Width)) / 2; }
+
+	/** Whether the column is in the center group of preset blocks separating the teams at the start */
+	static constexpr bool IsColumnInCenterGroup(int32 Width, int32 X)
+	{
+		return X >= GetTeamSize(Width) - 1 && X <= GetTeamSize(Width) + GetGapSize(Width);
+	}
+
+	/** Whether a preset center block fills the slot, the center column blocks all but every third row and the others every third row */
+	static constexpr bool IsCenterBlockFilled(int32 Width, int32 X, int32 Y)
+	{
+		return IsColumnInCenterGroup(Width, X) && (X == GetTeamSize(Width) ? Y % 3 != 0 : Y % 3 == 0);
+	}
+
+	/** The column a team scores in */
+	static constexpr int32 GetGoalColumn(int32 Width, ERulesTeam Team) { return Team == ERulesTeam::E_TEAM_A ? Width - 1 : 0; }
+
+	static constexpr int32 GetTeamFirstColumn(int32 Width, ERulesTeam Team) { return Team == ERulesTeam::E_TEAM_A ? 0 : GetTeamSize(Width) + GetGapSize(Width); }
+
+	static constexpr int32 GetTeamLastColumn(int32 Width, ERulesTeam Team) { return Team == ERulesTeam::E_TEAM_A ? GetTeamSize(Width) - 1 : Width - 1; }
+};
+
+/**
+ * Board with its size fixed at compile time, for AI search and simulation on common board sizes.
+ * Each column is a bit mask of taken rows, with a mask per team for their mice, so falling, stepping and rotating a column
+ * are a few bit operations and the column loops have constant bounds the compiler can unroll.
+ * Follows the same movement rules as FMM_RulesBoard, which is the fallback for any other size.
+ * Fixed boards walk mice against the board without resolving turns, so they back the advanced AI's move choice and the
+ * puzzle solver, while the expert search plays whole turns on FMM_RulesBoard.
+ */
+template <int32 InWidth, int32 InHeight>
+class TMM_FixedBoard
+{
+public:
+	static constexpr int32 Width = InWidth;
+	static constexpr int32 Height = InHeight;
+
+	static_assert(Width >= 2 && Width <= 64, "Team columns are stored as a 64 bit mask");
+	static_assert(Height >= 1 && Height <= 64, "Columns are stored as 64 bit masks");
+
+	/** All rows of a column */
+	static constexpr uint64 ColumnMask = Height == 64 ? ~0ull : (1ull << Height) - 1;
+
+	static constexpr int32 TeamAGoalColumn = FMM_BoardLayout::GetGoalColumn(Width, ERulesTeam::E_TEAM_A);
+	static constexpr int32 TeamBGoalColumn = FMM_BoardLayout::GetGoalColumn(Width, ERulesTeam::E_TEAM_B);
+
+#pragma region Setup
+
+public:
+	/** Empties every slot */
+	void Reset()
+	{
+		for (int32 x = 0; x < Width; x++)
+		{
+			Taken[x] = 0;
+			TeamMice[0][x] = 0;
+			TeamMice[1][x] = 0;
+		}
+	}
+
+	void SetBlock(int32 X, int32 Y)
+	{
+		Taken[X] |= 1ull << Y;
+	}
+
+	void SetMouse(int32 X, int32 Y, ERulesTeam Team)
+	{
+		Taken[X] |= 1ull << Y;
+		TeamMice[TeamIndex(Team)][X] |= 1ull << Y;
+	}
+
+	/** Whether the coordinates are on the board, a single unsigned compare per axis */
+	static constexpr bool IsInBoard(int32 X, int32 Y)
+	{
+		return static_cast<uint32>(X) < static_cast<uint32>(Width) && static_cast<uint32>(Y) < static_cast<uint32>(Height);
+	}
+
+	static constexpr bool IsGoal(int32 X, ERulesTeam Team)
+	{
+		return Team == ERulesTeam::E_TEAM_A ? X >= TeamAGoalColumn : X <= TeamBGoalColumn;
+	}
+
+	bool IsEmpty(int32 X, int32 Y) const { return ((Taken[X] >> Y) & 1) == 0; }
+
+	/** Columns with any of the team's mice, one bit per column */
+	uint64 GetTeamColumns(ERulesTeam Team) const
+	{
+		uint64 Columns = 0;
+		for (int32 x = 0; x < Width; x++)
+		{
+			Columns |= static_cast<uint64>(TeamMice[TeamIndex(Team)][x] != 0) << x;
+		}
+		return Columns;
+	}
+
+#pragma endregion
+
+#pragma region Movement
+
+public:
+	/** Row a mouse falls to from the slot, the row above the highest taken slot below it */
+	FORCEINLINE int32 GetLandingRow(int32 X, int32 Y) const
+	{
+		// No taken slots below counts 64 leading zeros, landing on the bottom row
+		const uint64 TakenBelow = Taken[X] & ((1ull << Y) - 1);
+		return 64 - static_cast<int32>(FPlatformMath::CountLeadingZeros64(TakenBelow));
+	}
+
+	/**
+	* Walks from the start by falling then stepping ahead until neither is possible.
+	* @param OutStepCount amount of falls and steps ahead
+	* @return the final position
+	*/
+	FIntPoint Walk(int32 X, int32 Y, ERulesTeam Team, int32& OutStepCount) const
+	{
+		const int32 HorizontalStep = Team == ERulesTeam::E_TEAM_A ? 1 : -1;
+		OutStepCount = 0;
+		while (true)
+		{
+			const int32 LandingRow = GetLandingRow(X, Y);
+			OutStepCount += LandingRow != Y;
+			Y = LandingRow;
+
+			// Step ahead if free, otherwise the walk is complete as falling was already resolved
+			const int32 NextX = X + HorizontalStep;
+			if (static_cast<uint32>(NextX) >= static_cast<uint32>(Width) || !IsEmpty(NextX, Y))
+			{
+				break;
+			}
+
+			X = NextX;
+			OutStepCount++;
+		}
+		return FIntPoint(X, Y);
+	}
+
+	/** Rotates a column by one row, the wrapping row moving to the other end */
+	FORCEINLINE void MoveColumn(int32 Column, bool bUp)
+	{
+		Taken[Column] = RotateColumn(Taken[Column], bUp);
+		TeamMice[0][Column] = RotateColumn(TeamMice[0][Column], bUp);
+		TeamMice[1][Column] = RotateColumn(TeamMice[1][Column], bUp);
+	}
+
+	/** Total steps of all of the team's mice, each walked alone against the board as it is */
+	int32 GetTeamStepCount(ERulesTeam Team) const
+	{
+		int32 TotalStepCount = 0;
+		for (int32 x = 0; x < Width; x++)
+		{
+			for (uint64 Mice = TeamMice[TeamIndex(Team)][x]; Mice != 0; Mice &= Mice - 1)
+			{
+				int32 StepCount;
+				Walk(x, static_cast<int32>(FPlatformMath::CountTrailingZeros64(Mice)), Team, StepCount);
+				TotalStepCount += StepCount;
+			}
+		}
+		return TotalStepCount;
+	}
+
+	/**
+	* Tests moving each candidate column up and down, scoring by the total movement of the team's mice, the same as the grid manager.
+	* The board is returned to its original state after each test.
+	* @return false if no move resulted in any movement
+	*/
+	bool FindBestColumnMove(ERulesTeam Team, TArrayView<const int32> CandidateColumns, int32& OutColumn, bool& bOutUp)
+	{
+		int32 HighestScore = 0;
+		OutColumn = INDEX_NONE;
+
+		// Having up first means the default state when no optimal moves exist will be to move the column upwards
+		bOutUp = true;
+
+		for (const int32 Column : CandidateColumns)
+		{
+			// Skip columns off the board, the same as a failed column move on the grid
+			if (static_cast<uint32>(Column) >= static_cast<uint32>(Width))
+			{
+				continue;
+			}
+
+			for (const bool bUp : {true, false})
+			{
+				MoveColumn(Column, bUp);
+				const int32 Score = GetTeamStepCount(Team);
+				MoveColumn(Column, !bUp);
+
+				if (Score > HighestScore)
+				{
+					HighestScore = Score;
+					OutColumn = Column;
+					bOutUp = bUp;
+				}
+			}
+		}
+
+		return OutColumn != INDEX_NONE;
+	}
+
+protected:
+	static FORCEINLINE uint64 RotateColumn(uint64 Column, bool bUp)
+	{
+		// Upwards the top row wraps to the bottom, downwards the bottom row wraps to the top
+		const uint64 RotatedUp = ((Column << 1) | (Column >> (Height - 1))) & ColumnMask;
+		const uint64 RotatedDown = (Column >> 1) | ((Column & 1) << (Height - 1));
+		return bUp ? RotatedUp : RotatedDown;
+	}
+
+	static constexpr int32 TeamIndex(ERulesTeam Team) { return Team == ERulesTeam::E_TEAM_A ? 0 : 1; }
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Board Variables
+
+protected:
+	/** Taken rows of each column, bit 0 being the bottom row */
+	uint64 Taken[Width] = {};
+
+	/** Rows of each column with a mouse, per team */
+	uint64 TeamMice[2][Width] = {};
+
+#pragma endregion
+};
+
+/** The default board size of the world grid */
+using FMM_StandardBoard = TMM_FixedBoard<19, 13>;
@@ -0,0 +1,586 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rules/MM_RulesTypes.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_ScoringReachability.h"
+
+/**
+ * Up to 64 independent games of the same size, played in lockstep for bulk self play.
+ * Boards are bit sliced, each slot is a 64 bit word holding that slot for every game, one game per bit (lane).
+ * Column moves, falls, steps and the end of game checks are word operations applied to all games at once,
+ * so a turn costs about the same for 64 games as for one.
+ *
+ * Turns follow FMM_RulesBoard::PlayTurn exactly, including the sequential cascade order:
+ * every pass goes through the slots lowest then most forward first, the first team then the other.
+ * A mouse always lands on a slot earlier in that order, so each mouse is walked once per pass as on the rules board.
+ * Every game plays the same team each turn, with their own column and direction.
+ */
+template <int32 InWidth, int32 InHeight>
+class TMM_LockstepBoards
+{
+public:
+	static constexpr int32 Width = InWidth;
+	static constexpr int32 Height = InHeight;
+	static constexpr int32 MaxLanes = 64;
+
+	static_assert(Width >= 2 && Height >= 1, "Boards need at least two columns and a row");
+
+#pragma region Setup
+
+public:
+	/**
+	* Empties every lane.
+	* @param InLaneCount games played at once, up to 64
+	* @param InMicePerTeam mice a team needs to complete to win
+	* @param InStalemateTurns turns played once each team has a single mouse before the game is decided on distance
+	*/
+	void Setup(int32 InLaneCount, int32 InMicePerTeam, int32 InStalemateTurns = 8)
+	{
+		LaneCount = FMath::Clamp(InLaneCount, 0, MaxLanes);
+		LaneMask = LaneCount >= 64 ? ~0ull : (1ull << LaneCount) - 1;
+		MicePerTeam = InMicePerTeam;
+		StalemateTurns = InStalemateTurns;
+		GameOverLanes = 0;
+
+		FMemory::Memzero(Taken);
+		FMemory::Memzero(TeamMice);
+		FMemory::Memzero(Scores);
+		FMemory::Memzero(MiceCounts);
+		for (int32 Lane = 0; Lane < MaxLanes; Lane++)
+		{
+			LastMovedColumns[Lane] = INDEX_NONE;
+			StalemateCounts[Lane] = -1;
+		}
+	}
+
+	/**
+	* Copies a board and its game state into a lane, replacing the lane.
+	* @return false if the board size or rules differ
+	*/
+	bool CopyLane(int32 Lane, const FMM_RulesBoard& Board)
+	{
+		// Check the lane and board fit
+		if (!IsValidLane(Lane) || Board.GetWidth() != Width || Board.GetHeight() != Height
+			|| Board.GetMicePerTeam() != MicePerTeam || Board.GetStalemateTurns() != StalemateTurns)
+		{
+			return false;
+		}
+
+		const uint64 LaneBit = 1ull << Lane;
+		for (int32 x = 0; x < Width; x++)
+		{
+			for (int32 y = 0; y < Height; y++)
+			{
+				const bool bTaken = Board.GetSlot(FIntPoint(x, y)) != ERulesSlot::E_EMPTY;
+				Taken[x][y] = (Taken[x][y] & ~LaneBit) | (bTaken ? LaneBit : 0);
+				TeamMice[0][x][y] &= ~LaneBit;
+				TeamMice[1][x][y] &= ~LaneBit;
+			}
+		}
+
+		MiceCounts[0][Lane] = 0;
+		MiceCounts[1][Lane] = 0;
+		for (const FMM_RulesMouse& Mouse : Board.GetMice())
+		{
+			if (Mouse.bActive)
+			{
+				TeamMice[TeamIndex(Mouse.Team)][Mouse.Coord.X][Mouse.Coord.Y] |= LaneBit;
+				MiceCounts[TeamIndex(Mouse.Team)][Lane]++;
+			}
+		}
+
+		Scores[0][Lane] = Board.GetScore(ERulesTeam::E_TEAM_A);
+		Scores[1][Lane] = Board.GetScore(ERulesTeam::E_TEAM_B);
+		LastMovedColumns[Lane] = Board.GetLastMovedColumn();
+		StalemateCounts[Lane] = Board.GetStalemateCount();
+		GameOverLanes = Board.IsGameOver() ? GameOverLanes | LaneBit : GameOverLanes & ~LaneBit;
+		return true;
+	}
+
+	/** Fills every lane with one lane of another set of boards, keeping the lane count */
+	void CopyLaneToAll(const TMM_LockstepBoards& Source, int32 SourceLane)
+	{
+		MicePerTeam = Source.MicePerTeam;
+		StalemateTurns = Source.StalemateTurns;
+
+		// Every lane takes the source lane's bit
+		const auto SpreadLane = [this, SourceLane](uint64 SourceLanes) { return ((SourceLanes >> SourceLane) & 1) != 0 ? LaneMask : 0; };
+		for (int32 x = 0; x < Width; x++)
+		{
+			for (int32 y = 0; y < Height; y++)
+			{
+				Taken[x][y] = SpreadLane(Source.Taken[x][y]);
+				TeamMice[0][x][y] = SpreadLane(Source.TeamMice[0][x][y]);
+				TeamMice[1][x][y] = SpreadLane(Source.TeamMice[1][x][y]);
+			}
+		}
+
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			Scores[0][Lane] = Source.Scores[0][SourceLane];
+			Scores[1][Lane] = Source.Scores[1][SourceLane];
+			MiceCounts[0][Lane] = Source.MiceCounts[0][SourceLane];
+			MiceCounts[1][Lane] = Source.MiceCounts[1][SourceLane];
+			LastMovedColumns[Lane] = Source.LastMovedColumns[SourceLane];
+			StalemateCounts[Lane] = Source.StalemateCounts[SourceLane];
+		}
+		GameOverLanes = SpreadLane(Source.GameOverLanes);
+	}
+
+	int32 GetLaneCount() const { return LaneCount; }
+
+	bool IsValidLane(int32 Lane) const { return Lane >= 0 && Lane < LaneCount; }
+
+#pragma endregion
+
+#pragma region Slots
+
+public:
+	ERulesSlot GetSlot(int32 Lane, int32 X, int32 Y) const
+	{
+		if (((TeamMice[0][X][Y] | TeamMice[1][X][Y]) >> Lane) & 1)
+		{
+			return ERulesSlot::E_MOUSE;
+		}
+		return ((Taken[X][Y] >> Lane) & 1) ? ERulesSlot::E_BLOCK : ERulesSlot::E_EMPTY;
+	}
+
+	/** Team of the mouse in the slot, none if not a mouse */
+	ERulesTeam GetMouseTeam(int32 Lane, int32 X, int32 Y) const
+	{
+		if ((TeamMice[0][X][Y] >> Lane) & 1)
+		{
+			return ERulesTeam::E_TEAM_A;
+		}
+		return ((TeamMice[1][X][Y] >> Lane) & 1) ? ERulesTeam::E_TEAM_B : ERulesTeam::E_NONE;
+	}
+
+	/**
+	* Hashes the slots of every lane, exclusive or'ing the key of each filled slot.
+	* @param GetSlotKey key of a slot, from its index X * Height + Y and 1 for a block, 2 for a team A mouse or 3 for a team B mouse
+	*/
+	template <typename KeyFunctionType>
+	void GetLaneKeys(KeyFunctionType&& GetSlotKey, uint64 (&OutKeys)[MaxLanes]) const
+	{
+		FMemory::Memzero(OutKeys);
+		for (int32 x = 0; x < Width; x++)
+		{
+			for (int32 y = 0; y < Height; y++)
+			{
+				const int32 Index = x * Height + y;
+				ForEachLane(Taken[x][y] & ~TeamMice[0][x][y] & ~TeamMice[1][x][y] & LaneMask, [&](int32 Lane) { OutKeys[Lane] ^= GetSlotKey(Index, 1); });
+				ForEachLane(TeamMice[0][x][y] & LaneMask, [&](int32 Lane) { OutKeys[Lane] ^= GetSlotKey(Index, 2); });
+				ForEachLane(TeamMice[1][x][y] & LaneMask, [&](int32 Lane) { OutKeys[Lane] ^= GetSlotKey(Index, 3); });
+			}
+		}
+	}
+
+	/** Whether the lane has the same slots, mice, scores and game state as the board */
+	bool MatchesBoard(int32 Lane, const FMM_RulesBoard& Board) const
+	{
+		if (!IsValidLane(Lane) || Board.GetWidth() != Width || Board.GetHeight() != Height)
+		{
+			return false;
+		}
+
+		for (int32 x = 0; x < Width; x++)
+		{
+			for (int32 y = 0; y < Height; y++)
+			{
+				if (GetSlot(Lane, x, y) != Board.GetSlot(FIntPoint(x, y)))
+				{
+					return false;
+				}
+			}
+		}
+
+		// Every slot type matched, so matching teams and counts means the mice are the same
+		for (const FMM_RulesMouse& Mouse : Board.GetMice())
+		{
+			if (Mouse.bActive && GetMouseTeam(Lane, Mouse.Coord.X, Mouse.Coord.Y) != Mouse.Team)
+			{
+				return false;
+			}
+		}
+
+		return MiceCounts[0][Lane] == Board.GetTeamMiceCount(ERulesTeam::E_TEAM_A) && MiceCounts[1][Lane] == Board.GetTeamMiceCount(ERulesTeam::E_TEAM_B)
+			&& Scores[0][Lane] == Board.GetScore(ERulesTeam::E_TEAM_A) && Scores[1][Lane] == Board.GetScore(ERulesTeam::E_TEAM_B)
+			&& LastMovedColumns[Lane] == Board.GetLastMovedColumn() && StalemateCounts[Lane] == Board.GetStalemateCount()
+			&& IsGameOver(Lane) == Board.IsGameOver();
+	}
+
+#pragma endregion
+
+#pragma region Turns
+
+public:
+	/** Columns the team can move in the lane, those with their mice apart from the last moved column unless no others remain */
+	void CollectMovableColumns(int32 Lane, ERulesTeam Team, TArray<int32>& OutColumns) const
+	{
+		OutColumns.Reset();
+
+		int32 FailsafeColumn = INDEX_NONE;
+		for (int32 x = 0; x < Width; x++)
+		{
+			if (((GetTeamColumnLanes(Team, x) >> Lane) & 1) == 0)
+			{
+				continue;
+			}
+
+			// Store failsafe column, in case all are removed
+			FailsafeColumn = x;
+
+			// Cannot move the last moved column
+			if (x != LastMovedColumns[Lane])
+			{
+				OutColumns.Add(x);
+			}
+		}
+
+		// Use failsafe column if it was the only one
+		if (OutColumns.Num() <= 0 && FailsafeColumn != INDEX_NONE)
+		{
+			OutColumns.Add(FailsafeColumn);
+		}
+	}
+
+	/** Lanes with any of the team's mice in the column */
+	uint64 GetTeamColumnLanes(ERulesTeam Team, int32 Column) const
+	{
+		uint64 Lanes = 0;
+		for (int32 y = 0; y < Height; y++)
+		{
+			Lanes |= TeamMice[TeamIndex(Team)][Column][y];
+		}
+		return Lanes;
+	}
+
+	/**
+	* Plays a turn of the team in every lane still in play, the same as FMM_RulesBoard::PlayTurn on each lane.
+	* @param LaneColumns column each lane moves, lanes with a column off the board don't take the turn
+	* @param UpLanes lanes moving their column up, the rest move down
+	* @param OutResults result of each lane, sized to the lane count, lanes not taking the turn get an empty result
+	*/
+	void PlayTurn(ERulesTeam Team, TArrayView<const int32> LaneColumns, uint64 UpLanes, TArrayView<FMM_RulesTurnResult> OutResults)
+	{
+		check(LaneColumns.Num() >= LaneCount && OutResults.Num() >= LaneCount);
+
+		// Group the lanes by the column they move
+		uint64 ColumnUpLanes[Width] = {};
+		uint64 ColumnDownLanes[Width] = {};
+		uint64 TurnLanes = 0;
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			OutResults[Lane] = FMM_RulesTurnResult();
+
+			const uint64 LaneBit = 1ull << Lane;
+			const int32 Column = LaneColumns[Lane];
+			if ((GameOverLanes & LaneBit) || Column < 0 || Column >= Width)
+			{
+				continue;
+			}
+
+			(UpLanes & LaneBit ? ColumnUpLanes : ColumnDownLanes)[Column] |= LaneBit;
+			LastMovedColumns[Lane] = Column;
+			TurnLanes |= LaneBit;
+		}
+
+		for (int32 x = 0; x < Width; x++)
+		{
+			if (ColumnUpLanes[x] | ColumnDownLanes[x])
+			{
+				MoveColumn(x, ColumnUpLanes[x], ColumnDownLanes[x]);
+			}
+		}
+
+		ResolveCascade(Team, TurnLanes, OutResults);
+
+		// No more mice can complete, decided on score, stalemates play out their turns and are decided on distance instead
+		const uint64 NoValidMoveLanes = GetNoValidMoveLanes() & TurnLanes & ~GameOverLanes & ~GetStalemateLanes();
+		ForEachLane(NoValidMoveLanes, [this, OutResults](int32 Lane)
+		{
+			OutResults[Lane].Outcome = ERulesOutcome::E_NO_VALID_MOVES;
+			OutResults[Lane].Winner = Scores[0][Lane] == Scores[1][Lane] ? ERulesTeam::E_NONE : Scores[0][Lane] > Scores[1][Lane] ? ERulesTeam::E_TEAM_A : ERulesTeam::E_TEAM_B;
+		});
+		GameOverLanes |= NoValidMoveLanes;
+
+		// If stalemate is active, count the turn taken
+		ForEachLane(TurnLanes & ~GameOverLanes, [this, OutResults](int32 Lane)
+		{
+			if (StalemateCounts[Lane] < 0 || ++StalemateCounts[Lane] < StalemateTurns)
+			{
+				return;
+			}
+
+			const int32 TeamADistance = GetStalemateDistance(Lane, ERulesTeam::E_TEAM_A);
+			const int32 TeamBDistance = GetStalemateDistance(Lane, ERulesTeam::E_TEAM_B);
+			OutResults[Lane].Outcome = ERulesOutcome::E_STALEMATE;
+			OutResults[Lane].Winner = TeamADistance == TeamBDistance ? ERulesTeam::E_NONE : TeamADistance > TeamBDistance ? ERulesTeam::E_TEAM_A : ERulesTeam::E_TEAM_B;
+			GameOverLanes |= 1ull << Lane;
+		});
+	}
+
+	int32 GetScore(int32 Lane, ERulesTeam Team) const { return Scores[TeamIndex(Team)][Lane]; }
+
+	/** Active mice of the team in the lane */
+	int32 GetMiceCount(int32 Lane, ERulesTeam Team) const { return MiceCounts[TeamIndex(Team)][Lane]; }
+
+	bool IsGameOver(int32 Lane) const { return ((GameOverLanes >> Lane) & 1) != 0; }
+
+	/** Lanes still being played */
+	uint64 GetPlayingLanes() const { return LaneMask & ~GameOverLanes; }
+
+	/** Calls the function with the index of each set lane, lowest first */
+	template <typename FunctionType>
+	static FORCEINLINE void ForEachLane(uint64 Lanes, FunctionType&& Function)
+	{
+		for (; Lanes != 0; Lanes &= Lanes - 1)
+		{
+			Function(static_cast<int32>(FPlatformMath::CountTrailingZeros64(Lanes)));
+		}
+	}
+
+protected:
+	/** Rotates the column by one row in the lanes moving it, the wrapping row moving to the other end */
+	void MoveColumn(int32 Column, uint64 UpLanes, uint64 DownLanes)
+	{
+		const uint64 StillLanes = ~(UpLanes | DownLanes);
+		RotateColumn(Taken[Column], UpLanes, DownLanes, StillLanes);
+		RotateColumn(TeamMice[0][Column], UpLanes, DownLanes, StillLanes);
+		RotateColumn(TeamMice[1][Column], UpLanes, DownLanes, StillLanes);
+	}
+
+	static FORCEINLINE void RotateColumn(uint64 (&Rows)[Height], uint64 UpLanes, uint64 DownLanes, uint64 StillLanes)
+	{
+		uint64 Rotated[Height];
+		for (int32 y = 0; y < Height; y++)
+		{
+			// Upwards the row below moves up into this row, downwards the row above moves down, both wrapping
+			const uint64 Below = Rows[y == 0 ? Height - 1 : y - 1];
+			const uint64 Above = Rows[y == Height - 1 ? 0 : y + 1];
+			Rotated[y] = (Rows[y] & StillLanes) | (Below & UpLanes) | (Above & DownLanes);
+		}
+		FMemory::Memcpy(Rows, Rotated, sizeof(Rotated));
+	}
+
+	/** Moves every mouse that can move in the lanes, repeating passes in each lane until none of its mice move */
+	void ResolveCascade(ERulesTeam FirstTeam, uint64 Lanes, TArrayView<FMM_RulesTurnResult> OutResults)
+	{
+		const ERulesTeam SecondTeam = FirstTeam == ERulesTeam::E_TEAM_A ? ERulesTeam::E_TEAM_B : ERulesTeam::E_TEAM_A;
+
+		uint64 PassLanes = Lanes & ~GameOverLanes;
+		while (PassLanes != 0)
+		{
+			ForEachLane(PassLanes, [OutResults](int32 Lane) { OutResults[Lane].CascadePasses++; });
+
+			uint64 MovedLanes = 0;
+			ResolveTeamPass(FirstTeam, PassLanes, MovedLanes, OutResults);
+			ResolveTeamPass(SecondTeam, PassLanes, MovedLanes, OutResults);
+
+			// Lanes where nothing moved have settled
+			PassLanes &= MovedLanes;
+		}
+	}
+
+	/**
+	* Walks each of the team's mice once, lowest then most forward first.
+	* @param PassLanes lanes in the pass, lanes winning during the pass are removed
+	* @param MovedLanes adds the lanes where any mouse moved
+	*/
+	void ResolveTeamPass(ERulesTeam Team, uint64& PassLanes, uint64& MovedLanes, TArrayView<FMM_RulesTurnResult> OutResults)
+	{
+		const bool bForwardIsRight = Team == ERulesTeam::E_TEAM_A;
+		for (int32 y = 0; y < Height; y++)
+		{
+			for (int32 i = 0; i < Width; i++)
+			{
+				// Walked mice land lower or further forward, so the slots still to come only hold unwalked mice
+				const int32 x = bForwardIsRight ? Width - 1 - i : i;
+				const uint64 WalkingLanes = TeamMice[TeamIndex(Team)][x][y] & PassLanes;
+				if (WalkingLanes != 0)
+				{
+					WalkMice(Team, x, y, WalkingLanes, PassLanes, MovedLanes, OutResults);
+				}
+			}
+		}
+	}
+
+	/** Walks the mouse in the slot of each lane, falling and stepping ahead until blocked, then scores or places it */
+	void WalkMice(ERulesTeam Team, int32 StartX, int32 StartY, uint64 WalkingLanes, uint64& PassLanes, uint64& MovedLanes, TArrayView<FMM_RulesTurnResult> OutResults)
+	{
+		const int32 Index = TeamIndex(Team);
+		const int32 HorizontalStep = Team == ERulesTeam::E_TEAM_A ? 1 : -1;
+
+		// Pick the mice up, the walk only goes down and forward so never passes back through the start
+		Taken[StartX][StartY] &= ~WalkingLanes;
+		TeamMice[Index][StartX][StartY] &= ~WalkingLanes;
+
+		// Rows of the walking mice in the current column, they only ever go down
+		uint64 Walkers[Height] = {};
+		Walkers[StartY] = WalkingLanes;
+
+		uint64 ScoredLanes = 0;
+		uint64 StillLanes = 0;
+		for (int32 x = StartX; ; x += HorizontalStep)
+		{
+			// Fall, sweeping down so a mouse falls through every free slot in one go
+			for (int32 y = StartY; y > 0; y--)
+			{
+				const uint64 Falling = Walkers[y] & ~Taken[x][y - 1];
+				Walkers[y - 1] |= Falling;
+				Walkers[y] &= ~Falling;
+			}
+
+			// Step ahead where free, the rest have finished their walk in this column
+			const int32 NextX = x + HorizontalStep;
+			const bool bNextInBoard = NextX >= 0 && NextX < Width;
+			const bool bGoal = Team == ERulesTeam::E_TEAM_A ? x >= Width - 1 : x <= 0;
+			uint64 RemainingLanes = 0;
+			for (int32 y = 0; y <= StartY; y++)
+			{
+				const uint64 Stepping = bNextInBoard ? Walkers[y] & ~Taken[NextX][y] : 0;
+				uint64 Finished = Walkers[y] & ~Stepping;
+				Walkers[y] = Stepping;
+				RemainingLanes |= Stepping;
+
+				// Mice that never left the start didn't move
+				if (x == StartX && y == StartY)
+				{
+					StillLanes = Finished;
+				}
+
+				// Moved mice at their goal score instead of being placed
+				const uint64 Scoring = bGoal ? Finished & ~StillLanes : 0;
+				ScoredLanes |= Scoring;
+				Finished &= ~Scoring;
+				Taken[x][y] |= Finished;
+				TeamMice[Index][x][y] |= Finished;
+			}
+
+			if (RemainingLanes == 0)
+			{
+				break;
+			}
+		}
+
+		const uint64 Moved = WalkingLanes & ~StillLanes;
+		MovedLanes |= Moved;
+		ForEachLane(Moved, [OutResults](int32 Lane) { OutResults[Lane].MiceMoved++; });
+
+		// Score a point and clear the mouse, the last mouse of the team winning the game
+		ForEachLane(ScoredLanes, [this, Team, Index, &PassLanes, OutResults](int32 Lane)
+		{
+			Scores[Index][Lane]++;
+			MiceCounts[Index][Lane]--;
+			OutResults[Lane].GoalsScored++;
+
+			// Each team down to their last mouse starts counting stalemate turns
+			if (StalemateCounts[Lane] < 0 && MiceCounts[0][Lane] == 1 && MiceCounts[1][Lane] == 1)
+			{
+				StalemateCounts[Lane] = 0;
+			}
+
+			if (Scores[Index][Lane] >= MicePerTeam)
+			{
+				OutResults[Lane].Outcome = ERulesOutcome::E_ALL_MICE_COMPLETED;
+				OutResults[Lane].Winner = Team;
+				GameOverLanes |= 1ull << Lane;
+				PassLanes &= ~(1ull << Lane);
+			}
+		});
+	}
+
+	/** Lanes where no mouse of either team can still reach its goal, following FMM_RulesBoard::HasNoValidMoves */
+	uint64 GetNoValidMoveLanes() const
+	{
+		uint64 FullColumns[Width];
+		uint64 TeamColumns[2][Width];
+		uint64 CanEmptyColumns[Width];
+		for (int32 x = 0; x < Width; x++)
+		{
+			FullColumns[x] = ~0ull;
+			for (int32 y = 0; y < Height; y++)
+			{
+				FullColumns[x] &= Taken[x][y];
+			}
+			TeamColumns[0][x] = GetTeamColumnLanes(ERulesTeam::E_TEAM_A, x);
+			TeamColumns[1][x] = GetTeamColumnLanes(ERulesTeam::E_TEAM_B, x);
+		}
+
+		return LaneMask & ~FMM_ScoringReachability::GetScorableLanes(FullColumns, TeamColumns[0], TeamColumns[1], LaneMask, CanEmptyColumns);
+	}
+
+	/** Lanes counting stalemate turns */
+	uint64 GetStalemateLanes() const
+	{
+		uint64 StalemateLanes = 0;
+		for (int32 Lane = 0; Lane < LaneCount; Lane++)
+		{
+			StalemateLanes |= StalemateCounts[Lane] >= 0 ? 1ull << Lane : 0;
+		}
+		return StalemateLanes;
+	}
+
+	/** Distance of the team's remaining mouse from their starting side, 0 if none remain */
+	int32 GetStalemateDistance(int32 Lane, ERulesTeam Team) const
+	{
+		const int32 StartX = Team == ERulesTeam::E_TEAM_A ? 0 : Width - 1;
+		for (int32 x = 0; x < Width; x++)
+		{
+			if ((GetTeamColumnLanes(Team, x) >> Lane) & 1)
+			{
+				return FMath::Abs(StartX - x);
+			}
+		}
+		return 0;
+	}
+
+	static constexpr int32 TeamIndex(ERulesTeam Team) { return Team == ERulesTeam::E_TEAM_A ? 0 : 1; }
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Board Variables
+
+protected:
+	/** Taken lanes of each slot */
+	uint64 Taken[Width][Height];
+
+	/** Lanes with a mouse in each slot, per team */
+	uint64 TeamMice[2][Width][Height];
+
+#pragma endregion
+
+#pragma region Game Variables
+
+protected:
+	int32 LaneCount = 0;
+
+	/** A bit for every lane in use */
+	uint64 LaneMask = 0;
+
+	uint64 GameOverLanes = 0;
+
+	int32 MicePerTeam = 0;
+
+	int32 StalemateTurns = 8;
+
+	int32 Scores[2][MaxLanes];
+
+	/** Active mice of each team */
+	int32 MiceCounts[2][MaxLanes];
+
+	int32 LastMovedColumns[MaxLanes];
+
+	/** Turns taken since stalemate began, -1 if not in stalemate */
+	int32 StalemateCounts[MaxLanes];
+
+#pragma endregion
+};
+
+/** Lockstep games on the default board size of the world grid */
+using FMM_StandardLockstepBoards = TMM_LockstepBoards<19, 13>;
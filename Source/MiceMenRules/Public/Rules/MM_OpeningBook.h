@@ -0,0 +1,107 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rules/MM_TranspositionTable.h"
+
+struct FMM_RulesBoard;
+enum class ERulesTeam : uint8;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/** A searched move for an opening position, stored as is in the book file */
+struct FMM_OpeningBookEntry
+{
+	/** Key of the position the move is for, from FMM_OpeningBook::GetPositionKey */
+	uint64 Key = 0;
+
+	/** Search score for the team moving */
+	int32 Score = 0;
+
+	int16 Column = INDEX_NONE;
+
+	uint8 bUp = 1;
+
+	/** Turns the move was searched ahead */
+	uint8 Depth = 0;
+};
+static_assert(sizeof(FMM_OpeningBookEntry) == 16, "Book entries are written to file as is");
+
+/**
+ * Best moves for opening positions, searched offline and read from a memory mapped file.
+ * Entries are sorted by key, so finding a move is a binary search over the mapped file without loading or parsing it.
+ * The file is a header followed by the entries, in the byte order of the platform that wrote it.
+ */
+class MICEMENRULES_API FMM_OpeningBook
+{
+public:
+	FMM_OpeningBook();
+
+	~FMM_OpeningBook();
+
+	FMM_OpeningBook(const FMM_OpeningBook&) = delete;
+
+	FMM_OpeningBook& operator=(const FMM_OpeningBook&) = delete;
+
+#pragma region File
+
+public:
+	/** Maps the book file, closing any open book. False if it is missing or not a book */
+	bool Open(const FString& FilePath);
+
+	void Close();
+
+	bool IsOpen() const { return Entries.Num() > 0; }
+
+	int32 GetEntryCount() const { return Entries.Num(); }
+
+	/** Sorts the entries by key, keeping the deepest entry of each position, then writes them as a book file */
+	static bool Write(const FString& FilePath, TArray<FMM_OpeningBookEntry>& InEntries);
+
+#pragma endregion
+
+#pragma region Moves
+
+public:
+	/** Finds the stored move for the position key, false if the position is not in the book */
+	bool FindMove(uint64 Key, FMM_SearchMove& OutMove) const;
+
+	/**
+	* Key of the position for the team about to move.
+	* Only the moving team's own same column count is included, as it is all a player knows during a game.
+	* @param SameColumnMax times in a row the team can move the same column, only whether the count reached it is keyed
+	*/
+	static uint64 GetPositionKey(const FMM_RulesBoard& Board, ERulesTeam Team, int32 LastMovedColumn, int32 SameMovedColumnCount, int32 SameColumnMax);
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Book Variables
+
+protected:
+	/** Start of a book file */
+	struct FHeader
+	{
+		uint32 Magic = 0;
+
+		uint32 Version = 0;
+
+		uint64 EntryCount = 0;
+	};
+
+	static constexpr uint32 BookMagic = 0x424F4D4D;
+
+	/** Changes whenever the file layout or the position key changes, older books are not opened */
+	static constexpr uint32 BookVersion = 2;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** Sorted entries in the mapped region */
+	TArrayView<const FMM_OpeningBookEntry> Entries;
+
+#pragma endregion
+};
@@ -0,0 +1,263 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rules/MM_RulesTypes.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_LockstepBoards.h"
+#include "Rules/MM_RulesSearch.h"
+
+/** Outcome of solving a puzzle */
+enum class EPuzzleResult : uint8
+{
+	/** The board was not searched */
+	E_NONE,
+
+	/** A shortest sequence of moves was found */
+	E_SOLVED,
+	/** Every board that can be reached was searched without the team completing all their mice */
+	E_NO_SOLUTION,
+	/** Stopped at the move or board limit before finding a solution or searching every board */
+	E_LIMIT_REACHED
+};
+
+/** Limits of a puzzle solve */
+struct FMM_PuzzleSettings
+{
+	/** Longest sequence of moves searched for */
+	int32 MaxMoves = 8;
+
+	/** Boards played before giving up */
+	int64 MaxBoards = 50000000;
+};
+
+/**
+ * Finds the fewest column moves that bring all of one team's mice to their goal, with only that team moving.
+ * Any column can be moved either way, so every board has 2 * Width moves.
+ *
+ * Iterative deepening (IDA* with every unsolved board at least one move away), one more move allowed each iteration.
+ * Every move of a board is played at once on lockstep boards, a lane per move, so expanding a board costs about one turn.
+ * Boards are hashed by their slots, and a board already reached in as few moves during the iteration is not searched again.
+ * If an iteration ends without any board stopped by the move limit, every reachable board was searched and there is no solution.
+ *
+ * Turns follow the rules board apart from how the game ends, the puzzle only ends when the team has no mice left,
+ * so neither team winning on score nor stalemate ends it. Boards with no valid moves left are dead ends.
+ */
+template <int32 InWidth, int32 InHeight>
+class TMM_PuzzleSolver
+{
+public:
+	using FBoards = TMM_LockstepBoards<InWidth, InHeight>;
+
+	static constexpr int32 MoveCount = InWidth * 2;
+
+	static_assert(MoveCount <= FBoards::MaxLanes, "Every move of a board is played in a lane of its own");
+
+	TMM_PuzzleSolver()
+	{
+		// Lane 2 * Column moves the column up, the next lane moves it down
+		for (int32 Lane = 0; Lane < MoveCount; Lane++)
+		{
+			LaneColumns[Lane] = Lane / 2;
+			UpLanes |= Lane % 2 == 0 ? 1ull << Lane : 0;
+		}
+	}
+
+#pragma region Solve
+
+public:
+	/**
+	* Searches for the shortest sequence of the team's moves that completes all their mice.
+	* @param OutMoves the moves in order when solved
+	*/
+	EPuzzleResult Solve(const FMM_RulesBoard& Board, ERulesTeam Team, const FMM_PuzzleSettings& Settings, TArray<FMM_SearchMove>& OutMoves)
+	{
+		OutMoves.Reset();
+		BoardCount = 0;
+
+		// Check the board fits and has mice to bring home
+		if (Board.GetWidth() != InWidth || Board.GetHeight() != InHeight || (Team != ERulesTeam::E_TEAM_A && Team != ERulesTeam::E_TEAM_B))
+		{
+			return EPuzzleResult::E_NONE;
+		}
+		if (Board.GetTeamMiceCount(Team) <= 0)
+		{
+			return EPuzzleResult::E_SOLVED;
+		}
+
+		SolvingTeam = Team;
+		MaxBoards = Settings.MaxBoards;
+		const int32 MaxMoves = FMath::Max(Settings.MaxMoves, 0);
+
+		// The start in the only lane of the first boards, the moves of each ply after
+		Boards.SetNum(MaxMoves + 1);
+		NodeLanes.SetNum(MaxMoves + 1);
+		for (int32 Ply = 0; Ply <= MaxMoves; Ply++)
+		{
+			if (!Boards[Ply])
+			{
+				Boards[Ply] = MakeUnique<FBoards>();
+			}
+			Boards[Ply]->Setup(Ply == 0 ? 1 : MoveCount, MAX_int32, MAX_int32);
+		}
+		FMM_RulesBoard PuzzleBoard;
+		BuildPuzzleBoard(Board, PuzzleBoard);
+		Boards[0]->CopyLane(0, PuzzleBoard);
+		NodeLanes[0] = 0;
+
+		uint64 StartKeys[FBoards::MaxLanes];
+		Boards[0]->GetLaneKeys(&FMM_RulesBoard::GetCellKey, StartKeys);
+
+		for (int32 Bound = 1; Bound <= MaxMoves; Bound++)
+		{
+			ReachedPlies.Reset();
+			ReachedPlies.Add(StartKeys[0], 0);
+			bBoundReached = false;
+			bBoardLimitReached = false;
+
+			int32 SolutionLength = 0;
+			if (SearchPly(0, Bound, SolutionLength))
+			{
+				for (int32 Ply = 1; Ply <= SolutionLength; Ply++)
+				{
+					OutMoves.Add({LaneColumns[NodeLanes[Ply]], ((UpLanes >> NodeLanes[Ply]) & 1) != 0});
+				}
+				return EPuzzleResult::E_SOLVED;
+			}
+
+			// Nothing was left unsearched at this bound, so no longer sequence can reach anything new
+			if (bBoardLimitReached)
+			{
+				return EPuzzleResult::E_LIMIT_REACHED;
+			}
+			if (!bBoundReached)
+			{
+				return EPuzzleResult::E_NO_SOLUTION;
+			}
+		}
+
+		return EPuzzleResult::E_LIMIT_REACHED;
+	}
+
+	/** Boards played by the last solve */
+	int64 GetBoardCount() const { return BoardCount; }
+
+	/** Copies the board with rules that only end the game when no valid moves remain, as the puzzle plays */
+	static void BuildPuzzleBoard(const FMM_RulesBoard& Board, FMM_RulesBoard& OutPuzzleBoard)
+	{
+		OutPuzzleBoard.Setup(Board.GetWidth(), Board.GetHeight(), MAX_int32, MAX_int32);
+		for (int32 x = 0; x < Board.GetWidth(); x++)
+		{
+			for (int32 y = 0; y < Board.GetHeight(); y++)
+			{
+				if (Board.GetSlot(FIntPoint(x, y)) == ERulesSlot::E_BLOCK)
+				{
+					OutPuzzleBoard.AddBlock(FIntPoint(x, y));
+				}
+			}
+		}
+		for (const FMM_RulesMouse& Mouse : Board.GetMice())
+		{
+			if (Mouse.bActive)
+			{
+				OutPuzzleBoard.AddMouse(Mouse.Coord, Mouse.Team);
+			}
+		}
+		OutPuzzleBoard.SetGameState(Board.GetScore(ERulesTeam::E_TEAM_A), Board.GetScore(ERulesTeam::E_TEAM_B), Board.GetLastMovedColumn(), Board.GetStalemateCount());
+	}
+
+protected:
+	/**
+	* Plays every move from the ply's board, then searches each new board while within the bound.
+	* @param OutSolutionLength moves in the solution when found
+	* @return true if a solution was found, its lanes in NodeLanes
+	*/
+	bool SearchPly(int32 Ply, int32 Bound, int32& OutSolutionLength)
+	{
+		FBoards& Children = *Boards[Ply + 1];
+		Children.CopyLaneToAll(*Boards[Ply], NodeLanes[Ply]);
+		Children.PlayTurn(SolvingTeam, LaneColumns, UpLanes, Results);
+		BoardCount += MoveCount;
+
+		// Shallower bounds found no solution, so any solution here is a shortest one
+		for (int32 Lane = 0; Lane < MoveCount; Lane++)
+		{
+			if (Children.GetMiceCount(Lane, SolvingTeam) <= 0)
+			{
+				NodeLanes[Ply + 1] = Lane;
+				OutSolutionLength = Ply + 1;
+				return true;
+			}
+		}
+
+		uint64 Keys[FBoards::MaxLanes];
+		Children.GetLaneKeys(&FMM_RulesBoard::GetCellKey, Keys);
+
+		bool bFound = false;
+		FBoards::ForEachLane(Children.GetPlayingLanes(), [&](int32 Lane)
+		{
+			// Boards already reached in as few moves are searched from there
+			const int32* ReachedPly = ReachedPlies.Find(Keys[Lane]);
+			if (bFound || bBoardLimitReached || (ReachedPly && *ReachedPly <= Ply + 1))
+			{
+				return;
+			}
+
+			// Boards at the bound are searched by the next iteration
+			if (Ply + 1 >= Bound)
+			{
+				bBoundReached = true;
+				return;
+			}
+			if (BoardCount >= MaxBoards)
+			{
+				bBoardLimitReached = true;
+				return;
+			}
+
+			ReachedPlies.Add(Keys[Lane], Ply + 1);
+			NodeLanes[Ply + 1] = Lane;
+			bFound = SearchPly(Ply + 1, Bound, OutSolutionLength);
+		});
+		return bFound;
+	}
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Solver Variables
+
+protected:
+	/** Boards of every move from the current board at each ply, the start board in the first */
+	TArray<TUniquePtr<FBoards>> Boards;
+
+	/** Lane of the current board at each ply */
+	TArray<int32> NodeLanes;
+
+	/** Fewest moves each board was reached with in the current iteration */
+	TMap<uint64, int32> ReachedPlies;
+
+	int32 LaneColumns[FBoards::MaxLanes] = {};
+
+	uint64 UpLanes = 0;
+
+	FMM_RulesTurnResult Results[FBoards::MaxLanes];
+
+	ERulesTeam SolvingTeam = ERulesTeam::E_NONE;
+
+	int64 BoardCount = 0;
+
+	int64 MaxBoards = 0;
+
+	/** A new board was left unsearched by the move limit */
+	bool bBoundReached = false;
+
+	bool bBoardLimitReached = false;
+
+#pragma endregion
+};
+
+/** Puzzles on the default board size of the world grid */
+using FMM_StandardPuzzleSolver = TMM_PuzzleSolver<19, 13>;
@@ -0,0 +1,203 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rules/MM_RulesTypes.h"
+
+/**
+ * The game rules on a plain board, without actors, objects or a world.
+ * Follows the same rules as the grid manager and game mode: mice fall then step ahead until blocked,
+ * cascades process the lowest and most forward mice first starting with the moving team,
+ * and the game ends on a team completing all mice, no valid moves or the stalemate turns running out.
+ * Used for simulations, benchmarks and bot tooling, the grid manager can copy its state with BuildRulesBoard.
+ */
+struct MICEMENRULES_API FMM_RulesBoard
+{
+#pragma region Setup
+
+public:
+	/**
+	* Sizes an empty board with no mice.
+	* @param InMicePerTeam mice a team needs to complete to win
+	* @param InStalemateTurns turns played once each team has a single mouse before the game is decided on distance
+	*/
+	void Setup(int InWidth, int InHeight, int InMicePerTeam, int InStalemateTurns = 8);
+
+	/** Places a block in an empty slot */
+	bool AddBlock(const FIntPoint& Coord);
+
+	/** Places a mouse in an empty slot, it doesn't move until the next cascade */
+	bool AddMouse(const FIntPoint& Coord, ERulesTeam Team);
+
+	/** Sets the state carried between turns, used when copying a game in progress */
+	void SetGameState(int TeamAScore, int TeamBScore, int InLastMovedColumn, int InStalemateCount);
+
+	int GetWidth() const { return Width; }
+
+	int GetHeight() const { return Height; }
+
+	int GetMicePerTeam() const { return MicePerTeam; }
+
+	int GetStalemateTurns() const { return StalemateTurns; }
+
+#pragma endregion
+
+#pragma region Slots
+
+public:
+	ERulesSlot GetSlot(const FIntPoint& Coord) const { return Slots[CoordToIndex(Coord)]; }
+
+	bool IsInBoard(const FIntPoint& Coord) const { return Coord.X >= 0 && Coord.X < Width && Coord.Y >= 0 && Coord.Y < Height; }
+
+	/** All mice, including completed mice which are no longer active */
+	const TArray<FMM_RulesMouse>& GetMice() const { return Mice; }
+
+	/** Active mice of the team */
+	int GetTeamMiceCount(ERulesTeam Team) const;
+
+	/** Zobrist key of every block and mouse, kept up to date as slots change so positions are keyed without a board scan */
+	uint64 GetCellsKey() const { return CellsKey; }
+
+	/** Zobrist key of a filled slot by index, 1 for a block, 2 for a team A mouse and 3 for a team B mouse */
+	static uint64 GetCellKey(int32 Index, uint8 Cell) { return MM_MixKey(static_cast<uint64>(Index) * 4 + Cell); }
+
+protected:
+	int CoordToIndex(const FIntPoint& Coord) const { return Coord.X * Height + Coord.Y; }
+
+	/** Key of the block or mouse in the slot, 0 if empty */
+	uint64 GetSlotKey(int32 Index) const;
+
+	/** Stores the slot and the mouse in it, updating the landing rows above */
+	void SetSlot(const FIntPoint& Coord, ERulesSlot Slot, int32 MouseIndex);
+
+#pragma endregion
+
+#pragma region Movement
+
+public:
+	/** Direction along the board the team goes */
+	static int GetHorizontalStep(ERulesTeam Team) { return Team == ERulesTeam::E_TEAM_A ? 1 : -1; }
+
+	/** Whether the coordinate is the team's goal column */
+	bool IsGoal(const FIntPoint& Coord, ERulesTeam Team) const;
+
+	/**
+	* Walks from the start by falling then stepping ahead until neither is possible.
+	* @param OutStepCount amount of falls and steps ahead
+	* @param OutPath if set, has each position after the start added
+	* @return the final position
+	*/
+	FIntPoint Walk(const FIntPoint& Start, ERulesTeam Team, int& OutStepCount, TArray<FIntPoint>* OutPath = nullptr) const;
+
+	/** Rotates a column by one slot, the wrapping slot moving to the other end, and updates the mice in it */
+	bool MoveColumn(int Column, bool bUp);
+
+	/**
+	* Moves every mouse that can move, repeating passes until none do.
+	* Each pass orders the first team's mice then the other team's, lowest then most forward first.
+	* Stops as soon as a team completes all of their mice.
+	* @param OutLog if set, reset and filled with every mouse movement and its path
+	* @return the passes, moves and goals, with the outcome set if a team won
+	*/
+	FMM_RulesTurnResult ResolveCascade(ERulesTeam FirstTeam, FMM_RulesCascadeLog* OutLog = nullptr);
+
+protected:
+	/** Lowers the landing rows above a slot after it changed between empty and taken */
+	void UpdateLandingRowsAbove(const FIntPoint& Coord);
+
+	/** Orders the team's active mice for a cascade pass, adding them to the pass order */
+	void AddTeamToPassOrder(ERulesTeam Team);
+
+#pragma endregion
+
+#pragma region Turns
+
+public:
+	/** Columns the team can move, those with their mice apart from the last moved column unless no others remain */
+	void CollectMovableColumns(ERulesTeam Team, TArray<int>& OutColumns) const;
+
+	/**
+	* Moves the column, resolves the cascade and checks for the end of the game, following the game mode's turn.
+	* @param OutLog if set, filled with the cascade's mouse movements
+	*/
+	FMM_RulesTurnResult PlayTurn(ERulesTeam Team, int Column, bool bUp, FMM_RulesCascadeLog* OutLog = nullptr);
+
+	int GetScore(ERulesTeam Team) const;
+
+	/** Whether a team has completed all of their mice */
+	bool HasTeamWon(ERulesTeam Team) const { return GetScore(Team) >= MicePerTeam; }
+
+	/** Whether no mouse of either team can reach its goal under any sequence of column moves, so no more mice can complete */
+	bool HasNoValidMoves() const;
+
+	/** Each team down to their last mouse */
+	bool IsStalemate() const;
+
+	/**
+	* The team whose remaining mouse is furthest from their start.
+	* @return none for a tie
+	*/
+	ERulesTeam GetWinningStalemateTeam(int& OutDistanceWonBy) const;
+
+	bool IsGameOver() const { return bGameOver; }
+
+	int GetLastMovedColumn() const { return LastMovedColumn; }
+
+	/** Turns taken since stalemate began, -1 if not in stalemate */
+	int GetStalemateCount() const { return StalemateCount; }
+
+protected:
+	/** Starts counting stalemate turns if each team is down to their last mouse */
+	void CheckForStalemate();
+
+	static int TeamIndex(ERulesTeam Team) { return static_cast<int>(Team) - 1; }
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Board Variables
+
+protected:
+	int Width = 0;
+
+	int Height = 0;
+
+	/** Same layout as the game's grid, index is X * Height + Y */
+	TArray<ERulesSlot> Slots;
+
+	/** Index of the mouse in each slot, INDEX_NONE if not a mouse */
+	TArray<int32> SlotMice;
+
+	/** For each slot, the row a mouse falls to from it */
+	TArray<int32> LandingRows;
+
+	TArray<FMM_RulesMouse> Mice;
+
+	/** Reused order of mice for each cascade pass */
+	TArray<int32> PassOrder;
+
+	/** See GetCellsKey */
+	uint64 CellsKey = 0;
+
+#pragma endregion
+
+#pragma region Game Variables
+
+protected:
+	int MicePerTeam = 0;
+
+	int StalemateTurns = 8;
+
+	/** Turns taken since stalemate began, -1 if not in stalemate */
+	int StalemateCount = -1;
+
+	int LastMovedColumn = INDEX_NONE;
+
+	int Scores[2] = {0, 0};
+
+	bool bGameOver = false;
+
+#pragma endregion
+};
@@ -0,0 +1,201 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rules/MM_RulesTypes.h"
+#include "Rules/MM_RulesBoard.h"
+#include "Rules/MM_TranspositionTable.h"
+#include "Rules/MM_SearchArena.h"
+#include "HAL/ThreadSingleton.h"
+
+/** Each team's last moved column and how many times in a row, limiting the same column the way the player's pawn does */
+struct FMM_SameColumnLimits
+{
+	int32 LastMovedColumns[2] = {INDEX_NONE, INDEX_NONE};
+
+	int32 SameMovedColumnCounts[2] = {0, 0};
+
+	/** Counts the column moved, restarting the count for a different column */
+	void RecordMove(ERulesTeam Team, int32 Column)
+	{
+		const int32 Index = Team == ERulesTeam::E_TEAM_A ? 0 : 1;
+		SameMovedColumnCounts[Index] = LastMovedColumns[Index] == Column ? SameMovedColumnCounts[Index] + 1 : 1;
+		LastMovedColumns[Index] = Column;
+	}
+
+	/** The column the team can't move again until it moves another, INDEX_NONE if it is under the limit */
+	int32 GetLimitedColumn(int32 Index, int32 SameColumnMax) const
+	{
+		return SameMovedColumnCounts[Index] >= SameColumnMax ? LastMovedColumns[Index] : INDEX_NONE;
+	}
+};
+
+/**
+ * A search position, keyed by the board's cells key with the side state that changes the moves available or the outcome:
+ * last moved column, each team's column at the same column limit, stalemate count, scores and the team to move.
+ * The board keeps its cells key up to date as turns are played, so packing a position doesn't scan the board.
+ * Counts under the limit are left out, so the same board keys the same whether a column was moved once or five times,
+ * and positions searched last turn still match after the opponent's limit starts over at the next root.
+ * Hashed with Zobrist keys, so positions reached by different moves share transposition table entries.
+ */
+struct MICEMENRULES_API FMM_PackedPosition
+{
+	/**
+	* Packs the board's side state, keyed with the board's cells.
+	* @param SameColumnMax times in a row a team can move the same column, as in FMM_SearchSettings
+	*/
+	void Pack(const FMM_RulesBoard& Board, ERulesTeam SideToMove, const FMM_SameColumnLimits& ColumnLimits, int32 SameColumnMax);
+
+	uint64 GetKey() const { return Key; }
+
+	/** Same key and side state, boards are only told apart by their key */
+	bool operator==(const FMM_PackedPosition& Other) const;
+
+protected:
+	/** Key of a side state value, so side state and cells don't cancel out */
+	static uint64 GetSideKey(uint64 Salt, int32 Value);
+
+	int16 LastMovedColumn = INDEX_NONE;
+
+	/** Each team's column at the same column limit, INDEX_NONE when under it */
+	int16 LimitedColumns[2] = {INDEX_NONE, INDEX_NONE};
+
+	int8 StalemateCount = -1;
+
+	int16 Scores[2] = {0, 0};
+
+	ERulesTeam SideToMove = ERulesTeam::E_NONE;
+
+	uint64 Key = 0;
+};
+
+/** Limits of a search */
+struct FMM_SearchSettings
+{
+	/** Turns searched ahead, counting both teams' turns */
+	int32 MaxDepth = 3;
+
+	/** Times in a row a team can move the same column, matching the pawn */
+	int32 SameColumnMax = 6;
+};
+
+/**
+ * Alpha beta search over rules board turns, deepening one turn at a time.
+ * Results are stored in a transposition table that can outlive the search, so searching again on the next turn
+ * starts from the results of the last search and moves found best before are searched first.
+ * Searched positions reuse per thread boards, and their moves come from the thread's arena, released once the move is chosen,
+ * so after a first search, searches make no heap allocations. Searches can run on several threads sharing one table.
+ * Searches run on FMM_RulesBoard for every board size, as turns resolve cascades, scores and stalemates that fixed boards don't.
+ */
+class MICEMENRULES_API FMM_RulesSearch
+{
+public:
+	/** @param InArena scratch memory for the moves of each position, the calling thread's arena by default */
+	explicit FMM_RulesSearch(FMM_TranspositionTable& InTable, FMM_SearchArena& InArena = FMM_SearchArena::Get());
+
+#pragma region Search
+
+public:
+	/**
+	* Searches for the team's best move from the board.
+	* @param ColumnLimits the same moved columns of each team so far
+	* @return false if the game is over or the team has no columns to move
+	*/
+	bool FindBestMove(const FMM_RulesBoard& Board, ERulesTeam Team, const FMM_SameColumnLimits& ColumnLimits, const FMM_SearchSettings& Settings, FMM_SearchMove& OutMove);
+
+	/**
+	* Plays a stalemate perfectly, searching every turn left until it is decided.
+	* Each team can only move the column of their one mouse, so there are at most 2 moves a turn and solving is instant.
+	* @param Settings only the same column max is used, the depth is the turns left
+	* @param OutScore positive if the team wins with perfect play, the higher the sooner, negative if it loses, 0 for a draw
+	* @return false if the board is not in stalemate or the team has no move
+	*/
+	bool SolveStalemate(const FMM_RulesBoard& Board, ERulesTeam Team, const FMM_SameColumnLimits& ColumnLimits, const FMM_SearchSettings& Settings, FMM_SearchMove& OutMove, int32& OutScore);
+
+	/** Score of an unfinished game for the team, from the scores and how far each team's mice are from their start */
+	static int32 Evaluate(const FMM_RulesBoard& Board, ERulesTeam Team);
+
+	/** Score of a game won at the searched position, less a point for each turn until the win, above any unfinished game */
+	static constexpr int32 WinScore = 100000000;
+
+	/** Most turns searched ahead, so no won or lost game scores closer to 0 than WinScore less this */
+	static constexpr int32 MaxSearchDepth = 64;
+
+	/** Whether the score is a won or lost game rather than an evaluation */
+	static bool IsWinScore(int32 Score) { return FMath::Abs(Score) >= WinScore - MaxSearchDepth; }
+
+	int32 GetNodeCount() const { return NodeCount; }
+
+	int32 GetTableHitCount() const { return TableHitCount; }
+
+	/** Score of the last search's move for the team that searched */
+	int32 GetRootScore() const { return RootScore; }
+
+protected:
+	/** Negamax alpha beta, returning the score for the team moving at the ply */
+	int32 Search(int32 Ply, int32 Depth, int32 Alpha, int32 Beta);
+
+	/**
+	* Won and lost scores count turns from the root, the table stores them counting from the position instead,
+	* so they stay right when the position is reached at another ply or from another root.
+	*/
+	static int32 ScoreToTable(int32 Score, int32 Ply);
+
+	static int32 ScoreFromTable(int32 Score, int32 Ply);
+
+	/** Both directions of each column the node's team can move, the table's move first, allocated from the arena */
+	TArrayView<FMM_SearchMove> CollectMoves(int32 Ply, const FMM_SearchMove& TableMove);
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Search Variables
+
+protected:
+	/** A position in the current line, one per ply and reused between moves */
+	struct FNode
+	{
+		FMM_RulesBoard Board;
+
+		FMM_SameColumnLimits ColumnLimits;
+
+		ERulesTeam Team = ERulesTeam::E_NONE;
+
+		/** Winner of the turn that ended the game */
+		ERulesTeam Winner = ERulesTeam::E_NONE;
+
+		FMM_PackedPosition Position;
+	};
+
+	/** Nodes kept by each thread between searches, so their boards keep their memory */
+	struct FThreadNodes : public TThreadSingleton<FThreadNodes>
+	{
+		TArray<FNode> Nodes;
+
+		/** Reused for the columns of each node before they become moves */
+		TArray<int> Columns;
+	};
+
+	/** The searching thread's nodes, set for the duration of a search */
+	FThreadNodes* ThreadNodes = nullptr;
+
+	FMM_TranspositionTable& Table;
+
+	FMM_SearchArena& Arena;
+
+	int32 SameColumnMax = 6;
+
+	int32 NodeCount = 0;
+
+	int32 TableHitCount = 0;
+
+	/** Best move found at the root by the last search */
+	FMM_SearchMove RootBestMove;
+
+	/** Score of the root from the deepest search */
+	int32 RootScore = 0;
+
+#pragma endregion
+};
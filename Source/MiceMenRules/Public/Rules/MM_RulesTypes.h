@@ -0,0 +1,113 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Split mix finalizer, spreads consecutive inputs across all bits, for the Zobrist keys of positions */
+FORCEINLINE uint64 MM_MixKey(uint64 Value)
+{
+	uint64 Key = (Value + 1) * 0x9E3779B97F4A7C15ull;
+	Key = (Key ^ (Key >> 30)) * 0xBF58476D1CE4E5B9ull;
+	Key = (Key ^ (Key >> 27)) * 0x94D049BB133111EBull;
+	return Key ^ (Key >> 31);
+}
+
+/** Team of a mouse on the rules board, with the same values as the game's ETeam so they convert directly */
+enum class ERulesTeam : uint8
+{
+	E_NONE,
+
+	/** Moves right, scoring at the last column */
+	E_TEAM_A,
+	/** Moves left, scoring at the first column */
+	E_TEAM_B,
+
+	E_MAX
+};
+
+/** What a slot on the rules board is taken up by */
+enum class ERulesSlot : uint8
+{
+	E_EMPTY,
+	E_BLOCK,
+	E_MOUSE
+};
+
+/** How the game stands after a turn */
+enum class ERulesOutcome : uint8
+{
+	/** Game continues with the next team's turn */
+	E_IN_PROGRESS,
+	/** A team completed all of their mice */
+	E_ALL_MICE_COMPLETED,
+	/** No more mice can complete, decided on score */
+	E_NO_VALID_MOVES,
+	/** Stalemate turns ran out, decided on the distance of the remaining mice */
+	E_STALEMATE
+};
+
+/** A mouse on the rules board */
+struct FMM_RulesMouse
+{
+	FIntPoint Coord = FIntPoint::ZeroValue;
+
+	ERulesTeam Team = ERulesTeam::E_NONE;
+
+	/** Cleared once the mouse reaches its goal */
+	bool bActive = true;
+};
+
+/** What happened during a turn */
+struct FMM_RulesTurnResult
+{
+	/** Cascade passes until no mice moved, including the final pass */
+	int CascadePasses = 0;
+
+	int MiceMoved = 0;
+
+	int GoalsScored = 0;
+
+	ERulesOutcome Outcome = ERulesOutcome::E_IN_PROGRESS;
+
+	/** Winning team once the game has ended, none for a tie */
+	ERulesTeam Winner = ERulesTeam::E_NONE;
+};
+
+/** Every mouse movement of a cascade in the order it was made, to show or replay the cascade without resolving it again */
+struct FMM_RulesCascadeLog
+{
+	/** One mouse walking from where it was to where it stopped or scored */
+	struct FMove
+	{
+		/** Index of the mouse in the board's mice */
+		int32 MouseIndex = INDEX_NONE;
+
+		/** Start of the move's path in Paths */
+		int32 PathStart = 0;
+
+		/** Positions in the path, including where the mouse started */
+		int32 PathNum = 0;
+
+		/** The move ended at the mouse's goal */
+		bool bScored = false;
+	};
+
+	/** Removes all moves, keeping the allocations */
+	void Reset()
+	{
+		Moves.Reset();
+		Paths.Reset();
+	}
+
+	/** The move's path from where the mouse started, a position after each fall and step */
+	TArrayView<const FIntPoint> GetPath(int32 MoveIndex) const
+	{
+		return TArrayView<const FIntPoint>(Paths.GetData() + Moves[MoveIndex].PathStart, Moves[MoveIndex].PathNum);
+	}
+
+	TArray<FMove> Moves;
+
+	/** Paths of every move one after another */
+	TArray<FIntPoint> Paths;
+};
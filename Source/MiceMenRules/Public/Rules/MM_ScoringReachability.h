@@ -0,0 +1,85 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Whether any mouse can still reach its goal under any sequence of column moves, for games as 64 bit lane masks.
+ * A single board is lane 0, lockstep boards pass a lane per game.
+ *
+ * Moving a column only rotates it, so a full column stays full until one of its own mice steps out,
+ * and a mouse only steps forward into a column that has an empty slot.
+ * Columns that can ever have an empty slot are flood filled from those with one now,
+ * adding columns with a mouse facing one that can, until nothing changes.
+ * The remaining columns are full for the rest of the game, so a mouse can only still score if none are ahead of it.
+ * Rows and which team may move each column are not considered, so a game is never ended while a mouse can still score.
+ */
+struct FMM_ScoringReachability
+{
+	/**
+	* Lanes where at least one mouse of either team may still reach its goal.
+	* @param FullColumns lanes where the column has no empty slot, one per column
+	* @param TeamAColumns lanes where the column has a team A mouse
+	* @param TeamBColumns lanes where the column has a team B mouse
+	* @param OutCanEmptyColumns lanes where the column can ever have an empty slot, sized to the columns
+	*/
+	static FORCEINLINE uint64 GetScorableLanes(TArrayView<const uint64> FullColumns, TArrayView<const uint64> TeamAColumns, TArrayView<const uint64> TeamBColumns,
+	                                           uint64 LaneMask, TArrayView<uint64> OutCanEmptyColumns)
+	{
+		const int32 Width = FullColumns.Num();
+		check(TeamAColumns.Num() == Width && TeamBColumns.Num() == Width && OutCanEmptyColumns.Num() == Width);
+
+		for (int32 x = 0; x < Width; x++)
+		{
+			OutCanEmptyColumns[x] = ~FullColumns[x] & LaneMask;
+		}
+
+		// Sweep both ways so chains of columns in either direction fill in a single pass
+		bool bChanged = true;
+		while (bChanged)
+		{
+			bChanged = false;
+			for (int32 x = 0; x < Width; x++)
+			{
+				bChanged |= SpreadCanEmpty(x, TeamAColumns, TeamBColumns, OutCanEmptyColumns);
+			}
+			for (int32 x = Width - 1; x >= 0; x--)
+			{
+				bChanged |= SpreadCanEmpty(x, TeamAColumns, TeamBColumns, OutCanEmptyColumns);
+			}
+		}
+
+		// Team A score on the right, so every column right of the mouse must be able to open, and team B the same to the left
+		uint64 ScorableLanes = 0;
+		uint64 OpenRightLanes = LaneMask;
+		for (int32 x = Width - 1; x >= 0; x--)
+		{
+			ScorableLanes |= TeamAColumns[x] & OpenRightLanes;
+			OpenRightLanes &= OutCanEmptyColumns[x];
+		}
+		uint64 OpenLeftLanes = LaneMask;
+		for (int32 x = 0; x < Width; x++)
+		{
+			ScorableLanes |= TeamBColumns[x] & OpenLeftLanes;
+			OpenLeftLanes &= OutCanEmptyColumns[x];
+		}
+		return ScorableLanes & LaneMask;
+	}
+
+protected:
+	/** Adds the lanes where a mouse in the column faces a column that can empty, true if any were added */
+	static FORCEINLINE bool SpreadCanEmpty(int32 Column, TArrayView<const uint64> TeamAColumns, TArrayView<const uint64> TeamBColumns, TArrayView<uint64> CanEmptyColumns)
+	{
+		const uint64 RightLanes = Column + 1 < CanEmptyColumns.Num() ? CanEmptyColumns[Column + 1] : 0;
+		const uint64 LeftLanes = Column > 0 ? CanEmptyColumns[Column - 1] : 0;
+		const uint64 NewLanes = (TeamAColumns[Column] & RightLanes) | (TeamBColumns[Column] & LeftLanes);
+		if ((NewLanes & ~CanEmptyColumns[Column]) == 0)
+		{
+			return false;
+		}
+
+		CanEmptyColumns[Column] |= NewLanes;
+		return true;
+	}
+};
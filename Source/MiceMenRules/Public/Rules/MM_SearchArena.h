@@ -0,0 +1,103 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSingleton.h"
+
+/**
+ * Bump allocator for search scratch memory, such as the moves of each searched position.
+ * Allocating only moves an offset, and everything allocated since a mark is released at once by returning to it.
+ * Blocks are kept when released, so once a search has warmed the arena up, searching again makes no heap allocations.
+ * Only holds trivially destructible types, as nothing allocated is destroyed.
+ * Not thread safe, each thread searching uses their own arena from Get().
+ */
+class MICEMENRULES_API FMM_SearchArena : public TThreadSingleton<FMM_SearchArena>
+{
+public:
+	/** A position in the arena to release back to */
+	struct FMark
+	{
+		int32 Block = 0;
+
+		SIZE_T Offset = 0;
+	};
+
+	explicit FMM_SearchArena(SIZE_T InBlockSize = 256 * 1024);
+
+	~FMM_SearchArena();
+
+	FMM_SearchArena(const FMM_SearchArena&) = delete;
+
+	FMM_SearchArena& operator=(const FMM_SearchArena&) = delete;
+
+#pragma region Allocation
+
+public:
+	/** Memory from the current block, or the next block large enough */
+	void* Allocate(SIZE_T Size, SIZE_T Alignment);
+
+	/** Default constructed elements that are released with the arena */
+	template <typename ElementType>
+	TArrayView<ElementType> AllocateArray(int32 Count)
+	{
+		static_assert(TIsTriviallyDestructible<ElementType>::Value, "Arena elements are never destroyed");
+
+		if (Count <= 0)
+		{
+			return TArrayView<ElementType>();
+		}
+
+		ElementType* Elements = static_cast<ElementType*>(Allocate(sizeof(ElementType) * Count, alignof(ElementType)));
+		for (int32 i = 0; i < Count; i++)
+		{
+			new(Elements + i) ElementType();
+		}
+		return TArrayView<ElementType>(Elements, Count);
+	}
+
+	FMark GetMark() const { return {CurrentBlock, Offset}; }
+
+	/** Releases everything allocated since the mark */
+	void PopMark(const FMark& Mark);
+
+	/** Releases everything, keeping the blocks */
+	void Reset() { PopMark(FMark()); }
+
+#pragma endregion
+
+#pragma region Stats
+
+public:
+	/** Memory held by the arena's blocks */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Heap allocations made since the arena was created, only increasing while warming up */
+	int32 GetBlockCount() const { return Blocks.Num(); }
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Arena Variables
+
+protected:
+	struct FBlock
+	{
+		uint8* Memory = nullptr;
+
+		SIZE_T Size = 0;
+	};
+
+	TArray<FBlock> Blocks;
+
+	int32 CurrentBlock = 0;
+
+	/** Bytes used in the current block */
+	SIZE_T Offset = 0;
+
+	/** Size of new blocks, unless an allocation needs a larger block */
+	SIZE_T BlockSize = 0;
+
+#pragma endregion
+};
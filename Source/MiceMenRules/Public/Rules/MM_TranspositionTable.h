@@ -0,0 +1,114 @@
+// Copyright Alex Coultas, Mice Men Example Project
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** How a stored search score relates to the true score of the position */
+enum class ESearchBound : uint8
+{
+	/** Nothing stored */
+	E_NONE,
+
+	/** Every move was searched within the window */
+	E_EXACT,
+	/** A move was good enough to cut the search off, the true score is at least this */
+	E_LOWER,
+	/** No move reached the window, the true score is at most this */
+	E_UPPER
+};
+
+/** A column move, up or down */
+struct FMM_SearchMove
+{
+	int32 Column = INDEX_NONE;
+
+	bool bUp = true;
+
+	bool IsValid() const { return Column != INDEX_NONE; }
+
+	bool operator==(const FMM_SearchMove& Other) const { return Column == Other.Column && bUp == Other.bUp; }
+};
+
+/** A search result for a position */
+struct FMM_TranspositionEntry
+{
+	int32 Score = 0;
+
+	/** Turns searched below the position, up to 255 */
+	int32 Depth = 0;
+
+	ESearchBound Bound = ESearchBound::E_NONE;
+
+	FMM_SearchMove BestMove;
+};
+
+/**
+ * Fixed size table of search results keyed by position hash, shared by searches on any thread without locks.
+ * Each slot is two 64 bit words, the key is stored exclusive or'd with the packed result,
+ * so a slot torn by two threads writing at once fails the key check and reads as a miss instead of a wrong result.
+ * Results are kept between searches, so searching again after a turn reuses the results below the new position.
+ * Entries from earlier searches are the first to be replaced, then shallower entries.
+ */
+class MICEMENRULES_API FMM_TranspositionTable
+{
+#pragma region Setup
+
+public:
+	/** Sizes the table to the most entries that fit, rounded down to a power of two, and clears it. 0 removes the table */
+	void Resize(int32 SizeInMegabytes);
+
+	/** Removes all entries, keeping the size */
+	void Clear();
+
+	/** Marks the start of a search, entries from earlier searches can still be found but are replaced first */
+	void NewSearch();
+
+	int64 GetEntryCount() const { return EntryCount; }
+
+	SIZE_T GetAllocatedSize() const { return EntryCount * sizeof(FSlot); }
+
+#pragma endregion
+
+#pragma region Entries
+
+public:
+	/** Finds the entry for the key, false on a miss */
+	bool Probe(uint64 Key, FMM_TranspositionEntry& OutEntry) const;
+
+	/** Stores the entry unless the slot holds a deeper entry for another position from this search */
+	void Store(uint64 Key, const FMM_TranspositionEntry& Entry);
+
+protected:
+	/** Score, depth, bound, move and generation in one word */
+	static uint64 PackEntry(const FMM_TranspositionEntry& Entry, uint8 EntryGeneration);
+
+	static void UnpackEntry(uint64 Data, FMM_TranspositionEntry& OutEntry, uint8& OutGeneration);
+
+#pragma endregion
+
+//-------------------------------------------------------
+
+#pragma region Table Variables
+
+protected:
+	struct FSlot
+	{
+		std::atomic<uint64> KeyXorData;
+
+		std::atomic<uint64> Data;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+
+	int64 EntryCount = 0;
+
+	/** Entry count minus one, selects the slot from the low bits of a key */
+	uint64 IndexMask = 0;
+
+	/** Current search, wrapping at 256 */
+	std::atomic<uint8> Generation{0};
+
+#pragma endregion
+};